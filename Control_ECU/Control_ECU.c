@@ -7,29 +7,48 @@
 
 #include "Control_ECU.h"
 
-/*Base address of memory where password is saved starting from it*/
-uint16 eeprom_addr=0x0300;
+/*Global array to hold the new password entered first, or the password to be checked*/
+uint8 g_password[PASSWORD_SIZE];
 
-/*Address of memory where the chkFlag is saved inside it to indicate if there is a saved
- *password or not*/
-uint16 eeprom_flag=0x05FF;
-
-/*Global array to hold the saved password from EEPROM in it*/
-uint8 g_eeprom[PASSWORD_SIZE];
+/*Global variable to hold the slot of the user whose password is being set, CRED_NONE while
+ *a user is added*/
+uint8 g_user=CRED_NONE;
 
 /*Global variable to hold the function ID being executed,
  *initially it's 0 to execute Control_checkForSavedPassword function*/
 uint8 g_functionID=0;
 
-/*Variable to hold state of system, either the password is entered correctly or not*/
-uint8 g_state=0;
-
-/*Configuration structure for Timer1 module:
- * 1. Compare match (CTC) mode
- * 2. Prescalar = 1024 --> T_Timer = 128 usec
- * 3. Initial value = 0
- * 4. Compare value = 39063 --> Interrupt every 5 sec*/
-TIMER1_ConfigType Timer1_Config={CTC,F_CPU_1024,0,39063};
+/*Timeline of door opening (ticks of 5 sec):
+ * 1. Move the bolt to its open position (open the door) for 15 seconds at most, HMI shows
+ *    it's unlocking. The bolt is held open, the step ends once the door closes after someone
+ *    walked through
+ * 2. Move the bolt to its locked position (close the door) for 15 seconds at most, HMI shows
+ *    it's locking. The step ends once the bolt is thrown (bolt switch, or arrived or stalled
+ *    if the switch failed)
+ * 3. Stop the motor (lock the door), HMI returns back to main menu*/
+const TIMELINE_StepType g_doorTimeline[DOOR_TIMELINE_STEPS]={
+		{motorRotateClockwise,3,DOOR_UNLOCKING,DOOR_END_CLOSED},
+		{motorRotateAntiClockwise,3,DOOR_LOCKING,DOOR_END_STALL|DOOR_END_BOLT|DOOR_END_ARRIVED},
+		{motorStop,0,DOOR_LOCKED,0}};
+
+/*Timeline of system lock after 3 wrong passwords (ticks of 5 sec):
+ * 1. Fire the buzzer for 1 minute, HMI shows a thief message
+ * 2. Stop the buzzer, HMI returns back to main menu*/
+const TIMELINE_StepType g_alarmTimeline[ALARM_TIMELINE_STEPS]={
+		{buzzerON,12,THIEF,0},
+		{buzzerOFF,0,SYSTEM_UNLOCKED,0}};
+
+/*Buzzer patterns, in flash:
+ * 1. Alarm: siren of 2 KHz and 3 KHz tones alternating every 250 msec till it's stopped
+ * 2. Key click: 4 KHz tone for 10 msec on each password character, HMI ECU sends each key
+ *    as it's pressed
+ * 3. Success chirp: rising 2, 3 and 4 KHz tones for 60 msec each on a correct password*/
+const BUZZER_NoteType g_alarmPattern[] PROGMEM={
+		BUZZER_NOTE(2000,250),BUZZER_NOTE(3000,250),BUZZER_REPEAT};
+const BUZZER_NoteType g_clickPattern[] PROGMEM={
+		BUZZER_NOTE(4000,10),BUZZER_END};
+const BUZZER_NoteType g_chirpPattern[] PROGMEM={
+		BUZZER_NOTE(2000,60),BUZZER_NOTE(3000,60),BUZZER_NOTE(4000,60),BUZZER_END};
 
 /*Global array of pointer to functions, each function is called in main function through its ID in array
  *and at the end of each function, the needed function is called through changing the global variable
@@ -49,85 +68,96 @@ int main()
 {
 	/*Enable global interrupts for timer1 to operate*/
 	sei();
+	/*Start latency probes time base*/
+	PROBE_INIT();
+	/*Start the trace recorder time base*/
+	TRACE_INIT();
+	/*Boot time is counted from here till the status is pushed to HMI ECU*/
+	PROBE_START(PROBE_BOOT);
+	/*Select idle sleep mode for the waits on keys and bytes*/
+	IDLE_init();
+	/*TIMER0 overflow ticks door and alarm timelines and buzzer patterns*/
+	TICK_init();
+	TIMELINE_init();
+	/*Initialise EEPROM and index the users before the link is opened, so a status request
+	 *from HMI ECU is answered with it*/
+	EEPROM_init();
+	CRED_init();
+#if(LINK_TRANSPORT == LINK_SPI)
+	/*Configuration structure for SPI module:
+	 * 1. Control is the slave of the link, HMI gives the clock*/
+	SPI_ConfigType SPI_Config={SPI_SLAVE,SPI_F_CPU_2};
+	/*Initialises SPI module with SPI_Config structure parameters*/
+	SPI_init(&SPI_Config);
+#else
 	/*Configuration structure for UART module:
 	 * 1. Baud rate = 9600
 	 * 2. No parity bits is used (parity is disabled)
 	 * 3. One stop bit is used
-	 * 4. Data frame is 8-bit data*/
-	UART_ConfigType UART_Config={9600,NO_PARITY,ONE_STOP_BIT,EIGHT_BITS};
-
-	/*Set callback function for Timer1*/
-	TIMER1_setCallBack(fireBuzzerOrOpenDoor);
+	 * 4. Data frame is 8-bit data (9-bit on a multi-drop bus)
+	 * 5. Node address of this door on a multi-drop bus*/
+	UART_ConfigType UART_Config={9600,NO_PARITY,ONE_STOP_BIT,LINK_CHARACTER_SIZE,LINK_ADDRESS};
 	/*Initialises UART module with UART_Config structure parameters*/
 	UART_init(&UART_Config);
-
-	/*Initialise EEPROM*/
-	EEPROM_init();
-
-	/*Set direction of motor pins to be output pins*/
-	SET_BIT(DDRB,MOTOR_PIN1);
-	SET_BIT(DDRB,MOTOR_PIN2);
-	SET_BIT(DDRB,MOTOR_EN);
-	/*Set direction of buzzer pin to be output pin*/
-	SET_BIT(DDRB,BUZZER);
+#endif
+
+	/*Configuration structure for motor driver:
+	 * 1. Peak duty = 255 --> full speed
+	 * 2. Ramp up time = 500 msec
+	 * 3. Ramp down time = 500 msec
+	 * 4. Motor brakes when it stops
+	 * 5. Stall current = 450 ADC counts (2.2 V on the sense resistor), held for 50 msec
+	 * 6. Bolt position control, speeds in 1/16 counts per 16.384 msec and gains in 1/256:
+	 *    peak speed = 120 (7.5 counts, 460 counts/sec), acceleration = 8 (full speed in 250 msec),
+	 *    kp = 3, feed-forward = 498 (255 duty at full speed), kv = 256, ki = 16,
+	 *    arrived within 2 counts held for 50 msec*/
+	MOTOR_ConfigType MOTOR_Config={255,500,500,MOTOR_BRAKE,450,50,{120,8,3,498,256,16,2,50}};
+	/*Initialises motor driver with MOTOR_Config structure parameters, after the clock which
+	 *shares TIMER0. A stall or the bolt arriving ends the door step waiting for it*/
+	MOTOR_init(&MOTOR_Config);
+	MOTOR_setStallCallBack(Control_motorStalled);
+	MOTOR_setArrivalCallBack(Control_motorArrived);
+	/*Door contact and bolt switch feed the door timeline*/
+	SENSOR_setCallBack(Control_sensorChanged);
+	SENSOR_init();
+	/*Buzzer tones are generated by TIMER1*/
+	BUZZER_init();
 
 	while(1)
 	{
 		/*Call function through pointer to function from the array of pointers to functions*/
+		PROBE_START(PROBE_STATE);
+		TRACE_BEGIN(TRACE_STATE,g_functionID);
 		(*func[g_functionID])();
+		TRACE_END(TRACE_STATE,g_functionID);
+		PROBE_STOP(PROBE_STATE);
 	}
 }
 
 /******************************************************************************
  *[Function Name] : Control_checkForSavedPassword
- *[Description]   : This function is the first function to run in Control ECU:
- *					1. It waits until HMI ECU sends a signal for checking if there exists a previously
- *					   saved password or not
- *					2. It checks if there is a saved password in EEPROM or not
- *					3. If not exist, send a NO_SAVED_PASSWORD signal to HMI ECU
- *					4. If exists, send a SAVED_PASSWORD signal to HMI ECU
+ *[Description]   : This function is the first function to run in Control ECU, after the saved
+ *					password is loaded at reset:
+ *					1. It pushes to HMI ECU a SAVED_PASSWORD or NO_SAVED_PASSWORD signal
+ *					   unprompted (point to point UART link only), HMI ECU asks for it by
+ *					   CHECK_FOR_SAVED_PASSWORD otherwise, which is answered while waiting
+ *					   for any signal
+ *					2. If exists, it goes to wait for a password to be checked
+ *					3. If not exist, it goes to wait for a new password
  *					### g_functionID = 0 ###
  *[Arguments]     : void
  *[Return]        : void
  ******************************************************************************/
 void Control_checkForSavedPassword(void)
 {
-	/*Variable to for loop till password size*/
-	uint8 loop_idx=0;
-	/*Variable to  save it in memory to indicate there is a saved password or not*/
-	uint8 chkFlag;
-
-	/*Wait until HMI ECU sends CHECK_FOR_SAVED_PASSWORD signal so as to begin checking*/
-	while(UART_receiveByte() != CHECK_FOR_SAVED_PASSWORD);
-
-	/*Check if there is a saved password in EEPROM or not*/
-	/*Read from memory eeprom_flag address the value of saved flag*/
-	EEPROM_readByte(eeprom_flag,&chkFlag);
-
-	/*Check on the value of flag
-	 * 1. if chkFlag = NO_PASSWORD value, go to Control_setNewPassword function
-	 * 2. if chkFlag = PASSWORD_EXIST value, go to Control_receiveAndSavePassword function*/
-	if(chkFlag == SAVED_PASSWORD)
-	{
-		/*Send to HMI ECU a SAVED_PASSWORD signal to indicate that a password is saved*/
-		UART_sendByte(SAVED_PASSWORD);
-		/*Read the saved password from EEPROM in g_eeprom array*/
-		for(loop_idx=0;loop_idx<PASSWORD_SIZE;loop_idx++)
-		{
-			EEPROM_readByte((eeprom_addr)+loop_idx,&g_eeprom[loop_idx]);
-		}
-		/*Go to Control_receiveAndSavePasswordfunction and wait for password to be checked
-		 *with the saved one in EEPROM*/
-		g_functionID=3;
-	}
-	if(chkFlag == NO_SAVED_PASSWORD)
-	{
-		/*Send to HMI ECU a NO_SAVED_PASSWORD signal to indicate no password is saved*/
-		UART_sendByte(NO_SAVED_PASSWORD);
-		/*Go to Control_setNewPassword function and wait for new password to be sent
-		 *to save it in EEPROM*/
-		g_functionID=1;
-	}
+#if(LINK_PUSH)
+	/*Push the status to HMI ECU so it doesn't wait for a round trip at power on*/
+	LINK_sendByte(((CRED_getCount() != 0) || CRED_isLocked()) ? SAVED_PASSWORD : NO_SAVED_PASSWORD);
+#endif
+	PROBE_STOP(PROBE_BOOT);
+	/*Go to Control_receiveAndCheckPassword function to wait for a password to be checked with
+	 *the saved one, or to Control_setNewPassword function to wait for a new password*/
+	g_functionID=((CRED_getCount() != 0) || CRED_isLocked()) ? 3 : 1;
 }
 
 
@@ -144,11 +174,14 @@ void Control_setNewPassword(void)
 	/*Variable to for loop till password size*/
 	uint8 loop_idx=0;
 	/*Wait until HMI ECU sends a ready signal*/
-	while(UART_receiveByte()!=HMI_ECU_READY);
-	/*Get the input password from HMI ECU in g_eeprom array*/
+	Control_waitForSignal(HMI_ECU_READY);
+	/*Get the input password from HMI ECU in g_password array*/
 	for(loop_idx=0;loop_idx<PASSWORD_SIZE;loop_idx++)
 	{
-		g_eeprom[loop_idx]=UART_receiveByte();
+		g_password[loop_idx]=LINK_receiveByte();
+		/*The time a key arrives at feeds the salt drawn when the first user is added*/
+		CRED_stir(TCNT0);
+		BUZZER_play(g_clickPattern);
 	}
 	/*Go to Control_checkNewPassword function to check if the password is re-entered correctly or not*/
 	g_functionID=2;
@@ -159,11 +192,13 @@ void Control_setNewPassword(void)
  *[Description]   : This function checks the new entered password for the system
  *					1. It waits until HMI ECU sends a ready signal then it receives a password
  *					2. It compares each element of the password to the previously received one
- *					3. If it matches, it sends a CORRECT_NEW_PASSWORD signal to HMI ECU to
+ *					3. If it matches, the user is added (the first one is the administrator)
+ *					   or the password of the user who entered the old one is replaced
+ *					4. If it's done, it sends a CORRECT_NEW_PASSWORD signal to HMI ECU to
  *					   go to main menu options and also goes to wait function
- *					4. It it doesn't match, it Send a NON_CORRECT_NEW_PASSWORD signal to
- *					   HMI ECU to ask user to re-enter password and goes again to Control_setNewPassword
- *					   function
+ *					5. If it doesn't match, or it's the password of another user, it sends a
+ *					   NON_CORRECT_NEW_PASSWORD signal to HMI ECU to ask user to re-enter
+ *					   password and goes again to Control_setNewPassword function
  *					### g_functionID = 2 ###
  *[Arguments]     : void
  *[Return]        : void
@@ -172,41 +207,46 @@ void Control_checkNewPassword(void)
 {
 	/*Variable to for loop till password size*/
 	uint8 loop_idx=0;
-	/*Variable used as a flag to check if password matches or not*/
+	/*Variable to hold the differing bits of the two passwords, it's 0 if they match*/
 	uint8 mismatch=0;
+	/*Variable to hold the result of saving the password*/
+	CRED_Status status=CRED_ERROR;
 	/*Wait until HMI ECU sends a ready signal*/
-	while(UART_receiveByte()!=HMI_ECU_READY);
-	/*For loop to get a key by key and save it then compares at each time if each
-	 *character matches or not*/
+	Control_waitForSignal(HMI_ECU_READY);
+	/*For loop to get a key by key and fold it in the comparison with the previously received
+	 *password, in the same time whatever the characters are*/
 	for(loop_idx=0;loop_idx<PASSWORD_SIZE;loop_idx++)
 	{
-		/*For each mismatching received character, increment the mismatch counter*/
-		if(UART_receiveByte() != g_eeprom[loop_idx])
-		{
-			mismatch++;
-		}
+		/*Each mismatching received character sets its differing bits*/
+		mismatch|=(LINK_receiveByte() ^ g_password[loop_idx]);
+		CRED_stir(TCNT0);
+		BUZZER_play(g_clickPattern);
 	}
-	/*Checks for matching between two entered passwords*/
+	/*Save the password in the credential table if the two entered passwords match*/
 	if(mismatch==0)
 	{
-		/*Send a CORRECT_NEW_PASSWORD signal to HMI ECU to go to main menu options*/
-		UART_sendByte(CORRECT_NEW_PASSWORD);
-		/*Write the password to EEPROM*/
-		for(loop_idx=0;loop_idx<PASSWORD_SIZE;loop_idx++)
+		if(g_user == CRED_NONE)
+		{
+			status=CRED_add(g_password,(CRED_getCount() == 0) ? (CRED_ACTIVE|CRED_ADMIN) : CRED_ACTIVE);
+		}
+		else
 		{
-			EEPROM_writeByte((eeprom_addr)+loop_idx,g_eeprom[loop_idx]);
-			_delay_ms(10);
+			status=CRED_changePin(g_user,g_password);
 		}
-		/*Write in the eeprom_flag address a PASSWROD_EXIST constant*/
-		EEPROM_writeByte(eeprom_flag,SAVED_PASSWORD);
-		_delay_ms(10);
+	}
+	if(status == CRED_OK)
+	{
+		/*Send a CORRECT_NEW_PASSWORD signal to HMI ECU to go to main menu options*/
+		LINK_sendByte(CORRECT_NEW_PASSWORD);
+		BUZZER_play(g_chirpPattern);
+		g_user=CRED_NONE;
 		/*Go to Control_receiveAndCheckPassword function*/
 		g_functionID=3;
 	}
 	else
 	{
 		/*Send a NON_CORRECT_NEW_PASSWORD signal to HMI ECU to ask user to re-enter password*/
-		UART_sendByte(NON_CORRECT_NEW_PASSWORD);
+		LINK_sendByte(NON_CORRECT_NEW_PASSWORD);
 		/*Go again to Control_setNewPassword function to save*/
 		g_functionID=1;
 	}
@@ -214,11 +254,16 @@ void Control_checkNewPassword(void)
 
 /******************************************************************************
  *[Function Name] : Control_receiveAndCheckPassword
- *[Description]   : This function receives a password from HMI ECU and compares it with saved one
- *					1. If it matches, it sends to HMI ECU that door is unlocking then door is locking
- *					2. If it doesn't match, it sends to HMI to ask the user to enter it one more time
+ *[Description]   : This function receives a password from HMI ECU and looks it up in the
+ *					credential table, the lookup takes the same time whatever the number of
+ *					users is and whether the password is found
+ *					1. If it's the password of a user, it sends to HMI ECU that door is unlocking
+ *					   then door is locking, or goes to set a new password for this user
+ *					2. If the option is to add a user, the password shall be an administrator's
+ *					   one and HMI ECU is told if the table is full
+ *					3. If it doesn't match, it sends to HMI to ask the user to enter it one more time
  *					   Total number of trials = 3
- *					3. If after 3 trials the password doesn't match at any time, it informs the HMI
+ *					4. If after 3 trials the password doesn't match at any time, it informs the HMI
  *					   ECU to view a thief message and lock the system for 1 minute
  *					### g_functionID = 3 ###
  *[Arguments]     : void
@@ -229,96 +274,156 @@ void Control_receiveAndCheckPassword(void)
 	/*Variable to for loop till password size*/
 	uint8 loop_idx=0;
 
-	/*Local array to hold the value of entered password to check it with saved one*/
-	uint8 chkPassword[PASSWORD_SIZE];
+	/*Variable to hold the slot of the user whose password is received, CRED_NONE if none*/
+	uint8 slot;
 
-	/*Variable used as a flag for mismatches in received password*/
-	uint8 mismatch=0;
+	/*Variable to hold the record of that user*/
+	CRED_RecordType record;
+
+	/*Lookups of the password for each last key, and number of keys looked up*/
+	PREFETCH_CandidateType candidates[PREFETCH_KEYS];
+	uint8 prefetched;
+	uint8 i;
 
 	/*Variable to count trials of password entry
 	 *It's static to keep the number of trials every time this function is called*/
 	static uint8 trial=1;
 
 	/*Busy-wait loop till receiving a ready signal from HMI ECU*/
-	while(UART_receiveByte()!= HMI_ECU_READY);
-	/*For loop to receive the password character by character and checks if there a mismatch with
-	 *the saved one or not*/
-	for(loop_idx=0;loop_idx<PASSWORD_SIZE;loop_idx++)
-	{
-		chkPassword[loop_idx]=UART_receiveByte();
-	}
-	for(loop_idx=0;loop_idx<PASSWORD_SIZE;loop_idx++)
+	Control_waitForSignal(HMI_ECU_READY);
+	/*Unlock latency is counted from the start of password entry*/
+	PROBE_START(PROBE_UNLOCK);
+	/*For loop to receive the password character by character, but the last one*/
+	for(loop_idx=0;loop_idx<(PASSWORD_SIZE-1u);loop_idx++)
 	{
-		EEPROM_readByte((eeprom_addr)+loop_idx,&g_eeprom[loop_idx]);
+		g_password[loop_idx]=LINK_receiveByte();
+		BUZZER_play(g_clickPattern);
 	}
-	for(loop_idx=0;loop_idx<PASSWORD_SIZE;loop_idx++)
+	/*Look the password up for each last key while the user types it*/
+	prefetched=Control_prefetchLastKey(candidates);
+	g_password[PASSWORD_SIZE-1u]=LINK_receiveByte();
+	BUZZER_play(g_clickPattern);
+	/*Check latency is counted from the last character: the lookup is picked among the
+	 *prefetched ones, all of them read so the pick takes the same time whatever the key is,
+	 *or done now if the key wasn't looked up in time*/
+	PROBE_START(PROBE_CHECK);
+	if(g_password[PASSWORD_SIZE-1u] < prefetched)
 	{
-		SET_BIT(PORTA,7-loop_idx);
-		if(chkPassword[loop_idx] != g_eeprom[loop_idx])
+		slot=CRED_NONE;
+		record.flags=0;
+		for(i=0;i<prefetched;i++)
 		{
-			mismatch++;
+			if(i == g_password[PASSWORD_SIZE-1u])
+			{
+				slot=candidates[i].slot;
+				record.flags=candidates[i].flags;
+			}
 		}
 	}
-	/*Get the option either to open the door or change password*/
-	uint8 key = UART_receiveByte();
-	/*If entered password matches the saved one*/
-	if(mismatch == 0)
+	else
+	{
+		slot=CRED_find(g_password,&record);
+	}
+	PROBE_STOP(PROBE_CHECK);
+	/*Get the option either to open the door, change password or add a user*/
+	uint8 key = LINK_receiveByte();
+	/*Only an administrator may add a user*/
+	if((key == ADD_USER) && !(record.flags & CRED_ADMIN))
+	{
+		slot=CRED_NONE;
+	}
+	/*If entered password is the one of a user*/
+	if(slot != CRED_NONE)
 	{
-		/*Send to HMI ECU that the password is entered correctly*/
-		UART_sendByte(CORRECT_PASSWORD);
-		/*Clear the state variable indicating that password is entered correctly*/
-		g_state=0;
 		/*Return number of trials to 1 again*/
 		trial=1;
-		/*If the option is open the door
-		 * - Rotate the motor clockwise (open the door)
-		 * - Send to HMI ECU that the door is unlocking now to display on LCD
-		 * - Start the timer to count 15 seconds, when reaching 15 seconds, it goes to call back function
-		 *   to rotate the motor anticlockwise for another 15 seconds then stops it*/
+		/*A user can't be added to a full table, HMI ECU returns back to main menu*/
+		if((key == ADD_USER) && CRED_isFull())
+		{
+			LINK_sendByte(USERS_FULL);
+			return;
+		}
+		/*Send to HMI ECU that the password is entered correctly*/
+		LINK_sendByte(CORRECT_PASSWORD);
+		BUZZER_play(g_chirpPattern);
+		/*If the option is open the door, run the door timeline: the motor rotates clockwise
+		 *now (open the door) and HMI ECU is told that the door is unlocking, then the door is
+		 *closed and locked while Control ECU keeps serving the link*/
 		if(key == OPEN_DOOR)
 		{
 			/*Open the door*/
-			motorRotateClockwise();
-			UART_sendByte(DOOR_UNLOCKING);
-			TIMER1_init(&Timer1_Config);
+			TIMELINE_start(g_doorTimeline,DOOR_TIMELINE_STEPS);
+			PROBE_STOP(PROBE_UNLOCK);
 		}
-		/*If the option is change the password, go to Control_setNewPassword function*/
+		/*If the option is change the password, go to Control_setNewPassword function for
+		 *this user*/
 		if(key == CHANGE_PASSWORD)
 		{
+			g_user=slot;
+			g_functionID=1;
+		}
+		/*If the option is add a user, go to Control_setNewPassword function for a new user*/
+		if(key == ADD_USER)
+		{
+			g_user=CRED_NONE;
 			g_functionID=1;
 		}
 	}
 	/*If password is wrongly entered*/
 	else
 	{
-		/*Set the state variable indicating that password is wrongly entered*/
-		g_state=1;
 		/*Increment number of trials*/
 		trial++;
 		/*Check on number of trials
 		 *If it reaches 4, this means that user entered password wrongly 3 times*/
 		if(trial==4)
 		{
-			/*Send to HMI ECU a thief signal*/
-			UART_sendByte(THIEF);
-			/*Fire the buzzer on*/
-			buzzerON();
-			/*Start the timer to count 1 min, when reaching 1 min, it goes to call back function to stop
-			 *buzzer and send to HMI ECU that system is unlocked*/
-			TIMER1_init(&Timer1_Config);
+			/*Return number of trials to 1 again, so the next 3 wrong trials lock the system again*/
+			trial=1;
+			/*Run the alarm timeline: the buzzer fires now and HMI ECU is sent a thief signal, after
+			 *1 min the buzzer stops and HMI ECU is told that system is unlocked*/
+			TIMELINE_start(g_alarmTimeline,ALARM_TIMELINE_STEPS);
 		}
 		/*If number of trials is less than 4, this means that there still exists number of trials for
 		 *the user to enter it*/
 		else
 		{
 			/*Send to HMI ECU that wrong password is entered*/
-			UART_sendByte(WRONG_PASSWORD);
+			LINK_sendByte(WRONG_PASSWORD);
 		}
 		/*Go again to Control_receiveAndCheckPassword function*/
 		g_functionID=3;
 	}
 }
 
+/******************************************************************************
+ *[Function Name] : Control_prefetchLastKey
+ *[Description]   : This function looks up the password received but its last character for
+ *					each last key 0 to PREFETCH_KEYS-1, so the lookup is off the critical path
+ *					after the last key. It stops at the first key not looked up once a byte
+ *					is received, so the last key is never held up
+ *[Arguments]     : PREFETCH_CandidateType * candidates: filled with the lookups, one per key
+ *[Return]        : uint8: number of keys looked up, the first ones
+ ******************************************************************************/
+uint8 Control_prefetchLastKey(PREFETCH_CandidateType * candidates)
+{
+	/*Variable to hold the record of each lookup*/
+	CRED_RecordType record;
+
+	uint8 key;
+	for(key=0;key<PREFETCH_KEYS;key++)
+	{
+		if(LINK_isDataReceived())
+		{
+			break;
+		}
+		g_password[PASSWORD_SIZE-1u]=key;
+		candidates[key].slot=CRED_find(g_password,&record);
+		candidates[key].flags=record.flags;
+	}
+	return key;
+}
+
 
 /******************************************************************************
  *[Function Name] : motorRotateClockwise
@@ -328,12 +433,8 @@ void Control_receiveAndCheckPassword(void)
  ******************************************************************************/
 void motorRotateClockwise (void)
 {
-	/*Set enable pin*/
-	SET_BIT(PORTB,MOTOR_EN);
-	/*Pin1 : 1
-	 *Pin2 : 0 to rotate clockwise*/
-	SET_BIT(PORTB,MOTOR_PIN1);
-	CLEAR_BIT(PORTB,MOTOR_PIN2);
+	/*Move the bolt to its open position and hold it there*/
+	MOTOR_moveTo(BOLT_OPEN_POSITION);
 }
 
 /******************************************************************************
@@ -344,12 +445,8 @@ void motorRotateClockwise (void)
  ******************************************************************************/
 void motorRotateAntiClockwise (void)
 {
-	/*Set enable pin*/
-	SET_BIT(PORTB,MOTOR_EN);
-	/*Pin1 : 0
-	 *Pin2 : 1 to rotate anti-clockwise*/
-	CLEAR_BIT(PORTB,MOTOR_PIN1);
-	SET_BIT(PORTB,MOTOR_PIN2);
+	/*Move the bolt back to its locked position*/
+	MOTOR_moveTo(BOLT_LOCKED_POSITION);
 }
 
 /******************************************************************************
@@ -360,88 +457,186 @@ void motorRotateAntiClockwise (void)
  ******************************************************************************/
 void motorStop(void)
 {
-	/*Clear Enable pin*/
-	CLEAR_BIT(PORTB,MOTOR_EN);
-	/*Clear 2 motor pins*/
-	CLEAR_BIT(PORTB,MOTOR_PIN1);
-	CLEAR_BIT(PORTB,MOTOR_PIN2);
+	/*Release the bolt: ramp down then brake*/
+	MOTOR_rotate(MOTOR_STOP);
 }
 
 /******************************************************************************
  *[Function Name] : buzzerON
- *[Description]   : This function fires the buzzer ON
+ *[Description]   : This function fires the buzzer alarm ON
  *[Arguments]     : void
  *[Return]        : void
  ******************************************************************************/
 void buzzerON (void)
 {
-	/*Fire the buzzer by setting buzzer bit*/
-	SET_BIT(PORTB,BUZZER);
+	/*Sound the alarm till it's stopped*/
+	BUZZER_play(g_alarmPattern);
 }
 
 /******************************************************************************
- *[Function Name] : buzzerON
+ *[Function Name] : buzzerOFF
  *[Description]   : This function turns the buzzer OFF
  *[Arguments]     : void
  *[Return]        : void
  ******************************************************************************/
 void buzzerOFF (void)
 {
-	/*Stop the buzzer by clearing buzzer bit*/
-	CLEAR_BIT(PORTB,BUZZER);
+	/*Silence the alarm*/
+	BUZZER_stop();
+}
+
+/******************************************************************************
+ *[Function Name] : Control_motorStalled
+ *[Description]   : This function is motor stall callback, it ends the door step waiting for
+ *					the bolt to reach its end stop
+ *[Arguments]     : void
+ *[Return]        : void
+ ******************************************************************************/
+void Control_motorStalled(void)
+{
+	TIMELINE_endStep(DOOR_END_STALL);
 }
 
 /******************************************************************************
- *[Function Name] : fireBuzzerOrOpenDoor
- *[Description]   : This function is the called back function by Timer1 when it reaches 5 seconds
- *					1. After the first 3 (5 seconds) i.e. 15 seconds --> rotate motor in anti-clkwise
- *					   direction
- *					2. After the second 3 (5 seconds) i.e. 30 seconds --> stop motor rotation
- *					3. When it reaches a minute, stops the buzzer
+ *[Function Name] : Control_motorArrived
+ *[Description]   : This function is motor arrival callback, it ends the door step waiting for
+ *					the bolt to reach its target
  *[Arguments]     : void
  *[Return]        : void
  ******************************************************************************/
-void fireBuzzerOrOpenDoor(void)
+void Control_motorArrived(void)
 {
-	/*Static variable to hold the number of times the system reaches to this function*/
-	static uint8 count=0;
-	/*Increment the count by 1 indicating a system reach to this function*/
-	count++;
-	/*When count=3, this means 15 sec time
-	 *When g_state=0, this means password is entered correctly*/
-	if(count==3 && g_state==0)
+	TIMELINE_endStep(DOOR_END_ARRIVED);
+}
+
+/******************************************************************************
+ *[Function Name] : Control_sensorChanged
+ *[Description]   : This function is door sensors callback: door contact changes are notified
+ *					to HMI ECU while a timeline runs, the door closing ends the unlocking step
+ *					and the bolt thrown ends the locking step
+ *[Arguments]     : SENSOR_Id id: sensor
+ *					uint8 closed: TRUE if its switch closed
+ *[Return]        : void
+ ******************************************************************************/
+void Control_sensorChanged(SENSOR_Id id, uint8 closed)
+{
+	if(id == SENSOR_DOOR)
 	{
-		/*Close the door*/
-		motorRotateAntiClockwise();
-		/*Send to HMI ECU that the door is being locked now to display on screen*/
-		UART_sendByte(DOOR_LOCKING);
+		/*HMI takes notifications only while it waits for the end of a timeline*/
+		if(TIMELINE_isRunning())
+		{
+			TIMELINE_notify(closed ? DOOR_CLOSED : DOOR_OPENED);
+		}
+		if(closed)
+		{
+			TIMELINE_endStep(DOOR_END_CLOSED);
+		}
 	}
-	/*When count=6, this means 30 sec time
-	 *When g_state=0, this means password is entered correctly*/
-	if(count==6 && g_state==0)
+	else if(closed)
 	{
-		/*Lock the door*/
-		motorStop();
-		/*Send to HMI ECU that the door is locked now to return back to main menu*/
-		UART_sendByte(DOOR_LOCKED);
-		/*Return the counter back to zero for further usages*/
-		count=0;
-		/*Stop Timer1*/
-		TIMER1_DeInit();
-		/*Go again to Control_receiveAndCheckPassword function*/
-		g_functionID=3;
+		/*Bolt switch is the reference of the encoder*/
+		ENCODER_setPosition(BOLT_SWITCH_POSITION);
+		TIMELINE_endStep(DOOR_END_BOLT);
 	}
-	/*When count=12, this means 60 sec time i.e. 1 min
-	 *When g_state=1, this means that password is not entered correctly*/
-	if(count==12 && g_state==1)
+}
+
+/******************************************************************************
+ *[Function Name] : Control_sendNotifications
+ *[Description]   : This function sends to HMI ECU the notifications queued by the steps of
+ *					door and alarm timelines
+ *[Arguments]     : void
+ *[Return]        : void
+ ******************************************************************************/
+void Control_sendNotifications(void)
+{
+	uint8 event;
+	while(TIMELINE_getEvent(&event))
 	{
-		/*Stops the buzzer after 1 min of buzzerON*/
-		buzzerOFF();
-		/*Send to HMI ECU that is system is unlocked again to return back to main menu*/
-		UART_sendByte(SYSTEM_UNLOCKED);
-		/*Return the counter back to zero for further usages*/
-		count=0;
-		/*Stop Timer1*/
-		TIMER1_DeInit();
+		LINK_sendByte(event);
+	}
+}
+
+#if(PROBE_ENABLE)
+/******************************************************************************
+ *[Function Name] : Control_dumpTimeline
+ *[Description]   : This function sends the timeline counters on the probes dump channel as a
+ *					line of hex numbers: N<notifications dropped>
+ *[Arguments]     : void
+ *[Return]        : void
+ ******************************************************************************/
+void Control_dumpTimeline(void)
+{
+	PROBE_SEND('N');
+	PROBE_sendHex(TIMELINE_getOverflows());
+	PROBE_SEND('\n');
+}
+#endif
+
+/******************************************************************************
+ *[Function Name] : Control_waitForSignal
+ *[Description]   : This function waits until HMI ECU sends the given signal, other bytes are
+ *					dropped except DIAG_PROBE_DUMP/DIAG_TRACE_DUMP requests which are answered
+ *					with the latency histograms and timeline counters/trace ring (only when
+ *					enabled), DIAG_HASH_BENCH
+ *					which is answered with the histograms after a PIN digest benchmark, BUS_POLL
+ *					which is answered with the door status and CHECK_FOR_SAVED_PASSWORD which
+ *					is answered with the saved password status. Timeline notifications are
+ *					sent meanwhile
+ *[Arguments]     : uint8 signal
+ *[Return]        : void
+ ******************************************************************************/
+void Control_waitForSignal(uint8 signal)
+{
+	uint8 received;
+	uint8 sreg=SREG;
+	while(1)
+	{
+		/*Sleep till a byte is received, sending timeline notifications. Both are checked
+		 *with interrupts disabled so a byte or a notification coming in between wakes the
+		 *CPU from the sleep instead of before it*/
+		while(1)
+		{
+			Control_sendNotifications();
+			cli();
+			if(LINK_isDataReceived())
+			{
+				SREG=sreg;
+				break;
+			}
+			LINK_armWake();
+			if(!TIMELINE_hasEvent())
+			{
+				IDLE_sleep();
+			}
+			SREG=sreg;
+		}
+		received=LINK_receiveByte();
+		if(received == signal)
+		{
+			return;
+		}
+		if(received == DIAG_PROBE_DUMP)
+		{
+			PROBE_DUMP();
+			CONTROL_DUMP_TIMELINE();
+		}
+		else if(received == DIAG_TRACE_DUMP)
+		{
+			TRACE_DUMP();
+		}
+		else if(received == DIAG_HASH_BENCH)
+		{
+			CRED_benchmark();
+			PROBE_DUMP();
+		}
+		else if(received == BUS_POLL)
+		{
+			LINK_sendByte((MOTOR_isRunning() || BUZZER_isPlaying() || !SENSOR_isClosed(SENSOR_DOOR))
+						  ? BUS_NODE_ACTIVE : BUS_NODE_IDLE);
+		}
+		else if(received == CHECK_FOR_SAVED_PASSWORD)
+		{
+			LINK_sendByte(((CRED_getCount() != 0) || CRED_isLocked()) ? SAVED_PASSWORD : NO_SAVED_PASSWORD);
+		}
 	}
 }
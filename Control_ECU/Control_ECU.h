@@ -11,9 +11,18 @@
 /******************************************************************
  * 					  Header Files Inclusion					  *
  ******************************************************************/
-#include "uart.h"
-#include "timer1.h"
+#include "link.h"
+#include "tick.h"
+#include "timeline.h"
+#include "buzzer.h"
+#include "motor.h"
+#include "sensor.h"
 #include "external_eeprom.h"
+#include "credential.h"
+#include "probe.h"
+#include "trace.h"
+#include "soft_uart.h"
+#include "idle.h"
 
 
 /******************************************************************
@@ -38,26 +47,80 @@
 #define CHANGE_PASSWORD				0x24
 #define CHECK_DONE					0x25
 #define KEY_RECEIVED				0x30
+/*Option to add a user, taken with an administrator's password, and the answer if no user
+ *can be added*/
+#define ADD_USER					0x31
+#define USERS_FULL					0x32
 #define MOTOR_CLK_STATE				0x26
 #define MOTOR_ANTI_CLK_STATE		0x27
 #define BUZZER_STATE				0x28
-/*Static Configuration for motor and buzzer pins*/
-#define MOTOR_PIN1		PB0
-#define MOTOR_PIN2		PB1
-#define MOTOR_EN		PB2
-#define BUZZER			PB7
+/*Diagnostic request: Control sends its probe histograms (probe.h) while waiting for a signal*/
+#define DIAG_PROBE_DUMP				0x29
+/*Diagnostic request: Control sends its trace ring (trace.h) while waiting for a signal*/
+#define DIAG_TRACE_DUMP				0x2A
+/*Diagnostic request: Control computes CRED_BENCH_RUNS PIN digests, then sends its probe
+ *histograms, PROBE_HASH gives the time of a digest*/
+#define DIAG_HASH_BENCH				0x33
+/*Bus master polls this door while it waits for a signal, it answers with its status: active
+ *while motor or buzzer runs or the door is open (same values in HMI_ECU/bus.h)*/
+#define BUS_POLL					0x2B
+#define BUS_NODE_IDLE				0x2C
+#define BUS_NODE_ACTIVE				0x2D
+/*Door contact notifications, sent while a timeline runs*/
+#define DOOR_OPENED					0x2E
+#define DOOR_CLOSED					0x2F
+/*Number of steps of door and alarm timelines*/
+#define DOOR_TIMELINE_STEPS			3u
+#define ALARM_TIMELINE_STEPS		2u
+/*Causes a door timeline step may end early for: motor stalled at an end stop, door contact
+ *closed, bolt switch closed (bolt thrown) and bolt arrived at its target*/
+#define DOOR_END_STALL				(1u<<0)
+#define DOOR_END_CLOSED				(1u<<1)
+#define DOOR_END_BOLT				(1u<<2)
+#define DOOR_END_ARRIVED			(1u<<3)
+/*Bolt positions in encoder counts (2000 counts over the travel): bolt switch, which the
+ *encoder is counted from, locked target past the switch so the switch always closes (the
+ *end stop is a stall) and open target short of the open end stop*/
+#define BOLT_SWITCH_POSITION		0
+#define BOLT_LOCKED_POSITION		(-10)
+#define BOLT_OPEN_POSITION			1950
+/*Key values of the digits the last password character is looked up for in advance, while
+ *the user types it (keys 0 to 9)*/
+#define PREFETCH_KEYS				10u
+/******************************************************************
+ * 						Function-like Macros					  *
+ ******************************************************************/
+#if(PROBE_ENABLE)
+#define CONTROL_DUMP_TIMELINE()		Control_dumpTimeline()
+#else
+#define CONTROL_DUMP_TIMELINE()		((void)0)
+#endif
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[Structure Name]		 : PREFETCH_CandidateType
+ *[Structure Description]: This structure contains the lookup of the password completed by
+ * 						   one last key: slot of the user (CRED_NONE if none) and flags of
+ * 						   its record*/
+typedef struct{
+	uint8 slot;
+	uint8 flags;
+}PREFETCH_CandidateType;
 
 /******************************************************************
  * 				    Public Functions Prototypes					  *
  ******************************************************************/
 /******************************************************************************
  *[Function Name] : Control_checkForSavedPassword
- *[Description]   : This function is the first function to run in Control ECU:
- *					1. It waits until HMI ECU sends a signal for checking if there exists a previously
- *					   saved password or not
- *					2. It checks if there is a saved password in EEPROM or not
- *					3. If not exist, send a NO_SAVED_PASSWORD signal to HMI ECU
- *					4. If exists, send a SAVED_PASSWORD signal to HMI ECU
+ *[Description]   : This function is the first function to run in Control ECU, after the saved
+ *					password is loaded at reset:
+ *					1. It pushes to HMI ECU a SAVED_PASSWORD or NO_SAVED_PASSWORD signal
+ *					   unprompted (point to point UART link only), HMI ECU asks for it by
+ *					   CHECK_FOR_SAVED_PASSWORD otherwise, which is answered while waiting
+ *					   for any signal
+ *					2. If exists, it goes to wait for a password to be checked
+ *					3. If not exist, it goes to wait for a new password
  *					### g_functionID = 0 ###
  *[Arguments]     : void
  *[Return]        : void
@@ -79,11 +142,13 @@ void Control_setNewPassword(void);
  *[Description]   : This function checks the new entered password for the system
  *					1. It waits until HMI ECU sends a ready signal then it receives a password
  *					2. It compares each element of the password to the previously received one
- *					3. If it matches, it sends a CORRECT_NEW_PASSWORD signal to HMI ECU to
+ *					3. If it matches, the user is added (the first one is the administrator)
+ *					   or the password of the user who entered the old one is replaced
+ *					4. If it's done, it sends a CORRECT_NEW_PASSWORD signal to HMI ECU to
  *					   go to main menu options and also goes to wait function
- *					4. It it doesn't match, it Send a NON_CORRECT_NEW_PASSWORD signal to
- *					   HMI ECU to ask user to re-enter password and goes again to Control_setNewPassword
- *					   function
+ *					5. If it doesn't match, or it's the password of another user, it sends a
+ *					   NON_CORRECT_NEW_PASSWORD signal to HMI ECU to ask user to re-enter
+ *					   password and goes again to Control_setNewPassword function
  *					### g_functionID = 2 ###
  *[Arguments]     : void
  *[Return]        : void
@@ -92,11 +157,16 @@ void Control_checkNewPassword(void);
 
 /******************************************************************************
  *[Function Name] : Control_receiveAndCheckPassword
- *[Description]   : This function receives a password from HMI ECU and compares it with saved one
- *					1. If it matches, it sends to HMI ECU that door is unlocking then door is locking
- *					2. If it doesn't match, it sends to HMI to ask the user to enter it one more time
+ *[Description]   : This function receives a password from HMI ECU and looks it up in the
+ *					credential table, the lookup takes the same time whatever the number of
+ *					users is and whether the password is found
+ *					1. If it's the password of a user, it sends to HMI ECU that door is unlocking
+ *					   then door is locking, or goes to set a new password for this user
+ *					2. If the option is to add a user, the password shall be an administrator's
+ *					   one and HMI ECU is told if the table is full
+ *					3. If it doesn't match, it sends to HMI to ask the user to enter it one more time
  *					   Total number of trials = 3
- *					3. If after 3 trials the password doesn't match at any time, it informs the HMI
+ *					4. If after 3 trials the password doesn't match at any time, it informs the HMI
  *					   ECU to view a thief message and lock the system for 1 minute
  *					### g_functionID = 3 ###
  *[Arguments]     : void
@@ -104,6 +174,17 @@ void Control_checkNewPassword(void);
  ******************************************************************************/
 void Control_receiveAndCheckPassword(void);
 
+/******************************************************************************
+ *[Function Name] : Control_prefetchLastKey
+ *[Description]   : This function looks up the password received but its last character for
+ *					each last key 0 to PREFETCH_KEYS-1, so the lookup is off the critical path
+ *					after the last key. It stops at the first key not looked up once a byte
+ *					is received, so the last key is never held up
+ *[Arguments]     : PREFETCH_CandidateType * candidates: filled with the lookups, one per key
+ *[Return]        : uint8: number of keys looked up, the first ones
+ ******************************************************************************/
+uint8 Control_prefetchLastKey(PREFETCH_CandidateType * candidates);
+
 /******************************************************************************
  *[Function Name] : motorRotateClockwise
  *[Description]   : This function rotates the motor in clockwise direction
@@ -130,14 +211,14 @@ void motorStop(void);
 
 /******************************************************************************
  *[Function Name] : buzzerON
- *[Description]   : This function fires the buzzer ON
+ *[Description]   : This function fires the buzzer alarm ON
  *[Arguments]     : void
  *[Return]        : void
  ******************************************************************************/
 void buzzerON (void);
 
 /******************************************************************************
- *[Function Name] : buzzerON
+ *[Function Name] : buzzerOFF
  *[Description]   : This function turns the buzzer OFF
  *[Arguments]     : void
  *[Return]        : void
@@ -146,15 +227,67 @@ void buzzerOFF (void);
 
 
 /******************************************************************************
- *[Function Name] : fireBuzzerOrOpenDoor
- *[Description]   : This function is the called back function by Timer1 when it reaches 5 seconds
- *					1. After the first 3 (5 seconds) i.e. 15 seconds --> rotate motor in anti-clkwise
- *					   direction
- *					2. After the second 3 (5 seconds) i.e. 30 seconds --> stop motor rotation
- *					3. When it reaches a minute, stops the buzzer
+ *[Function Name] : Control_motorStalled
+ *[Description]   : This function is motor stall callback, it ends the door step waiting for
+ *					the bolt to reach its end stop
+ *[Arguments]     : void
+ *[Return]        : void
+ ******************************************************************************/
+void Control_motorStalled(void);
+
+/******************************************************************************
+ *[Function Name] : Control_motorArrived
+ *[Description]   : This function is motor arrival callback, it ends the door step waiting for
+ *					the bolt to reach its target
+ *[Arguments]     : void
+ *[Return]        : void
+ ******************************************************************************/
+void Control_motorArrived(void);
+
+/******************************************************************************
+ *[Function Name] : Control_sensorChanged
+ *[Description]   : This function is door sensors callback: door contact changes are notified
+ *					to HMI ECU while a timeline runs, the door closing ends the unlocking step
+ *					and the bolt thrown ends the locking step and zeroes the encoder
+ *[Arguments]     : SENSOR_Id id: sensor
+ *					uint8 closed: TRUE if its switch closed
+ *[Return]        : void
+ ******************************************************************************/
+void Control_sensorChanged(SENSOR_Id id, uint8 closed);
+
+/******************************************************************************
+ *[Function Name] : Control_sendNotifications
+ *[Description]   : This function sends to HMI ECU the notifications queued by the steps of
+ *					door and alarm timelines
+ *[Arguments]     : void
+ *[Return]        : void
+ ******************************************************************************/
+void Control_sendNotifications(void);
+
+#if(PROBE_ENABLE)
+/******************************************************************************
+ *[Function Name] : Control_dumpTimeline
+ *[Description]   : This function sends the timeline counters on the probes dump channel as a
+ *					line of hex numbers: N<notifications dropped>
  *[Arguments]     : void
  *[Return]        : void
  ******************************************************************************/
-void fireBuzzerOrOpenDoor(void);
+void Control_dumpTimeline(void);
+#endif
+
+/******************************************************************************
+ *[Function Name] : Control_waitForSignal
+ *[Description]   : This function waits until HMI ECU sends the given signal, other bytes are
+ *					dropped except DIAG_PROBE_DUMP/DIAG_TRACE_DUMP requests which are answered
+ *					with the latency histograms and timeline counters/trace ring (only when
+ *					enabled), DIAG_HASH_BENCH
+ *					which is answered with the histograms after a PIN digest benchmark, BUS_POLL
+ *					which is answered with the door status and CHECK_FOR_SAVED_PASSWORD which
+ *					is answered with the saved password status. Timeline notifications are
+ *					sent meanwhile
+ *[Arguments]     : uint8 signal
+ *[Return]        : void
+ ******************************************************************************/
+void Control_waitForSignal(uint8 signal);
 
 #endif /* CONTROL_ECU_H_ */
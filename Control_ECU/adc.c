@@ -0,0 +1,61 @@
+/*******************************************************************************************
+ * [FILE NAME]:		adc.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains implementation of the ADC driver in AVR ATMEGA-16
+ * 					Micro-controller
+ *******************************************************************************************/
+
+#include "adc.h"
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+static void (* volatile g_callBackPtr)(uint16) = NULL_PTR;
+
+/******************************************************************
+ * 				  Interrupt Service Routines					  *
+ ******************************************************************/
+ISR(ADC_vect)
+{
+	/*Go to callback function with the result*/
+	if(g_callBackPtr != NULL_PTR)
+	{
+		(*g_callBackPtr)(ADC);
+	}
+}
+
+/******************************************************************
+ * 				  Public Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function initialises the ADC:
+ * 1. Selects the reference voltage with right adjusted results
+ * 2. Selects free running mode as auto trigger source (ADTS2:0 = 0)
+ * 3. Enables the ADC with the given prescalar, its interrupt is enabled on start*/
+void ADC_init(const ADC_ConfigType * Config_Ptr)
+{
+	ADMUX=(uint8)(Config_Ptr->reference<<REFS0);
+	SFIOR&=~((1<<ADTS2)|(1<<ADTS1)|(1<<ADTS0));
+	ADCSRA=(1<<ADEN)|(1<<ADIF)|(Config_Ptr->prescaler & 0x07);
+}
+
+/*Description: This function selects the channel and starts free running conversions, ADIF
+ *is written one to drop a pending result*/
+void ADC_startFreeRunning(uint8 channel)
+{
+	ADMUX=(ADMUX & 0xE0) | (channel & 0x07);
+	ADCSRA|=(1<<ADIF)|(1<<ADIE)|(1<<ADATE)|(1<<ADSC);
+}
+
+/*Description: This function stops free running conversions and disables the interrupt so
+ *the conversion in progress isn't reported*/
+void ADC_stop(void)
+{
+	ADCSRA=(ADCSRA & ~((1<<ADIE)|(1<<ADATE))) | (1<<ADIF);
+}
+
+/*Description: This function sets call back function for ADC module*/
+void ADC_setCallBack(void(*a_ptr)(uint16))
+{
+	g_callBackPtr=a_ptr;
+}
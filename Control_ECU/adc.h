@@ -0,0 +1,90 @@
+/*******************************************************************************************
+ * [FILE NAME]:		adc.h
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This header file contains data types and function prototypes of the ADC
+ * 					driver in AVR ATMEGA-16 Micro-controller. The ADC is free running on one
+ * 					single-ended channel and each result is passed to a callback from ADC
+ * 					interrupt: a conversion takes 13 ADC clocks, so a sample every
+ * 					13*prescalar/F_CPU (208 usec at F_CPU/128 and 8 MHz)
+ *******************************************************************************************/
+
+#ifndef ADC_H_
+#define ADC_H_
+
+/******************************************************************
+ * 				Common Header Files Inclusion					  *
+ ******************************************************************/
+#include "micro_config.h"
+#include "std_types.h"
+#include "common_macros.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+/*ADC clocks of a conversion in free running mode*/
+#define ADC_CONVERSION_CLOCKS	13u
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[ENUM Name]		 : ADC_ReferenceVoltage
+ *[ENUM Description]: This enum contains the reference voltages selected by REFS1:0*/
+typedef enum{
+	ADC_AREF,ADC_AVCC,ADC_INTERNAL_2_56=3
+}ADC_ReferenceVoltage;
+
+/*[ENUM Name]		 : ADC_Prescaler
+ *[ENUM Description]: This enum contains the ADC clock prescalars selected by ADPS2:0, the
+ *					   ADC clock shall be between 50 and 200 KHz for 10-bit results*/
+typedef enum{
+	ADC_F_CPU_2=1,ADC_F_CPU_4,ADC_F_CPU_8,ADC_F_CPU_16,ADC_F_CPU_32,ADC_F_CPU_64,ADC_F_CPU_128
+}ADC_Prescaler;
+
+/*[Structure Name]		 : ADC_ConfigType
+ *[Structure Description]: This structure contains the reference voltage and the clock
+ * 						   prescalar of the ADC*/
+typedef struct{
+	ADC_ReferenceVoltage reference;
+	ADC_Prescaler prescaler;
+}ADC_ConfigType;
+
+/******************************************************************
+ * 				    Public Functions Prototypes					  *
+ ******************************************************************/
+/*******************************************************************************
+ * [Function Name]	: ADC_init
+ * [Description]	: This function enables the ADC with its interrupt and selects free
+ * 					  running as auto trigger source, no conversion is started
+ * [Arguments]		: const ADC_ConfigType * Config_Ptr: reference and prescalar
+ * [Returns]		: void
+ *******************************************************************************/
+void ADC_init(const ADC_ConfigType * Config_Ptr);
+
+/*******************************************************************************
+ * [Function Name]	: ADC_startFreeRunning
+ * [Description]	: This function starts free running conversions of a channel, a
+ * 					  result pending from before is dropped
+ * [Arguments]		: uint8 channel: single-ended channel ADC0..ADC7
+ * [Returns]		: void
+ *******************************************************************************/
+void ADC_startFreeRunning(uint8 channel);
+
+/*******************************************************************************
+ * [Function Name]	: ADC_stop
+ * [Description]	: This function stops free running conversions, the callback isn't
+ * 					  called anymore (the conversion in progress completes unreported)
+ * [Arguments]		: void
+ * [Returns]		: void
+ *******************************************************************************/
+void ADC_stop(void);
+
+/*******************************************************************************
+ * [Function Name]	: ADC_setCallBack
+ * [Description]	: This function sets the function called with each result
+ * [Arguments]		: void(*a_ptr)(uint16): callback, given the 10-bit result
+ * [Returns]		: void
+ *******************************************************************************/
+void ADC_setCallBack(void(*a_ptr)(uint16));
+
+#endif /* ADC_H_ */
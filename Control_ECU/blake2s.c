@@ -0,0 +1,163 @@
+/*******************************************************************************************
+ * [FILE NAME]:		blake2s.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains implementation of the BLAKE2s hash for AVR ATMEGA-16
+ * 					Micro-controller
+ *******************************************************************************************/
+
+#include "blake2s.h"
+
+/******************************************************************
+ * 						Function-like Macros					  *
+ ******************************************************************/
+/*Rotation of a 32-bit word to the right, rotations by 16 and 8 compile to byte moves*/
+#define BLAKE2S_ROTR(X,N)		(((X)>>(N)) | ((X)<<(32u-(N))))
+
+/*Mixing function G on 4 words of the work vector with 2 message words picked by the
+ *permutation of the round*/
+#define BLAKE2S_G(A,B,C,D,I)	v[A]+=v[B]+m[pgm_read_byte(&sigma[I])];	\
+								v[D]=BLAKE2S_ROTR(v[D]^v[A],16);			\
+								v[C]+=v[D];									\
+								v[B]=BLAKE2S_ROTR(v[B]^v[C],12);			\
+								v[A]+=v[B]+m[pgm_read_byte(&sigma[(I)+1])];	\
+								v[D]=BLAKE2S_ROTR(v[D]^v[A],8);			\
+								v[C]+=v[D];									\
+								v[B]=BLAKE2S_ROTR(v[B]^v[C],7)
+
+/******************************************************************
+ * 				  Private Functions Prototypes					  *
+ ******************************************************************/
+static void BLAKE2S_compress(uint32 count, uint8 last);
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[Structure Name]		 : BLAKE2S_WorkType
+ *[Structure Description]: This structure contains the work area of a digest: the state,
+ * 						   the message block and the work vector of the compression*/
+typedef struct{
+	uint32 h[8];
+	uint32 m[16];
+	uint32 v[16];
+}BLAKE2S_WorkType;
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+/*Work area of the digest being computed, static so its 160 bytes are counted in the static
+ *RAM of the build instead of the stack. BLAKE2S_hash is not reentrant, it's only called from
+ *the main loop*/
+static BLAKE2S_WorkType g_work;
+
+/*Initialisation vector, in flash*/
+static const uint32 g_iv[8] PROGMEM={
+		0x6A09E667UL,0xBB67AE85UL,0x3C6EF372UL,0xA54FF53AUL,
+		0x510E527FUL,0x9B05688CUL,0x1F83D9ABUL,0x5BE0CD19UL};
+
+/*Message word permutation of each round, in flash*/
+static const uint8 g_sigma[BLAKE2S_ROUNDS][16] PROGMEM={
+		{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,15},
+		{14,10, 4, 8, 9,15,13, 6, 1,12, 0, 2,11, 7, 5, 3},
+		{11, 8,12, 0, 5, 2,15,13,10,14, 3, 6, 7, 1, 9, 4},
+		{ 7, 9, 3, 1,13,12,11,14, 2, 6, 5,10, 4, 0,15, 8},
+		{ 9, 0, 5, 7, 2, 4,10,15,14, 1,11,12, 6, 8, 3,13},
+		{ 2,12, 6,10, 0,11, 8, 3, 4,13, 7, 5,15,14, 1, 9},
+		{12, 5, 1,15,14,13, 4,10, 0, 7, 6, 3, 9, 2, 8,11},
+		{13,11, 7,14,12, 1, 3, 9, 5, 0,15, 4, 8, 6, 2,10},
+		{ 6,15,14, 9,11, 3, 0, 8,12, 2,13, 7, 1, 4,10, 5},
+		{10, 2, 8, 4, 7, 6, 1, 5,15,11, 9,14, 3,12,13, 0}};
+
+/******************************************************************
+ * 				  Public Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function computes a digest:
+ * 1. Takes the IV with the parameter block XORed in: digest size, fanout and depth of 1
+ *    (sequential mode) and the salt in words 4 and 5
+ * 2. Compresses the message block by block, the last one (or an empty message) padded with
+ *    zeros and flagged as last
+ * 3. Takes the first bytes of the state, little endian*/
+void BLAKE2S_hash(uint8 * digest, uint8 digestSize, const uint8 * message, uint16 size,
+				  const uint8 * salt)
+{
+	uint32 * h=g_work.h;
+	uint32 * m=g_work.m;
+	uint16 offset=0;
+	uint16 left;
+	uint8 chunk;
+	uint8 i;
+	for(i=0;i<8u;i++)
+	{
+		h[i]=pgm_read_dword(&g_iv[i]);
+	}
+	h[0]^=0x01010000UL | digestSize;
+	if(salt != NULL_PTR)
+	{
+		for(i=0;i<BLAKE2S_SALT_SIZE;i++)
+		{
+			h[4u+(i>>2)]^=(uint32)salt[i]<<(8u*(i & 3u));
+		}
+	}
+	do
+	{
+		left=size-offset;
+		chunk=(left > BLAKE2S_BLOCK_SIZE) ? BLAKE2S_BLOCK_SIZE : (uint8)left;
+		for(i=0;i<16u;i++)
+		{
+			m[i]=0;
+		}
+		for(i=0;i<chunk;i++)
+		{
+			m[i>>2]|=(uint32)message[offset+i]<<(8u*(i & 3u));
+		}
+		offset+=chunk;
+		BLAKE2S_compress(offset,(offset == size) ? TRUE : FALSE);
+	}while(offset < size);
+	for(i=0;i<digestSize;i++)
+	{
+		digest[i]=(uint8)(h[i>>2]>>(8u*(i & 3u)));
+	}
+}
+
+/******************************************************************
+ * 				  Private Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function compresses the message block of the work area in its state: the
+ *work vector is the state and the IV with the byte count and last block flag XORed in, each
+ *round mixes its columns then its diagonals, unrolled, and both halves of the vector are
+ *folded in the state*/
+static void BLAKE2S_compress(uint32 count, uint8 last)
+{
+	uint32 * h=g_work.h;
+	const uint32 * m=g_work.m;
+	uint32 * v=g_work.v;
+	const uint8 * sigma;
+	uint8 round;
+	uint8 i;
+	for(i=0;i<8u;i++)
+	{
+		v[i]=h[i];
+		v[i+8u]=pgm_read_dword(&g_iv[i]);
+	}
+	v[12]^=count;
+	if(last)
+	{
+		v[14]=~v[14];
+	}
+	for(round=0;round<BLAKE2S_ROUNDS;round++)
+	{
+		sigma=g_sigma[round];
+		BLAKE2S_G(0,4, 8,12, 0);
+		BLAKE2S_G(1,5, 9,13, 2);
+		BLAKE2S_G(2,6,10,14, 4);
+		BLAKE2S_G(3,7,11,15, 6);
+		BLAKE2S_G(0,5,10,15, 8);
+		BLAKE2S_G(1,6,11,12,10);
+		BLAKE2S_G(2,7, 8,13,12);
+		BLAKE2S_G(3,4, 9,14,14);
+	}
+	for(i=0;i<8u;i++)
+	{
+		h[i]^=v[i] ^ v[i+8u];
+	}
+}
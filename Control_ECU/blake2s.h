@@ -0,0 +1,49 @@
+/*******************************************************************************************
+ * [FILE NAME]:		blake2s.h
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This header file contains static configurations and function prototypes
+ * 					of the BLAKE2s hash (RFC 7693) PINs are stored as: a salted digest of 1 to
+ * 					32 bytes, the salt and digest size taken in the parameter block. BLAKE2s
+ * 					is chosen for the 8-bit core as it has no message schedule, 10 rounds and
+ * 					only 32-bit additions, XORs and rotations, two of which (16 and 8 bits)
+ * 					are byte moves on AVR. Its IV and message permutations are kept in flash
+ * 					and each round is unrolled, its 160 byte work area is static so it is
+ * 					counted in static RAM and the hash is not reentrant
+ *******************************************************************************************/
+
+#ifndef BLAKE2S_H_
+#define BLAKE2S_H_
+
+/******************************************************************
+ * 				Common Header Files Inclusion					  *
+ ******************************************************************/
+#include "micro_config.h"
+#include "std_types.h"
+#include "common_macros.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+#define BLAKE2S_BLOCK_SIZE		64u
+#define BLAKE2S_SALT_SIZE		8u
+#define BLAKE2S_MAX_DIGEST		32u
+#define BLAKE2S_ROUNDS			10u
+
+/******************************************************************
+ * 				    Public Functions Prototypes					  *
+ ******************************************************************/
+/*******************************************************************************
+ * [Function Name]	: BLAKE2S_hash
+ * [Description]	: This function computes the BLAKE2s digest of a message, unkeyed
+ * [Arguments]		: uint8 * digest: filled with the digest
+ * 					  uint8 digestSize: bytes of the digest, 1 to BLAKE2S_MAX_DIGEST
+ * 					  const uint8 * message
+ * 					  uint16 size: bytes of the message
+ * 					  const uint8 * salt: BLAKE2S_SALT_SIZE bytes, NULL_PTR for no salt
+ * [Returns]		: void
+ *******************************************************************************/
+void BLAKE2S_hash(uint8 * digest, uint8 digestSize, const uint8 * message, uint16 size,
+				  const uint8 * salt);
+
+#endif /* BLAKE2S_H_ */
@@ -0,0 +1,133 @@
+/*******************************************************************************************
+ * [FILE NAME]:		buzzer.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains implementation of the buzzer driver on TIMER1 in
+ * 					AVR ATMEGA-16 Micro-controller
+ *******************************************************************************************/
+
+#include "buzzer.h"
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+/*Pattern playing (NULL_PTR if none), its current note and the ticks left till the next one*/
+static const BUZZER_NoteType * volatile g_pattern=NULL_PTR;
+static const BUZZER_NoteType * volatile g_note=NULL_PTR;
+static volatile uint16 g_ticks=0;
+
+/******************************************************************
+ * 				  Private Functions Prototypes					  *
+ ******************************************************************/
+static void BUZZER_tick(void);
+static void BUZZER_playNote(void);
+static void BUZZER_silence(void);
+
+/******************************************************************
+ * 				  Public Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function initialises the buzzer:
+ * 1. Sets the pin as output held low, OC1B overrides it only while a tone plays
+ * 2. Stops TIMER1 with its interrupts disabled, OC1B toggles at BOTTOM (OCR1B = 0)
+ * 3. Sets the driver as client of the tick service*/
+void BUZZER_init(void)
+{
+	CLEAR_BIT(BUZZER_PORT,BUZZER_PIN);
+	SET_BIT(BUZZER_DIR,BUZZER_PIN);
+	TIMSK&=~((1<<TICIE1)|(1<<OCIE1A)|(1<<OCIE1B)|(1<<TOIE1));
+	BUZZER_silence();
+	OCR1B=0;
+	g_pattern=NULL_PTR;
+	TICK_setCallBack(TICK_BUZZER,BUZZER_tick);
+}
+
+/*Description: This function plays a pattern, with interrupts disabled as the tick moves
+ *through notes from interrupt. The pattern playing is silenced first*/
+void BUZZER_play(const BUZZER_NoteType * pattern)
+{
+	uint8 sreg=SREG;
+	cli();
+	BUZZER_silence();
+	g_pattern=pattern;
+	g_note=pattern;
+	BUZZER_playNote();
+	SREG=sreg;
+}
+
+/*Description: This function stops the pattern playing*/
+void BUZZER_stop(void)
+{
+	uint8 sreg=SREG;
+	cli();
+	g_pattern=NULL_PTR;
+	BUZZER_silence();
+	SREG=sreg;
+}
+
+/*Description: This function returns TRUE while a pattern plays*/
+uint8 BUZZER_isPlaying(void)
+{
+	return (g_pattern != NULL_PTR) ? TRUE : FALSE;
+}
+
+/******************************************************************
+ * 				  Private Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function is the tick service callback, the next note plays when the
+ *ticks of the current one are over*/
+static void BUZZER_tick(void)
+{
+	if(g_pattern == NULL_PTR)
+	{
+		return;
+	}
+	g_ticks--;
+	if(g_ticks == 0)
+	{
+		g_note++;
+		BUZZER_playNote();
+	}
+}
+
+/*Description: This function plays the current note read from flash. The last entry ends
+ *the pattern or starts it over. A tone runs TIMER1 in CTC mode with TOP = OCR1A (WGM13:0
+ *= 4) at F_CPU/8 and OC1B toggled on compare match: OCR1A isn't buffered in CTC mode, so
+ *the counter is cleared if it's past the new TOP (else it would count up to 0xFFFF)*/
+static void BUZZER_playNote(void)
+{
+	uint16 top=pgm_read_word(&g_note->top);
+	g_ticks=pgm_read_word(&g_note->ticks);
+	if(g_ticks == 0)
+	{
+		if(top == 0)
+		{
+			g_pattern=NULL_PTR;
+			BUZZER_silence();
+			return;
+		}
+		g_note=g_pattern;
+		top=pgm_read_word(&g_note->top);
+		g_ticks=pgm_read_word(&g_note->ticks);
+	}
+	if(top == BUZZER_REST)
+	{
+		BUZZER_silence();
+		return;
+	}
+	OCR1A=top;
+	if(TCNT1 > top)
+	{
+		TCNT1=0;
+	}
+	TCCR1A=(1<<COM1B0);
+	TCCR1B=(1<<WGM12)|(1<<CS11);
+}
+
+/*Description: This function stops TIMER1 and disconnects OC1B, the pin goes back to its
+ *PORTD bit which is low*/
+static void BUZZER_silence(void)
+{
+	TCCR1B=0;
+	TCCR1A=0;
+	TCNT1=0;
+}
@@ -0,0 +1,97 @@
+/*******************************************************************************************
+ * [FILE NAME]:		buzzer.h
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This header file contains static configurations, data types and function
+ * 					prototypes of the buzzer driver: tones are generated by TIMER1 toggling
+ * 					OC1B (PD4) in CTC mode, so no interrupt or CPU time is spent per cycle
+ * 					of the tone. A pattern is a table of notes in flash, each one a tone
+ * 					(or a rest) held for a number of ticks of the tick service (tick.h,
+ * 					2.048 msec), which moves to the next note. Playing a pattern returns at
+ * 					once and a new pattern replaces the one playing
+ *******************************************************************************************/
+
+#ifndef BUZZER_H_
+#define BUZZER_H_
+
+/******************************************************************
+ * 				Common Header Files Inclusion					  *
+ ******************************************************************/
+#include "micro_config.h"
+#include "std_types.h"
+#include "common_macros.h"
+#include "tick.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+/*Static Configuration for buzzer pin, OC1B pin of TIMER1*/
+#define BUZZER_DIR				DDRD
+#define BUZZER_PORT				PORTD
+#define BUZZER_PIN				PD4
+/*Prescalar of TIMER1 while a tone plays: F_CPU/8 --> 1 usec counts at 8 MHz, tones from
+ *8 Hz up to 500 KHz*/
+#define BUZZER_PRESCALER		8UL
+/*Compare value of a tone: OC1B toggles once per 1+OCR1A counts,
+ *f = F_CPU/(2*BUZZER_PRESCALER*(1+OCR1A))*/
+#define BUZZER_TONE(HZ)			((uint16)((F_CPU/(2UL*BUZZER_PRESCALER*(HZ)))-1UL))
+/*Tone of a rest, the pin is held low*/
+#define BUZZER_REST				0u
+/*Note of a pattern: a tone in Hz (or BUZZER_REST) held for a time in msec*/
+#define BUZZER_NOTE(HZ,MS)		{BUZZER_TONE(HZ),(uint16)TICK_FROM_MS(MS)}
+#define BUZZER_PAUSE(MS)		{BUZZER_REST,(uint16)TICK_FROM_MS(MS)}
+/*Last entry of a pattern: it ends there, or starts over until it's stopped*/
+#define BUZZER_END				{0u,0u}
+#define BUZZER_REPEAT			{1u,0u}
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[Structure Name]		 : BUZZER_NoteType
+ *[Structure Description]: This structure contains a note of a pattern: the compare value of
+ * 						   its tone (BUZZER_TONE, BUZZER_REST for a rest) and its ticks, 0
+ * 						   for the last entry (BUZZER_END or BUZZER_REPEAT)*/
+typedef struct{
+	uint16 top;
+	uint16 ticks;
+}BUZZER_NoteType;
+
+/******************************************************************
+ * 				    Public Functions Prototypes					  *
+ ******************************************************************/
+/*******************************************************************************
+ * [Function Name]	: BUZZER_init
+ * [Description]	: This function sets the buzzer pin as output held low, stops TIMER1
+ * 					  and sets the driver as client of the tick service
+ * [Arguments]		: void
+ * [Returns]		: void
+ *******************************************************************************/
+void BUZZER_init(void);
+
+/*******************************************************************************
+ * [Function Name]	: BUZZER_play
+ * [Description]	: This function plays a pattern from its first note, the one playing
+ * 					  is stopped first
+ * [Arguments]		: const BUZZER_NoteType * pattern: table of notes in flash (PROGMEM),
+ * 					  its first note shall last at least a tick
+ * [Returns]		: void
+ *******************************************************************************/
+void BUZZER_play(const BUZZER_NoteType * pattern);
+
+/*******************************************************************************
+ * [Function Name]	: BUZZER_stop
+ * [Description]	: This function stops the pattern playing, the pin is held low
+ * [Arguments]		: void
+ * [Returns]		: void
+ *******************************************************************************/
+void BUZZER_stop(void);
+
+/*******************************************************************************
+ * [Function Name]	: BUZZER_isPlaying
+ * [Description]	: This function returns TRUE while a pattern plays
+ * [Arguments]		: void
+ * [Returns]		: uint8
+ *******************************************************************************/
+uint8 BUZZER_isPlaying(void);
+
+#endif /* BUZZER_H_ */
@@ -0,0 +1,73 @@
+/*******************************************************************************************
+ * [FILE NAME]:		clock.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains implementation of the time base on TIMER0 in AVR
+ * 					ATMEGA-16 Micro-controller
+ *******************************************************************************************/
+
+#include "clock.h"
+#include "idle.h"
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+/*Upper bits of the time, counted by TIMER0 overflow (every 256 ticks)*/
+static volatile uint32 g_overflows=0;
+
+static void (* volatile g_overflowCallBackPtr)(void) = NULL_PTR;
+
+/******************************************************************
+ * 				  Interrupt Service Routines					  *
+ ******************************************************************/
+ISR(TIMER0_OVF_vect)
+{
+	IDLE_WAKE();
+	g_overflows++;
+	/*Go to callback function*/
+	if(g_overflowCallBackPtr != NULL_PTR)
+	{
+		(*g_overflowCallBackPtr)();
+	}
+}
+
+/******************************************************************
+ * 				  Public Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function starts TIMER0 in normal mode at F_CPU/64 if its clock is
+ *stopped (the motor driver sets fast PWM mode later on, keeping the clock) and enables its
+ *overflow interrupt*/
+void CLOCK_init(void)
+{
+	if((TCCR0 & ((1<<CS02)|(1<<CS01)|(1<<CS00))) == 0)
+	{
+		g_overflows=0;
+		TCNT0=0;
+		TCCR0=(1<<CS01)|(1<<CS00);
+	}
+	SET_BIT(TIMSK,TOIE0);
+}
+
+/*Description: This function returns the time in clock ticks, an overflow which happened
+ *and is not served yet (interrupts disabled or counter just wrapped) is counted too*/
+uint32 CLOCK_now(void)
+{
+	uint8 sreg=SREG;
+	uint32 overflows;
+	uint8 count;
+	cli();
+	overflows=g_overflows;
+	count=TCNT0;
+	if(IS_BIT_SET(TIFR,TOV0) && (count < 0x80))
+	{
+		overflows++;
+	}
+	SREG=sreg;
+	return (overflows<<8) | count;
+}
+
+/*Description: This function sets call back function for TIMER0 overflow*/
+void CLOCK_setOverflowCallBack(void(*a_ptr)(void))
+{
+	g_overflowCallBackPtr=a_ptr;
+}
@@ -0,0 +1,356 @@
+/*******************************************************************************************
+ * [FILE NAME]:		credential.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains implementation of the user credential table in the
+ * 					external EEPROM with its RAM index
+ *******************************************************************************************/
+
+#include "credential.h"
+#include "probe.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+/*Address of the record of a slot*/
+#define CRED_RECORD_ADDR(SLOT)	(uint16)(CRED_TABLE_ADDR+((uint16)(SLOT)*CRED_RECORD_SIZE))
+/*Erased ID, an unused slot*/
+#define CRED_ERASED				0xFFu
+/*Slot read when no entry of the index has the tag, so a PIN which isn't found reads a record
+ *like one which is. Its record is never taken as the mismatch is set before it's read*/
+#define CRED_DUMMY_SLOT			0u
+/*Write cycle time of the EEPROM after a page write, in msec*/
+#define CRED_WRITE_TIME_MS		10u
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[Structure Name]		 : CRED_IndexType
+ *[Structure Description]: This structure contains an entry of the index: the first 2 bytes
+ * 						   of the digest of a user's PIN and the slot of its record*/
+typedef struct{
+	uint16 tag;
+	uint8 slot;
+}CRED_IndexType;
+
+/******************************************************************
+ * 				  Private Functions Prototypes					  *
+ ******************************************************************/
+static void CRED_digest(const uint8 * pin, uint8 * digest);
+static uint8 CRED_checkSum(const uint8 * data, uint8 size);
+static uint8 CRED_checkByte(const CRED_RecordType * record);
+static uint8 CRED_search(uint16 tag);
+static void CRED_insert(uint16 tag, uint8 slot);
+static void CRED_remove(uint8 slot);
+static uint8 CRED_write(uint16 address, const uint8 * data, uint8 size);
+static void CRED_lock(void);
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+/*Index of the users sorted by tag and its number of entries*/
+static CRED_IndexType g_index[CRED_CAPACITY];
+static uint8 g_count=0;
+
+/*First erased slot, a user is added there*/
+static uint8 g_free=0;
+
+/*Table header and whether it's valid, PINs are hashed with its salt*/
+static CRED_HeaderType g_header;
+static uint8 g_salted=FALSE;
+
+/*The table couldn't be read, or has records without a valid header: no user is indexed and
+ *none can be added*/
+static uint8 g_locked=FALSE;
+
+/*Entropy pool and the number of samples mixed in it*/
+static uint8 g_pool[CRED_POOL_SIZE];
+static uint8 g_stirs=0;
+
+/******************************************************************
+ * 				  Public Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function reads the header then the records slot by slot till the first
+ *erased one, and indexes the valid active ones if the header is valid. It fails closed: a
+ *failed read, or records without a valid header (a corrupted or erased header page), lock
+ *the table instead of leaving it empty, so a door can't be taken over by setting a new
+ *first password*/
+void CRED_init(void)
+{
+	CRED_RecordType record;
+	uint8 slot;
+	g_count=0;
+	g_free=0;
+	g_locked=FALSE;
+	if(EEPROM_readBlock(CRED_HEADER_ADDR,(uint8 *)&g_header,sizeof(CRED_HeaderType)) != EEPROM_SUCCESS)
+	{
+		CRED_lock();
+		return;
+	}
+	g_salted=(g_header.check == CRED_checkSum(g_header.salt,CRED_SALT_SIZE)) ? TRUE : FALSE;
+	for(slot=0;slot<CRED_CAPACITY;slot++)
+	{
+		if(EEPROM_readBlock(CRED_RECORD_ADDR(slot),(uint8 *)&record,CRED_RECORD_SIZE) != EEPROM_SUCCESS)
+		{
+			CRED_lock();
+			return;
+		}
+		if(record.id == CRED_ERASED)
+		{
+			break;
+		}
+		if(!g_salted)
+		{
+			CRED_lock();
+			return;
+		}
+		g_free=slot+1u;
+		if((record.check == CRED_checkByte(&record)) && (record.id == (uint8)(slot+1u))
+		   && (record.flags & CRED_ACTIVE))
+		{
+			CRED_insert((uint16)((record.digest[0]<<8) | record.digest[1]),slot);
+		}
+	}
+}
+
+/*Description: This function mixes a sample in the next byte of the pool, rotated so
+ *samples falling on the same byte don't cancel each other*/
+void CRED_stir(uint8 sample)
+{
+	uint8 * byte=&g_pool[g_stirs%CRED_POOL_SIZE];
+	*byte=(uint8)(((*byte<<1) | (*byte>>7)) ^ sample);
+	g_stirs++;
+}
+
+/*Description: This function returns the number of users in the index*/
+uint8 CRED_getCount(void)
+{
+	return g_count;
+}
+
+/*Description: This function returns TRUE if there is no erased slot left*/
+uint8 CRED_isFull(void)
+{
+	return (g_free >= CRED_CAPACITY) ? TRUE : FALSE;
+}
+
+/*Description: This function returns TRUE if the table is locked*/
+uint8 CRED_isLocked(void)
+{
+	return g_locked;
+}
+
+/*Description: This function looks a PIN up: the binary search gives the first entry of its
+ *tag and the records of the entries with this tag are read till one has its whole digest.
+ *The record of CRED_DUMMY_SLOT is read if no entry has the tag, an empty index included, so
+ *a PIN which isn't found takes the same time as one found on its first candidate*/
+uint8 CRED_find(const uint8 * pin, CRED_RecordType * record)
+{
+	uint8 digest[CRED_DIGEST_SIZE];
+	uint16 tag;
+	uint8 position;
+	uint8 slot;
+	uint8 mismatch;
+	uint8 i;
+	CRED_digest(pin,digest);
+	tag=(uint16)((digest[0]<<8) | digest[1]);
+	position=CRED_search(tag);
+	do
+	{
+		mismatch=((position < g_count) && (g_index[position].tag == tag)) ? 0u : 1u;
+		slot=(mismatch == 0) ? g_index[position].slot : CRED_DUMMY_SLOT;
+		if(EEPROM_readBlock(CRED_RECORD_ADDR(slot),(uint8 *)record,CRED_RECORD_SIZE) != EEPROM_SUCCESS)
+		{
+			mismatch=1u;
+		}
+		for(i=0;i<CRED_DIGEST_SIZE;i++)
+		{
+			mismatch|=(uint8)(record->digest[i] ^ digest[i]);
+		}
+		if((mismatch == 0) && (record->check == CRED_checkByte(record)) && (record->flags & CRED_ACTIVE))
+		{
+			return slot;
+		}
+		position++;
+	}while((position < g_count) && (g_index[position].tag == tag));
+	return CRED_NONE;
+}
+
+/*Description: This function writes the record of a new user in the first erased slot and
+ *indexes it*/
+CRED_Status CRED_add(const uint8 * pin, uint8 flags)
+{
+	CRED_RecordType record;
+	if(g_locked)
+	{
+		return CRED_ERROR;
+	}
+	if(CRED_isFull())
+	{
+		return CRED_FULL;
+	}
+	if(CRED_find(pin,&record) != CRED_NONE)
+	{
+		return CRED_DUPLICATE;
+	}
+	/*The salt is the digest of the pool, written before any record is hashed with it*/
+	if(!g_salted)
+	{
+		BLAKE2S_hash(g_header.salt,CRED_SALT_SIZE,g_pool,CRED_POOL_SIZE,NULL_PTR);
+		g_header.check=CRED_checkSum(g_header.salt,CRED_SALT_SIZE);
+		if(!CRED_write(CRED_HEADER_ADDR,(const uint8 *)&g_header,sizeof(CRED_HeaderType)))
+		{
+			return CRED_ERROR;
+		}
+		g_salted=TRUE;
+	}
+	record.id=(uint8)(g_free+1u);
+	record.flags=flags;
+	CRED_digest(pin,record.digest);
+	record.check=CRED_checkByte(&record);
+	if(!CRED_write(CRED_RECORD_ADDR(g_free),(const uint8 *)&record,CRED_RECORD_SIZE))
+	{
+		return CRED_ERROR;
+	}
+	CRED_insert((uint16)((record.digest[0]<<8) | record.digest[1]),g_free);
+	g_free++;
+	return CRED_OK;
+}
+
+/*Description: This function rewrites the record of a user with the digest of its new PIN,
+ *keeping its ID and flags, and moves its index entry to the new tag. The same PIN as the
+ *user's current one leaves the record as it is*/
+CRED_Status CRED_changePin(uint8 slot, const uint8 * pin)
+{
+	CRED_RecordType record;
+	uint8 found=CRED_find(pin,&record);
+	if(found == slot)
+	{
+		return CRED_OK;
+	}
+	if(found != CRED_NONE)
+	{
+		return CRED_DUPLICATE;
+	}
+	if(EEPROM_readBlock(CRED_RECORD_ADDR(slot),(uint8 *)&record,CRED_RECORD_SIZE) != EEPROM_SUCCESS)
+	{
+		return CRED_ERROR;
+	}
+	CRED_digest(pin,record.digest);
+	record.check=CRED_checkByte(&record);
+	if(!CRED_write(CRED_RECORD_ADDR(slot),(const uint8 *)&record,CRED_RECORD_SIZE))
+	{
+		return CRED_ERROR;
+	}
+	CRED_remove(slot);
+	CRED_insert((uint16)((record.digest[0]<<8) | record.digest[1]),slot);
+	return CRED_OK;
+}
+
+/*Description: This function computes digests of a fixed PIN back to back, the PIN doesn't
+ *change the time of a digest*/
+void CRED_benchmark(void)
+{
+	static const uint8 pin[CRED_PIN_SIZE]={'0','0','0','0','0'};
+	uint8 digest[CRED_DIGEST_SIZE];
+	uint8 run;
+	for(run=0;run<CRED_BENCH_RUNS;run++)
+	{
+		CRED_digest(pin,digest);
+	}
+}
+
+/******************************************************************
+ * 				  Private Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function computes the digest of a PIN, its BLAKE2s digest of
+ *CRED_DIGEST_SIZE bytes salted by the salt of the door*/
+static void CRED_digest(const uint8 * pin, uint8 * digest)
+{
+	PROBE_START(PROBE_HASH);
+	BLAKE2S_hash(digest,CRED_DIGEST_SIZE,pin,CRED_PIN_SIZE,g_header.salt);
+	PROBE_STOP(PROBE_HASH);
+}
+
+/*Description: This function computes the check byte of some bytes, the one's complement of
+ *their sum, so erased bytes fail it*/
+static uint8 CRED_checkSum(const uint8 * data, uint8 size)
+{
+	uint8 sum=0;
+	uint8 i;
+	for(i=0;i<size;i++)
+	{
+		sum+=data[i];
+	}
+	return (uint8)~sum;
+}
+
+/*Description: This function computes the check byte of a record, of all its other bytes*/
+static uint8 CRED_checkByte(const CRED_RecordType * record)
+{
+	return CRED_checkSum((const uint8 *)record,CRED_RECORD_SIZE-1u);
+}
+
+/*Description: This function returns the position of the first entry of the index with a tag
+ *not below the given one (g_count if none): the span is halved on each step whatever the
+ *number of entries, so a search takes log2(CRED_SEARCH_SPAN)+1 steps*/
+static uint8 CRED_search(uint16 tag)
+{
+	uint8 position=0;
+	uint8 step;
+	for(step=CRED_SEARCH_SPAN;step != 0;step>>=1)
+	{
+		if((((uint16)position+step) <= g_count) && (g_index[position+step-1u].tag < tag))
+		{
+			position+=step;
+		}
+	}
+	return position;
+}
+
+/*Description: This function inserts an entry in the index at the position of its tag*/
+static void CRED_insert(uint16 tag, uint8 slot)
+{
+	uint8 position=CRED_search(tag);
+	uint8 i;
+	for(i=g_count;i>position;i--)
+	{
+		g_index[i]=g_index[i-1u];
+	}
+	g_index[position].tag=tag;
+	g_index[position].slot=slot;
+	g_count++;
+}
+
+/*Description: This function removes the entry of a slot from the index*/
+static void CRED_remove(uint8 slot)
+{
+	uint8 i;
+	for(i=0;(i < g_count) && (g_index[i].slot != slot);i++);
+	if(i == g_count)
+	{
+		return;
+	}
+	g_count--;
+	for(;i<g_count;i++)
+	{
+		g_index[i]=g_index[i+1u];
+	}
+}
+
+/*Description: This function writes a record or the header in one page write and waits for
+ *its write cycle*/
+static uint8 CRED_write(uint16 address, const uint8 * data, uint8 size)
+{
+	uint8 status=EEPROM_writeBlock(address,data,size);
+	_delay_ms(CRED_WRITE_TIME_MS);
+	return status;
+}
+
+/*Description: This function locks the table: the index is emptied and no slot is left*/
+static void CRED_lock(void)
+{
+	g_count=0;
+	g_free=CRED_CAPACITY;
+	g_locked=TRUE;
+}
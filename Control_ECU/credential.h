@@ -0,0 +1,187 @@
+/*******************************************************************************************
+ * [FILE NAME]:		credential.h
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This header file contains static configurations, data types and function
+ * 					prototypes of the user credential table: fixed-size records in the 24C16
+ * 					EEPROM, each a user ID, flags and the digest of the user's PIN salted by
+ * 					the salt of the door, kept in the header page at the end of the EEPROM.
+ * 					Records are 8 bytes, 2 to a page, so each one is written by a single page
+ * 					write.
+ * 					A PIN is looked up by its digest in a RAM index of the users sorted by the
+ * 					first 2 bytes of their digest (3 bytes of RAM a user): a binary search of
+ * 					a fixed number of steps for the capacity finds the candidate and only its
+ * 					record is read to compare the whole digest, so a check takes the same time
+ * 					whatever the number of users
+ *******************************************************************************************/
+
+#ifndef CREDENTIAL_H_
+#define CREDENTIAL_H_
+
+/******************************************************************
+ * 				Common Header Files Inclusion					  *
+ ******************************************************************/
+#include "micro_config.h"
+#include "std_types.h"
+#include "common_macros.h"
+#include "external_eeprom.h"
+#include "blake2s.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+/*Characters of a PIN and bytes of its digest kept in a record*/
+#define CRED_PIN_SIZE			5u
+#define CRED_DIGEST_SIZE		5u
+/*Records from the start of the EEPROM, the last page is kept for the table header*/
+#define CRED_TABLE_ADDR			0x0000u
+#define CRED_RECORD_SIZE		8u
+#define CRED_HEADER_ADDR		(2048u-EEPROM_PAGE_SIZE)
+#define CRED_SLOTS				(CRED_HEADER_ADDR/CRED_RECORD_SIZE)
+/*Bytes of the salt and of the entropy pool it's drawn from*/
+#define CRED_SALT_SIZE			BLAKE2S_SALT_SIZE
+#define CRED_POOL_SIZE			16u
+/*Number of digests computed on a benchmark request*/
+#define CRED_BENCH_RUNS			16u
+/*Macro to define the number of users, each takes 3 bytes of RAM in the index. It's capped
+ *by the 1 KB of SRAM of ATmega16 (see the ramcheck target of Host/Makefile), far below the
+ *CRED_SLOTS (254) records the EEPROM holds*/
+#ifndef CRED_CAPACITY
+#define CRED_CAPACITY			32u
+#endif
+#define CRED_MAX_CAPACITY		64u
+#if(CRED_CAPACITY > CRED_MAX_CAPACITY)
+#error "Credential table capacity is more than the index RAM allows"
+#endif
+/*Largest power of 2 not above the capacity, a binary search takes log2 of it plus 1 steps*/
+#define CRED_SEARCH_SPAN		((CRED_CAPACITY >= 128u) ? 128u : (CRED_CAPACITY >= 64u) ? 64u : \
+								 (CRED_CAPACITY >= 32u) ? 32u : (CRED_CAPACITY >= 16u) ? 16u : \
+								 (CRED_CAPACITY >= 8u) ? 8u : (CRED_CAPACITY >= 4u) ? 4u : \
+								 (CRED_CAPACITY >= 2u) ? 2u : 1u)
+/*Record flags: the user may unlock, the user may add users*/
+#define CRED_ACTIVE				(1u<<0)
+#define CRED_ADMIN				(1u<<1)
+/*Slot of no user*/
+#define CRED_NONE				0xFFu
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[Structure Name]		 : CRED_RecordType
+ *[Structure Description]: This structure contains a record of the table as stored: user ID
+ * 						   (slot + 1, 0xFF in an erased slot), flags, PIN digest and check
+ * 						   byte (one's complement of the sum of the other bytes)*/
+typedef struct{
+	uint8 id;
+	uint8 flags;
+	uint8 digest[CRED_DIGEST_SIZE];
+	uint8 check;
+}CRED_RecordType;
+
+/*[Structure Name]		 : CRED_HeaderType
+ *[Structure Description]: This structure contains the table header as stored: salt of the
+ * 						   door and check byte (one's complement of the sum of the salt)*/
+typedef struct{
+	uint8 salt[CRED_SALT_SIZE];
+	uint8 check;
+}CRED_HeaderType;
+
+/*[ENUM Name]		: CRED_Status
+ *[ENUM Description]: This enum contains the results of adding a user or changing a PIN*/
+typedef enum{
+	CRED_OK,CRED_FULL,CRED_DUPLICATE,CRED_ERROR
+}CRED_Status;
+
+/******************************************************************
+ * 				    Public Functions Prototypes					  *
+ ******************************************************************/
+/*******************************************************************************
+ * [Function Name]	: CRED_init
+ * [Description]	: This function reads the table header and records and builds the
+ * 					  index, reading stops at the first erased slot. A record with a wrong
+ * 					  check byte (torn by a power loss while it was written) isn't indexed.
+ * 					  A failed read or records without a valid header lock the table (see
+ * 					  CRED_isLocked). The EEPROM shall be initialised
+ * [Arguments]		: void
+ * [Returns]		: void
+ *******************************************************************************/
+void CRED_init(void);
+
+/*******************************************************************************
+ * [Function Name]	: CRED_stir
+ * [Description]	: This function mixes a sample in the entropy pool the salt is drawn
+ * 					  from when the first user is added, such as a timer count when a key
+ * 					  arrives
+ * [Arguments]		: uint8 sample
+ * [Returns]		: void
+ *******************************************************************************/
+void CRED_stir(uint8 sample);
+
+/*******************************************************************************
+ * [Function Name]	: CRED_getCount
+ * [Description]	: This function returns the number of users in the index
+ * [Arguments]		: void
+ * [Returns]		: uint8
+ *******************************************************************************/
+uint8 CRED_getCount(void);
+
+/*******************************************************************************
+ * [Function Name]	: CRED_isFull
+ * [Description]	: This function returns TRUE if no user can be added
+ * [Arguments]		: void
+ * [Returns]		: uint8
+ *******************************************************************************/
+uint8 CRED_isFull(void);
+
+/*******************************************************************************
+ * [Function Name]	: CRED_isLocked
+ * [Description]	: This function returns TRUE if the table is locked: it couldn't be
+ * 					  read at reset, or it has records but its header isn't valid. A locked
+ * 					  table has no user and none can be added, so the door stays shut till
+ * 					  the EEPROM is serviced instead of taking a new first password
+ * [Arguments]		: void
+ * [Returns]		: uint8
+ *******************************************************************************/
+uint8 CRED_isLocked(void);
+
+/*******************************************************************************
+ * [Function Name]	: CRED_find
+ * [Description]	: This function looks a PIN up in the index and reads the record of
+ * 					  the candidate to compare the whole digest
+ * [Arguments]		: const uint8 * pin: CRED_PIN_SIZE characters
+ * 					  CRED_RecordType * record: filled with the record of the user found
+ * [Returns]		: uint8: slot of the user, CRED_NONE if no user has this PIN
+ *******************************************************************************/
+uint8 CRED_find(const uint8 * pin, CRED_RecordType * record);
+
+/*******************************************************************************
+ * [Function Name]	: CRED_add
+ * [Description]	: This function adds a user in the first free slot, the PIN shall not
+ * 					  be one of another user as users are told by their PIN. A salt is
+ * 					  drawn from the entropy pool and written in the header first if there
+ * 					  is no valid header
+ * [Arguments]		: const uint8 * pin: CRED_PIN_SIZE characters
+ * 					  uint8 flags: CRED_ACTIVE, CRED_ADMIN
+ * [Returns]		: CRED_Status
+ *******************************************************************************/
+CRED_Status CRED_add(const uint8 * pin, uint8 flags);
+
+/*******************************************************************************
+ * [Function Name]	: CRED_changePin
+ * [Description]	: This function replaces the PIN of a user, its record is rewritten
+ * [Arguments]		: uint8 slot: slot of the user (from CRED_find)
+ * 					  const uint8 * pin: CRED_PIN_SIZE characters
+ * [Returns]		: CRED_Status
+ *******************************************************************************/
+CRED_Status CRED_changePin(uint8 slot, const uint8 * pin);
+
+/*******************************************************************************
+ * [Function Name]	: CRED_benchmark
+ * [Description]	: This function computes CRED_BENCH_RUNS digests of a PIN, as a check
+ * 					  does, each one counted by PROBE_HASH probe
+ * [Arguments]		: void
+ * [Returns]		: void
+ *******************************************************************************/
+void CRED_benchmark(void);
+
+#endif /* CREDENTIAL_H_ */
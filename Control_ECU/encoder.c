@@ -0,0 +1,98 @@
+/*******************************************************************************************
+ * [FILE NAME]:		encoder.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains implementation of the quadrature encoder driver on
+ * 					INT2 in AVR ATMEGA-16 Micro-controller
+ *******************************************************************************************/
+
+#include "encoder.h"
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+static volatile sint16 g_position=0;
+
+/******************************************************************
+ * 				  Private Functions Prototypes					  *
+ ******************************************************************/
+static void ENCODER_senseNextEdge(uint8 a);
+
+/******************************************************************
+ * 				  Interrupt Service Routines					  *
+ ******************************************************************/
+/*ISR of INT2, on each edge of channel A: the position counts up if A differs from B (A
+ *leads) and down otherwise, then INT2 is set for the opposite edge*/
+ISR(INT2_vect)
+{
+	uint8 a=IS_BIT_SET(ENCODER_A_IN,ENCODER_A_PIN) ? 1u : 0u;
+	uint8 b=IS_BIT_SET(ENCODER_B_IN,ENCODER_B_PIN) ? 1u : 0u;
+	if(a != b)
+	{
+		g_position++;
+	}
+	else
+	{
+		g_position--;
+	}
+	ENCODER_senseNextEdge(a);
+}
+
+/******************************************************************
+ * 				  Public Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function initialises the encoder:
+ * 1. Sets encoder pins as inputs with pull-ups
+ * 2. Clears the position
+ * 3. Selects the edge of A leaving its current level and enables INT2*/
+void ENCODER_init(void)
+{
+	CLEAR_BIT(ENCODER_A_DIR,ENCODER_A_PIN);
+	CLEAR_BIT(ENCODER_B_DIR,ENCODER_B_PIN);
+	SET_BIT(ENCODER_A_PORT,ENCODER_A_PIN);
+	SET_BIT(ENCODER_B_PORT,ENCODER_B_PIN);
+	g_position=0;
+	ENCODER_senseNextEdge(IS_BIT_SET(ENCODER_A_IN,ENCODER_A_PIN) ? 1u : 0u);
+}
+
+/*Description: This function returns the position, read with interrupts disabled as it
+ *takes two instructions*/
+sint16 ENCODER_getPosition(void)
+{
+	sint16 position;
+	uint8 sreg=SREG;
+	cli();
+	position=g_position;
+	SREG=sreg;
+	return position;
+}
+
+/*Description: This function sets the position*/
+void ENCODER_setPosition(sint16 position)
+{
+	uint8 sreg=SREG;
+	cli();
+	g_position=position;
+	SREG=sreg;
+}
+
+/******************************************************************
+ * 				  Private Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function selects the falling edge of A if it's high and the rising edge
+ *if it's low. INT2 is disabled meanwhile as changing ISC2 may set its flag, which is
+ *cleared before INT2 is enabled again*/
+static void ENCODER_senseNextEdge(uint8 a)
+{
+	CLEAR_BIT(GICR,INT2);
+	if(a)
+	{
+		CLEAR_BIT(MCUCSR,ISC2);
+	}
+	else
+	{
+		SET_BIT(MCUCSR,ISC2);
+	}
+	GIFR=(1<<INTF2);
+	SET_BIT(GICR,INT2);
+}
@@ -0,0 +1,66 @@
+/*******************************************************************************************
+ * [FILE NAME]:		encoder.h
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This header file contains static configurations and function prototypes
+ * 					of the bolt quadrature encoder driver: channel A on INT2 (PB2) and channel
+ * 					B on ENCODER_B_PIN. ATMEGA-16 has neither pin change interrupts nor a free
+ * 					input capture (ICP1 is on TIMER1 of the timelines), so both edges of A are
+ * 					counted by INT2, its sense being toggled after each edge (x2 decoding):
+ * 					A differing from B after an edge is a count up (bolt opening), A equal to
+ * 					B is a count down. Each edge takes one interrupt, A shall stay at least
+ * 					the interrupt latency between edges (a few tens of usec)
+ *******************************************************************************************/
+
+#ifndef ENCODER_H_
+#define ENCODER_H_
+
+/******************************************************************
+ * 				Common Header Files Inclusion					  *
+ ******************************************************************/
+#include "micro_config.h"
+#include "std_types.h"
+#include "common_macros.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+/*Static Configuration for encoder pins, ENCODER_A_PIN is INT2*/
+#define ENCODER_A_DIR			DDRB
+#define ENCODER_A_PORT			PORTB
+#define ENCODER_A_IN			PINB
+#define ENCODER_A_PIN			PB2
+#define ENCODER_B_DIR			DDRD
+#define ENCODER_B_PORT			PORTD
+#define ENCODER_B_IN			PIND
+#define ENCODER_B_PIN			PD6
+
+/******************************************************************
+ * 				    Public Functions Prototypes					  *
+ ******************************************************************/
+/*******************************************************************************
+ * [Function Name]	: ENCODER_init
+ * [Description]	: This function sets encoder pins as inputs with pull-ups, clears the
+ * 					  position and enables INT2 on the next edge of channel A
+ * [Arguments]		: void
+ * [Returns]		: void
+ *******************************************************************************/
+void ENCODER_init(void);
+
+/*******************************************************************************
+ * [Function Name]	: ENCODER_getPosition
+ * [Description]	: This function returns the position counted by INT2 interrupt
+ * [Arguments]		: void
+ * [Returns]		: sint16: position in counts (x2 decoding), increasing while opening
+ *******************************************************************************/
+sint16 ENCODER_getPosition(void);
+
+/*******************************************************************************
+ * [Function Name]	: ENCODER_setPosition
+ * [Description]	: This function sets the position, to zero it on a reference switch
+ * [Arguments]		: sint16 position: new position in counts
+ * [Returns]		: void
+ *******************************************************************************/
+void ENCODER_setPosition(sint16 position);
+
+#endif /* ENCODER_H_ */
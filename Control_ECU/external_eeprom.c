@@ -8,6 +8,7 @@
 
 #include "external_eeprom.h"
 #include "i2c.h"
+#include "probe.h"
 
 /******************************************************************
  * 				  Public Functions Definitions					  *
@@ -29,6 +30,8 @@ uint8 EEPROM_writeByte(uint16 u16addr, const uint8 u8data)
 /*******************************************************************
  * STA | Slave Add | W | ACK | Memory Loc | ACK | Data | ACK | STO *
  *******************************************************************/
+	/*Time of a call is counted only if it succeeds*/
+	PROBE_START(PROBE_EEPROM);
 	/*Send start bit to begin frame*/
 	TWI_start();
 	/*Check if status register doesn't hold the corresponding number for successful transmission
@@ -55,17 +58,56 @@ uint8 EEPROM_writeByte(uint16 u16addr, const uint8 u8data)
 		return EEPROM_ERROR;
 	/*Send stop bit*/
 	TWI_stop();
+	PROBE_STOP(PROBE_EEPROM);
 	/*Return success indicating successful transmission of whole frame*/
 	return EEPROM_SUCCESS;
 }
 
 
+uint8 EEPROM_writeBlock(uint16 u16addr, const uint8 * data, uint8 size)
+{
+/**********************************************************************************
+ * STA | Slave Add | W | ACK | Memory Loc | ACK | Data | ACK ... Data | ACK | STO *
+ *********************************************************************************/
+	uint8 i;
+	/*Page write of size bytes in a single frame, all written in one write cycle after STOP.
+	 *The address rolls over inside the page, so the bytes shall not cross it. Time of a
+	 *call is counted only if it succeeds*/
+	PROBE_START(PROBE_EEPROM);
+	/*Send start bit to begin frame*/
+	TWI_start();
+	if(TWI_getStatus()!=TWI_START)
+		return EEPROM_ERROR;
+	/*Write the slave address of EEPROM (1010 + 3 bits from memory location (A10 A9 A8) + Write*/
+	TWI_write(SLAVE_ADDRESS_W(u16addr));
+	if(TWI_getStatus()!=TWI_MT_SLA_W_ACK)
+		return EEPROM_ERROR;
+	/*Write the rest of memory location address from A7 --> A0*/
+	TWI_write((uint8)(u16addr));
+	if(TWI_getStatus()!=TWI_MT_DATA_ACK)
+		return EEPROM_ERROR;
+	/*Write data bytes, the EEPROM latches them in its page buffer*/
+	for(i=0;i<size;i++)
+	{
+		TWI_write(data[i]);
+		if(TWI_getStatus()!=TWI_MT_DATA_ACK)
+			return EEPROM_ERROR;
+	}
+	/*Send stop bit which starts the write cycle*/
+	TWI_stop();
+	PROBE_STOP(PROBE_EEPROM);
+	/*Return success indicating successful transmission of whole frame*/
+	return EEPROM_SUCCESS;
+}
+
 uint8 EEPROM_readByte(uint16 u16addr, uint8 * u8data)
 {
 /************************************************************************************************
  * STA | Slave Add | W | ACK | Memory Loc | ACK | Sr | Slave Add. | R | ACK | Data | NACK | STO *
  ************************************************************************************************/
 
+	/*Time of a call is counted only if it succeeds*/
+	PROBE_START(PROBE_EEPROM);
 	/*Send start bit to begin frame*/
 	TWI_start();
 	/*Check if status register doesn't hold the corresponding number for successful transmission
@@ -110,6 +152,62 @@ uint8 EEPROM_readByte(uint16 u16addr, uint8 * u8data)
 
 	/*Send stop bit*/
 	TWI_stop();
+	PROBE_STOP(PROBE_EEPROM);
+
+	/*Return success indicating successful transmission of whole frame*/
+	return EEPROM_SUCCESS;
+}
+
+
+uint8 EEPROM_readBlock(uint16 u16addr, uint8 * data, uint8 size)
+{
+/***************************************************************************************************************
+ * STA | Slave Add | W | ACK | Memory Loc | ACK | Sr | Slave Add. | R | ACK | Data | ACK ... Data | NACK | STO *
+ **************************************************************************************************************/
+	uint8 i;
+	/*Sequential read of size bytes (1 at least) in a single frame, the address increments
+	 *after each byte. Time of a call is counted only if it succeeds*/
+	PROBE_START(PROBE_EEPROM);
+	/*Send start bit to begin frame*/
+	TWI_start();
+	if(TWI_getStatus()!=TWI_START)
+		return EEPROM_ERROR;
+
+	/*Write the slave address of EEPROM (1010 + 3 bits from memory location (A10 A9 A8) + Write*/
+	TWI_write(SLAVE_ADDRESS_W(u16addr));
+	if(TWI_getStatus()!=TWI_MT_SLA_W_ACK)
+		return EEPROM_ERROR;
+
+	/*Write the rest of memory location address from A7 --> A0*/
+	TWI_write((uint8)(u16addr));
+	if(TWI_getStatus()!=TWI_MT_DATA_ACK)
+		return EEPROM_ERROR;
+
+	/*Send repeated start bit to change write operation to read from same slave*/
+	TWI_start();
+	if(TWI_getStatus()!=TWI_REP_START)
+		return EEPROM_ERROR;
+
+	/*Write the slave address of EEPROM (1010 + 3 bits from memory location (A10 A9 A8) + Read*/
+	TWI_write(SLAVE_ADDRESS_R(u16addr));
+	if(TWI_getStatus()!=TWI_MT_SLA_R_ACK)
+		return EEPROM_ERROR;
+
+	/*Read all bytes but the last with ACK so the EEPROM sends the next one*/
+	for(i=0;i<(uint8)(size-1u);i++)
+	{
+		data[i]=TWI_readWithACK();
+		if(TWI_getStatus()!=TWI_MR_DATA_ACK)
+			return EEPROM_ERROR;
+	}
+	/*Read the last byte with NACK to end the read*/
+	data[i]=TWI_readWithNACK();
+	if(TWI_getStatus()!=TWI_MR_DATA_NACK)
+		return EEPROM_ERROR;
+
+	/*Send stop bit*/
+	TWI_stop();
+	PROBE_STOP(PROBE_EEPROM);
 
 	/*Return success indicating successful transmission of whole frame*/
 	return EEPROM_SUCCESS;
@@ -21,6 +21,9 @@
 #define SLAVE_ADDRESS_W(ADD)	(uint8)(((ADD&0x700)>>7)|0xA0)
 #define SLAVE_ADDRESS_R(ADD)	(uint8)((((ADD&0x700)>>7)|0xA0)|0x01)
 
+/*Size of a page of 24C16, a block write shall not cross a page*/
+#define EEPROM_PAGE_SIZE	16u
+
 #define EEPROM_SUCCESS	1u
 #define EEPROM_ERROR	0u
 
@@ -29,6 +32,8 @@
  ******************************************************************/
 void EEPROM_init(void);
 uint8 EEPROM_writeByte(uint16 u16addr, const uint8 u8data);
+uint8 EEPROM_writeBlock(uint16 u16addr, const uint8 * data, uint8 size);
 uint8 EEPROM_readByte(uint16 u16addr, uint8 * u8data);
+uint8 EEPROM_readBlock(uint16 u16addr, uint8 * data, uint8 size);
 
 #endif /* EXTERNAL_EEPROM_H_ */
@@ -7,6 +7,24 @@
  *******************************************************************************************/
 
 #include "i2c.h"
+#include "trace.h"
+#include "idle.h"
+
+/******************************************************************
+ * 				  Private Functions Prototypes					  *
+ ******************************************************************/
+static void TWI_wait(void);
+
+/******************************************************************
+ * 				  Interrupt Service Routines					  *
+ ******************************************************************/
+/*ISR of TWI, enabled with each operation the CPU sleeps through: it wakes the CPU and is
+ *disabled again, TWINT is written zero so it stays set and the next operation isn't started*/
+ISR(TWI_vect)
+{
+	IDLE_WAKE();
+	TWCR&=~((1<<TWIE)|(1<<TWINT));
+}
 
 
 /******************************************************************
@@ -75,9 +93,10 @@ void TWI_start(void)
 	/*1. Clear TWINT flag by setting it before sending
 	 *2. Keep enabling TWI module i.e. TWEN=1
 	 *3. Send start bit i.e. TWSTA=1*/
-	TWCR=(1<<TWINT) | (1<<TWEN) | (1<<TWSTA);
-	/*Busy wait until TWINT flag is set which means start bit is sent successfully*/
-	while(IS_BIT_CLEAR(TWCR,TWINT));
+	TWCR=(1<<TWINT) | (1<<TWEN) | (1<<TWSTA) | (1<<TWIE);
+	/*Sleep until TWINT flag is set which means start bit is sent successfully*/
+	TWI_wait();
+	TRACE_BEGIN(TRACE_TWI,TWI_getStatus());
 }
 
 /******************************************************************************************
@@ -92,6 +111,7 @@ void TWI_stop(void)
 	 *2. Keep enabling TWI module i.e. TWEN=1
 	 *3. Send stop bit i.e. TWSTO=1*/
 	TWCR=(1<<TWINT) | (1<<TWEN) | (1<<TWSTO);
+	TRACE_END(TRACE_TWI,0);
 }
 
 /******************************************************************************************
@@ -109,10 +129,10 @@ void TWI_write(const uint8 data)
 
 	/*1. Clear TWINT flag by setting it before sending
 	 *2. Keep enabling TWI module i.e. TWEN=1*/
-	TWCR=(1<<TWINT) | (1<<TWEN);
+	TWCR=(1<<TWINT) | (1<<TWEN) | (1<<TWIE);
 
-	/*Busy wait until TWINT flag is set which means data byte is sent successfully*/
-	while(IS_BIT_CLEAR(TWCR,TWINT));
+	/*Sleep until TWINT flag is set which means data byte is sent successfully*/
+	TWI_wait();
 }
 
 /******************************************************************************************
@@ -128,9 +148,9 @@ uint8 TWI_readWithACK(void)
 	/*1. Clear TWINT flag by setting it before sending
 	 *2. Keep enabling TWI module i.e. TWEN=1
 	 *3. Sends ACK bit i.e. TWEA=1*/
-	TWCR=(1<<TWINT) | (1<<TWEN) | (1<<TWEA);
-	/*Busy wait until TWINT flag is set which means data byte is received successfully*/
-	while(IS_BIT_CLEAR(TWCR,TWINT));
+	TWCR=(1<<TWINT) | (1<<TWEN) | (1<<TWEA) | (1<<TWIE);
+	/*Sleep until TWINT flag is set which means data byte is received successfully*/
+	TWI_wait();
 	return TWDR;
 }
 
@@ -147,9 +167,9 @@ uint8 TWI_readWithNACK(void)
 	/*1. Clear TWINT flag by setting it before sending
 	 *2. Keep enabling TWI module i.e. TWEN=1
 	 *3. Doesn't send ACK bit i.e. TWEA=0*/
-	TWCR=(1<<TWINT) | (1<<TWEN);
-	/*Busy wait until TWINT flag is set which means data byte is received successfully*/
-	while(IS_BIT_CLEAR(TWCR,TWINT));
+	TWCR=(1<<TWINT) | (1<<TWEN) | (1<<TWIE);
+	/*Sleep until TWINT flag is set which means data byte is received successfully*/
+	TWI_wait();
 	return TWDR;
 }
 
@@ -166,3 +186,20 @@ uint8 TWI_getStatus(void)
 	status=TWSR&0xF8;
 	return status;
 }
+
+/******************************************************************
+ * 				  Private Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function sleeps till TWINT flag is set, TWI interrupt enabled with the
+ *operation wakes the CPU*/
+static void TWI_wait(void)
+{
+	uint8 sreg=SREG;
+	cli();
+	while(IS_BIT_CLEAR(TWCR,TWINT))
+	{
+		IDLE_sleep();
+		cli();
+	}
+	SREG=sreg;
+}
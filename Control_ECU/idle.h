@@ -0,0 +1,84 @@
+/*******************************************************************************************
+ * [FILE NAME]:		idle.h
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This header file contains static configurations and function prototypes
+ * 					of the idle manager: code waiting for an event (a link byte, a key, the
+ * 					end of a TWI operation or a timeline notification) puts the CPU in idle
+ * 					sleep instead of busy-waiting, and the interrupt bringing the event (or
+ * 					the next timer deadline) wakes it. The wait arms its wake source and
+ * 					checks its event with interrupts disabled, then calls IDLE_sleep which
+ * 					enables them with the sleep, so an event coming in between isn't missed.
+ * 					The wait restores the interrupt state it was called with when it's done.
+ * 					Idle mode keeps the clocks of timers, USART, SPI and TWI running: deeper
+ * 					modes (power-save, power-down) stop the timers and the USART which time
+ * 					the tick and the keypad scan and receive the link, and ATmega16 has no
+ * 					pin change interrupt to wake on a key, so keys are found by the scan.
+ * 					Sleeps are counted with their duration and wake latency by probes
+ *******************************************************************************************/
+
+#ifndef IDLE_H_
+#define IDLE_H_
+
+/******************************************************************
+ * 				Common Header Files Inclusion					  *
+ ******************************************************************/
+#include "micro_config.h"
+#include "std_types.h"
+#include "common_macros.h"
+#include "probe.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+/*Macro to enable (1) sleeping while waiting or busy-waiting (0) as before, e.g. to compare
+ *the supply current*/
+#ifndef IDLE_ENABLE
+#define IDLE_ENABLE				1
+#endif
+
+/******************************************************************
+ * 						Function-like Macros					  *
+ ******************************************************************/
+/*Macro called first in the interrupts waking waits, it marks the wake for the probes*/
+#if(IDLE_ENABLE && PROBE_ENABLE)
+#define IDLE_WAKE()				IDLE_wake()
+#else
+#define IDLE_WAKE()				((void)0)
+#endif
+
+/******************************************************************
+ * 				    Public Functions Prototypes					  *
+ ******************************************************************/
+/*******************************************************************************
+ * [Function Name]	: IDLE_init
+ * [Description]	: This function selects idle mode as sleep mode
+ * [Arguments]		: void
+ * [Returns]		: void
+ *******************************************************************************/
+void IDLE_init(void);
+
+/*******************************************************************************
+ * [Function Name]	: IDLE_sleep
+ * [Description]	: This function puts the CPU in idle sleep till an interrupt, it's
+ * 					  called with interrupts disabled after the caller armed its wake
+ * 					  source and found no event, and returns with interrupts enabled. An
+ * 					  interrupt pending since the check wakes the CPU at once. With
+ * 					  IDLE_ENABLE 0 it only enables interrupts
+ * [Arguments]		: void
+ * [Returns]		: void
+ *******************************************************************************/
+void IDLE_sleep(void);
+
+#if(IDLE_ENABLE && PROBE_ENABLE)
+/*******************************************************************************
+ * [Function Name]	: IDLE_wake
+ * [Description]	: This function starts the wake latency probe if the CPU sleeps,
+ * 					  it's called through IDLE_WAKE from interrupts
+ * [Arguments]		: void
+ * [Returns]		: void
+ *******************************************************************************/
+void IDLE_wake(void);
+#endif
+
+#endif /* IDLE_H_ */
@@ -0,0 +1,470 @@
+/*******************************************************************************************
+ * [FILE NAME]:		motor.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains implementation of the DC motor driver with PWM
+ * 					speed profiles on TIMER0 in AVR ATMEGA-16 Micro-controller
+ *******************************************************************************************/
+
+#include "motor.h"
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+/*Speed profile: peak duty, ramps length in PWM periods and stop mode*/
+static uint8 g_peak=0xFF;
+static uint16 g_upPeriods=0;
+static uint16 g_downPeriods=0;
+static MOTOR_StopMode g_stopMode=MOTOR_COAST;
+/*Stall detector: level of filtered current, samples it shall be held and the callback*/
+static uint16 g_stallCurrent=0;
+static uint16 g_stallSamples=0;
+static void (* volatile g_stallCallBackPtr)(void)=NULL_PTR;
+/*Position control: peak speed (0 without encoder), acceleration, gains, hold band and the
+ *periods it shall be held, stall time in control periods and the callback*/
+static sint16 g_peakSpeed=0;
+static sint16 g_acceleration=0;
+static sint16 g_kp=0;
+static sint16 g_kff=0;
+static sint16 g_kv=0;
+static sint16 g_ki=0;
+static sint16 g_holdBand=0;
+static uint16 g_settlePeriods=0;
+static uint16 g_stallPeriods=0;
+static void (* volatile g_arrivalCallBackPtr)(void)=NULL_PTR;
+
+/*Configuration structure for ADC module:
+ * 1. Reference voltage = AVCC
+ * 2. Prescalar = 128 --> ADC clock = 62.5 KHz at 8 MHz, a sample every MOTOR_SAMPLE_US*/
+static const ADC_ConfigType g_senseConfig={ADC_AVCC,ADC_F_CPU_128};
+
+/*Direction the bridge is set for and the direction requested*/
+static volatile MOTOR_Direction g_direction=MOTOR_STOP;
+static volatile MOTOR_Direction g_request=MOTOR_STOP;
+/*Current duty and ramp accumulator: the duty changes by one each time the accumulator,
+ *increased by the peak duty each period, passes the ramp length (linear ramp)*/
+static volatile uint8 g_duty=0;
+static uint16 g_accumulator=0;
+/*Filtered current scaled by 2^MOTOR_FILTER_SHIFT, the filter has taken its first sample,
+ *and the samples it has been above the stall level*/
+static uint16 g_current=0;
+static uint8 g_filterPrimed=FALSE;
+static uint16 g_stallCount=0;
+/*Position control running, its target, PWM periods since its last run, position at the
+ *last run, speed reference, integral of speed error and periods held in the band*/
+static volatile uint8 g_closedLoop=FALSE;
+static volatile sint16 g_target=0;
+static uint8 g_loopCount=0;
+static sint16 g_lastPosition=0;
+static sint16 g_reference=0;
+static sint32 g_integral=0;
+static uint16 g_settleCount=0;
+
+/******************************************************************
+ * 				  Private Functions Prototypes					  *
+ ******************************************************************/
+static void MOTOR_setBridge(MOTOR_Direction direction);
+static void MOTOR_setDuty(uint8 duty);
+static void MOTOR_startSensing(void);
+static void MOTOR_senseCurrent(uint16 sample);
+static void MOTOR_controlPosition(void);
+static void MOTOR_drive(sint16 output);
+static void MOTOR_halt(void);
+
+/******************************************************************
+ * 				   Interrupt Service Routines					  *
+ ******************************************************************/
+/*ISR of TIMER0 compare match, once per PWM period while the speed profile runs:
+ * 1. Motor turning in the requested direction ramps up till the peak duty
+ * 2. Motor turning in another direction ramps down till 0
+ * 3. Motor at 0 duty gets the bridge set for the requested direction
+ *The interrupt is disabled when the requested direction runs at its peak (current sensing
+ *starts then, so the inrush of ramps isn't taken for a stall) or is stopped.
+ *Under position control, the loop runs every MOTOR_LOOP_PERIODS periods instead*/
+ISR(TIMER0_COMP_vect)
+{
+	uint8 duty=g_duty;
+	if(g_closedLoop)
+	{
+		g_loopCount++;
+		if(g_loopCount >= MOTOR_LOOP_PERIODS)
+		{
+			g_loopCount=0;
+			MOTOR_controlPosition();
+		}
+		return;
+	}
+	if(g_request == g_direction)
+	{
+		if((g_direction == MOTOR_STOP) || (duty == g_peak))
+		{
+			g_accumulator=0;
+			CLEAR_BIT(TIMSK,OCIE0);
+			if(g_direction != MOTOR_STOP)
+			{
+				MOTOR_startSensing();
+			}
+			return;
+		}
+		g_accumulator+=g_peak;
+		while(((g_upPeriods == 0) || (g_accumulator >= g_upPeriods)) && (duty < g_peak))
+		{
+			g_accumulator-=g_upPeriods;
+			duty++;
+		}
+	}
+	else if(duty != 0)
+	{
+		g_accumulator+=g_peak;
+		while(((g_downPeriods == 0) || (g_accumulator >= g_downPeriods)) && (duty != 0))
+		{
+			g_accumulator-=g_downPeriods;
+			duty--;
+		}
+		if(duty == 0)
+		{
+			g_accumulator=0;
+		}
+	}
+	else
+	{
+		MOTOR_setBridge(g_request);
+		g_direction=g_request;
+	}
+	MOTOR_setDuty(duty);
+}
+
+/******************************************************************
+ * 				  	  Functions Definitions				 		  *
+ ******************************************************************/
+/*Description: This function initialises the motor driver
+ * 1. Sets motor pins as outputs and the motor stopped
+ * 2. Converts ramp times in PWM periods
+ * 3. Sets TIMER0 in fast PWM mode at F_CPU/64 with OC0 disconnected (0 duty)
+ * 4. Converts stall time in current samples and initialises the ADC, sense pin is an input
+ * 5. Takes position control and converts its times in control periods, starts the encoder*/
+void MOTOR_init(const MOTOR_ConfigType * Config_Ptr)
+{
+	SET_BIT(MOTOR_DIR,MOTOR_PIN1);
+	SET_BIT(MOTOR_DIR,MOTOR_PIN2);
+	SET_BIT(MOTOR_DIR,MOTOR_EN);
+	g_peak=Config_Ptr->peakDuty;
+	g_upPeriods=(uint16)(((uint32)Config_Ptr->rampUpMs*1000UL)/MOTOR_PERIOD_US);
+	g_downPeriods=(uint16)(((uint32)Config_Ptr->rampDownMs*1000UL)/MOTOR_PERIOD_US);
+	g_stopMode=Config_Ptr->stopMode;
+	g_stallCurrent=Config_Ptr->stallCurrent;
+	g_stallSamples=(uint16)(((uint32)Config_Ptr->stallMs*1000UL)/MOTOR_SAMPLE_US);
+	g_direction=MOTOR_STOP;
+	g_request=MOTOR_STOP;
+	g_duty=0;
+	g_accumulator=0;
+	OCR0=0;
+	TCCR0=(1<<WGM00)|(1<<WGM01)|(1<<CS01)|(1<<CS00);
+	MOTOR_setBridge(MOTOR_STOP);
+	CLEAR_BIT(MOTOR_SENSE_DIR,MOTOR_SENSE_PIN);
+	ADC_setCallBack(MOTOR_senseCurrent);
+	ADC_init(&g_senseConfig);
+	g_peakSpeed=(sint16)Config_Ptr->loop.peakSpeed;
+	g_acceleration=(sint16)Config_Ptr->loop.acceleration;
+	g_kp=(sint16)Config_Ptr->loop.kp;
+	g_kff=(sint16)Config_Ptr->loop.kff;
+	g_kv=(sint16)Config_Ptr->loop.kv;
+	g_ki=(sint16)Config_Ptr->loop.ki;
+	g_holdBand=(sint16)Config_Ptr->loop.holdBand;
+	g_settlePeriods=(uint16)(((uint32)Config_Ptr->loop.settleMs*1000UL)/MOTOR_LOOP_US);
+	g_stallPeriods=(uint16)(((uint32)Config_Ptr->stallMs*1000UL)/MOTOR_LOOP_US);
+	g_closedLoop=FALSE;
+	if(g_peakSpeed != 0)
+	{
+		ENCODER_init();
+	}
+}
+
+/*Description: This function requests a direction and starts the speed profile, current
+ *sensing stops till the peak is reached again and position control ends: the profile goes
+ *on from the duty the loop left. TIMSK is changed with interrupts disabled as ISRs of
+ *TIMER0 and TIMER2 change it*/
+void MOTOR_rotate(MOTOR_Direction direction)
+{
+	uint8 sreg=SREG;
+	cli();
+	ADC_stop();
+	g_closedLoop=FALSE;
+	g_request=direction;
+	SET_BIT(TIMSK,OCIE0);
+	SREG=sreg;
+}
+
+/*Description: This function sets the target of position control, starting it from rest
+ *(no reference speed nor integral) if it wasn't running*/
+void MOTOR_moveTo(sint16 position)
+{
+	uint8 sreg;
+	if(g_peakSpeed == 0)
+	{
+		return;
+	}
+	sreg=SREG;
+	cli();
+	ADC_stop();
+	if(!g_closedLoop)
+	{
+		g_lastPosition=ENCODER_getPosition();
+		g_reference=0;
+		g_integral=0;
+		g_loopCount=0;
+		g_stallCount=0;
+		g_closedLoop=TRUE;
+	}
+	g_target=position;
+	g_settleCount=0;
+	SET_BIT(TIMSK,OCIE0);
+	SREG=sreg;
+}
+
+/*Description: This function returns TRUE while the motor turns or ramps, or holds a position*/
+uint8 MOTOR_isRunning(void)
+{
+	return ((g_direction != MOTOR_STOP) || (g_request != MOTOR_STOP) || (g_duty != 0) || g_closedLoop) ? TRUE : FALSE;
+}
+
+/*Description: This function sets the function called when the motor stalled*/
+void MOTOR_setStallCallBack(void(*a_ptr)(void))
+{
+	g_stallCallBackPtr=a_ptr;
+}
+
+/*Description: This function sets the function called when the bolt settled at the target*/
+void MOTOR_setArrivalCallBack(void(*a_ptr)(void))
+{
+	g_arrivalCallBackPtr=a_ptr;
+}
+
+/******************************************************************
+ * 				  Private Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function sets the bridge inputs for a direction, a stopped motor is
+ *braked (both inputs and enable high) or left coasting (enable low)*/
+static void MOTOR_setBridge(MOTOR_Direction direction)
+{
+	switch(direction)
+	{
+		case MOTOR_CW:
+			/*Pin1 : 1
+			 *Pin2 : 0 to rotate clockwise, enable is cleared first so a braking
+			 *bridge doesn't drive the motor meanwhile*/
+			CLEAR_BIT(MOTOR_PORT,MOTOR_EN);
+			SET_BIT(MOTOR_PORT,MOTOR_PIN1);
+			CLEAR_BIT(MOTOR_PORT,MOTOR_PIN2);
+			break;
+		case MOTOR_CCW:
+			/*Pin1 : 0
+			 *Pin2 : 1 to rotate anti-clockwise*/
+			CLEAR_BIT(MOTOR_PORT,MOTOR_EN);
+			CLEAR_BIT(MOTOR_PORT,MOTOR_PIN1);
+			SET_BIT(MOTOR_PORT,MOTOR_PIN2);
+			break;
+		default:
+			if(g_stopMode == MOTOR_BRAKE)
+			{
+				SET_BIT(MOTOR_PORT,MOTOR_PIN1);
+				SET_BIT(MOTOR_PORT,MOTOR_PIN2);
+				SET_BIT(MOTOR_PORT,MOTOR_EN);
+			}
+			else
+			{
+				CLEAR_BIT(MOTOR_PORT,MOTOR_PIN1);
+				CLEAR_BIT(MOTOR_PORT,MOTOR_PIN2);
+				CLEAR_BIT(MOTOR_PORT,MOTOR_EN);
+			}
+			break;
+	}
+}
+
+/*Description: This function sets the duty, OC0 drives enable (non-inverting mode) while
+ *the duty isn't 0 and is disconnected at 0 so enable is held by the bridge setting, as
+ *fast PWM would still output a spike each period*/
+static void MOTOR_setDuty(uint8 duty)
+{
+	OCR0=duty;
+	if(duty == 0)
+	{
+		TCCR0&=~((1<<COM01)|(1<<COM00));
+	}
+	else if(g_duty == 0)
+	{
+		TCCR0|=(1<<COM01);
+	}
+	g_duty=duty;
+}
+
+/*Description: This function starts free running samples of motor current with the filter
+ *emptied, nothing is done when stall detection is disabled*/
+static void MOTOR_startSensing(void)
+{
+	if(g_stallCurrent == 0)
+	{
+		return;
+	}
+	g_filterPrimed=FALSE;
+	g_stallCount=0;
+	ADC_startFreeRunning(MOTOR_SENSE_CHANNEL);
+}
+
+/*Description: This function is ADC callback, it filters motor current (the first sample
+ *fills the filter) and once the filtered current was above the stall level for the stall
+ *time, the bolt is at its end stop and the motor is halted*/
+static void MOTOR_senseCurrent(uint16 sample)
+{
+	if(!g_filterPrimed)
+	{
+		g_current=(uint16)(sample<<MOTOR_FILTER_SHIFT);
+		g_filterPrimed=TRUE;
+	}
+	else
+	{
+		g_current=g_current-(g_current>>MOTOR_FILTER_SHIFT)+sample;
+	}
+	if((g_current>>MOTOR_FILTER_SHIFT) < g_stallCurrent)
+	{
+		g_stallCount=0;
+		return;
+	}
+	g_stallCount++;
+	if(g_stallCount < g_stallSamples)
+	{
+		return;
+	}
+	MOTOR_halt();
+}
+
+/*Description: This function runs position control once per control period:
+ * 1. Speed is the position change since the last run
+ * 2. Out of the hold band, the speed reference is the position error times kp, limited to
+ *    the peak speed, and may rise by the acceleration only: the bolt speeds up on a ramp and
+ *    slows down as the error falls. In the band, the reference is 0
+ * 3. Duty is the feed-forward of the reference plus proportional and integral terms of
+ *    speed error (integral limited to the peak duty), its sign is the direction. A bolt in
+ *    the band isn't driven, the bridge stops it (not driving it backwards around the target)
+ * 4. Bolt still in the band for the settle time has arrived, arrival callback is called once
+ * 5. Bolt still at the peak duty for the stall time is stalled, the motor is halted*/
+static void MOTOR_controlPosition(void)
+{
+	sint16 position=ENCODER_getPosition();
+	sint16 error=g_target-position;
+	sint16 speed=(sint16)((position-g_lastPosition)<<MOTOR_SPEED_SHIFT);
+	uint8 inBand=((error <= g_holdBand) && (error >= -g_holdBand)) ? TRUE : FALSE;
+	sint32 reference=0;
+	sint32 output=0;
+	g_lastPosition=position;
+	if(!inBand)
+	{
+		reference=(sint32)error*g_kp;
+		if(reference > g_peakSpeed)
+		{
+			reference=g_peakSpeed;
+		}
+		else if(reference < -g_peakSpeed)
+		{
+			reference=-g_peakSpeed;
+		}
+		if((reference > 0) && (reference > (g_reference+g_acceleration)))
+		{
+			reference=g_reference+g_acceleration;
+		}
+		else if((reference < 0) && (reference < (g_reference-g_acceleration)))
+		{
+			reference=g_reference-g_acceleration;
+		}
+	}
+	g_reference=(sint16)reference;
+	if(inBand)
+	{
+		g_integral=0;
+	}
+	else
+	{
+		g_integral+=(reference-speed)*g_ki;
+		if(g_integral > ((sint32)g_peak<<MOTOR_GAIN_SHIFT))
+		{
+			g_integral=(sint32)g_peak<<MOTOR_GAIN_SHIFT;
+		}
+		else if(g_integral < -((sint32)g_peak<<MOTOR_GAIN_SHIFT))
+		{
+			g_integral=-((sint32)g_peak<<MOTOR_GAIN_SHIFT);
+		}
+		output=((reference*g_kff)+((reference-speed)*g_kv)+g_integral)/(1L<<MOTOR_GAIN_SHIFT);
+		if(output > g_peak)
+		{
+			output=g_peak;
+		}
+		else if(output < -(sint32)g_peak)
+		{
+			output=-(sint32)g_peak;
+		}
+	}
+	if(inBand && (speed == 0))
+	{
+		if(g_settleCount < g_settlePeriods)
+		{
+			g_settleCount++;
+			if((g_settleCount == g_settlePeriods) && (g_arrivalCallBackPtr != NULL_PTR))
+			{
+				(*g_arrivalCallBackPtr)();
+			}
+		}
+	}
+	else
+	{
+		g_settleCount=0;
+	}
+	if((speed == 0) && ((output == g_peak) || (output == -(sint32)g_peak)) && (g_stallPeriods != 0))
+	{
+		g_stallCount++;
+		if(g_stallCount >= g_stallPeriods)
+		{
+			MOTOR_halt();
+			return;
+		}
+	}
+	else
+	{
+		g_stallCount=0;
+	}
+	MOTOR_drive((sint16)output);
+}
+
+/*Description: This function drives the motor with a signed duty of position control, the
+ *bridge is set at 0 duty when the direction changes*/
+static void MOTOR_drive(sint16 output)
+{
+	MOTOR_Direction direction=(output > 0) ? MOTOR_CW : ((output < 0) ? MOTOR_CCW : MOTOR_STOP);
+	if(direction != g_direction)
+	{
+		MOTOR_setDuty(0);
+		MOTOR_setBridge(direction);
+		g_direction=direction;
+		g_request=direction;
+	}
+	MOTOR_setDuty((uint8)((output < 0) ? -output : output));
+}
+
+/*Description: This function halts a stalled motor:
+ * 1. Sampling and position control stop and the motor is stopped without ramp (duty 0,
+ *    bridge braking or coasting)
+ * 2. Stall callback is called*/
+static void MOTOR_halt(void)
+{
+	ADC_stop();
+	CLEAR_BIT(TIMSK,OCIE0);
+	g_closedLoop=FALSE;
+	g_request=MOTOR_STOP;
+	g_direction=MOTOR_STOP;
+	g_accumulator=0;
+	MOTOR_setDuty(0);
+	MOTOR_setBridge(MOTOR_STOP);
+	if(g_stallCallBackPtr != NULL_PTR)
+	{
+		(*g_stallCallBackPtr)();
+	}
+}
@@ -0,0 +1,179 @@
+/*******************************************************************************************
+ * [FILE NAME]:		motor.h
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This header file contains static configurations, data types and function
+ * 					prototypes of the DC motor driver: H-bridge direction on MOTOR_PIN1/2 and
+ * 					enable driven by OC0 (PB3) in fast PWM mode of TIMER0. Speed follows a
+ * 					trapezoidal profile: the duty ramps up to its peak when the motor starts
+ * 					and down to 0 before it stops or reverses, then the motor brakes or coasts.
+ * 					TIMER0 runs at F_CPU/64 as for the clock (clock.h), fast PWM keeps its
+ * 					overflow every 256 ticks so both share it: PWM period is 2.048 msec.
+ * 					Motor current is sampled on MOTOR_SENSE (ADC0) while the motor turns at its
+ * 					peak duty: a current held above the stall level means the bolt reached its
+ * 					end stop, the motor is braked at once and the stall callback is called.
+ * 					A bolt with an encoder (encoder.h) is moved to a position and held there by
+ * 					a fixed-point cascaded loop run every MOTOR_LOOP_PERIODS PWM periods from
+ * 					the same compare interrupt: position error gives a speed reference (limited
+ * 					to the peak speed and raised by the acceleration each period), then speed
+ * 					error gives the signed duty by proportional and integral terms over a
+ * 					feed-forward of the reference. The bolt slows down on the position error
+ * 					as it gets near the target, so no travel time is assumed
+ *******************************************************************************************/
+
+#ifndef MOTOR_H_
+#define MOTOR_H_
+
+/******************************************************************
+ * 				Common Header Files Inclusion					  *
+ ******************************************************************/
+#include "micro_config.h"
+#include "std_types.h"
+#include "common_macros.h"
+#include "adc.h"
+#include "encoder.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+/*Static Configuration for motor pins, MOTOR_EN is OC0*/
+#define MOTOR_DIR				DDRB
+#define MOTOR_PORT				PORTB
+#define MOTOR_PIN1				PB0
+#define MOTOR_PIN2				PB1
+#define MOTOR_EN				PB3
+/*PWM period in micro-seconds: 256 ticks of TIMER0 at F_CPU/64*/
+#define MOTOR_PERIOD_US			(256UL*64UL*1000000UL/F_CPU)
+/*Static Configuration for current sense input: voltage of the bridge sense resistor*/
+#define MOTOR_SENSE_DIR			DDRA
+#define MOTOR_SENSE_PIN			PA0
+#define MOTOR_SENSE_CHANNEL		0u
+/*Current sample period in micro-seconds: ADC free running at F_CPU/128*/
+#define MOTOR_SAMPLE_US			(ADC_CONVERSION_CLOCKS*128UL*1000000UL/F_CPU)
+/*Current filter: exponential moving average over 2^MOTOR_FILTER_SHIFT samples*/
+#define MOTOR_FILTER_SHIFT		3u
+/*Position control period: PWM periods between two runs of the loop (16.384 msec)*/
+#define MOTOR_LOOP_PERIODS		8u
+#define MOTOR_LOOP_US			(MOTOR_LOOP_PERIODS*MOTOR_PERIOD_US)
+/*Fraction bits of speeds (counts per control period) and of loop gains*/
+#define MOTOR_SPEED_SHIFT		4u
+#define MOTOR_GAIN_SHIFT		8u
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[ENUM Name]		 : MOTOR_Direction
+ *[ENUM Description]: This enum contains the directions of the motor*/
+typedef enum{
+	MOTOR_STOP,MOTOR_CW,MOTOR_CCW
+}MOTOR_Direction;
+
+/*[ENUM Name]		 : MOTOR_StopMode
+ *[ENUM Description]: This enum contains what the motor does once its duty reached 0:
+ *					   brake (both bridge inputs high with enable high) or coast (enable low)*/
+typedef enum{
+	MOTOR_COAST,MOTOR_BRAKE
+}MOTOR_StopMode;
+
+/*[Structure Name]		 : MOTOR_LoopConfigType
+ *[Structure Description]: This structure contains the position control of a bolt with an
+ * 						   encoder, speeds are in counts per control period scaled by
+ * 						   2^MOTOR_SPEED_SHIFT and gains are scaled by 2^MOTOR_GAIN_SHIFT:
+ * 						   peak speed (0 for no encoder) and acceleration per period, speed
+ * 						   per count of position error (not scaled), feed-forward duty per
+ * 						   speed, proportional and integral duty per speed error, position
+ * 						   error taken as arrived (counts) and the time it shall be held
+ * 						   still before the arrival callback is called*/
+typedef struct{
+	uint16 peakSpeed;
+	uint16 acceleration;
+	uint16 kp;
+	uint16 kff;
+	uint16 kv;
+	uint16 ki;
+	uint8 holdBand;
+	uint16 settleMs;
+}MOTOR_LoopConfigType;
+
+/*[Structure Name]		 : MOTOR_ConfigType
+ *[Structure Description]: This structure contains the speed profile of the motor: peak
+ * 						   duty (OCR0 value, 255 = full speed), ramp up and ramp down times
+ * 						   between 0 and peak duty (0 for a step) and the stop mode, and the
+ * 						   stall detector: filtered current level in ADC counts (0 for no
+ * 						   detection) and the time it shall be held (also the time the bolt
+ * 						   may stand still at peak duty under position control), and the
+ * 						   position control*/
+typedef struct{
+	uint8 peakDuty;
+	uint16 rampUpMs;
+	uint16 rampDownMs;
+	MOTOR_StopMode stopMode;
+	uint16 stallCurrent;
+	uint16 stallMs;
+	MOTOR_LoopConfigType loop;
+}MOTOR_ConfigType;
+
+/******************************************************************
+ * 				    Public Functions Prototypes					  *
+ ******************************************************************/
+/*******************************************************************************
+ * [Function Name]	: MOTOR_init
+ * [Description]	: This function sets motor pins as outputs, stops the motor and
+ * 					  starts TIMER0 in fast PWM mode (after the clock is started, TIMER0
+ * 					  isn't reset), the ADC for current sensing and the
+ * 					  encoder if any, global interrupts shall be enabled
+ * [Arguments]		: const MOTOR_ConfigType * Config_Ptr: speed profile
+ * [Returns]		: void
+ *******************************************************************************/
+void MOTOR_init(const MOTOR_ConfigType * Config_Ptr);
+
+/*******************************************************************************
+ * [Function Name]	: MOTOR_rotate
+ * [Description]	: This function requests a direction, the speed profile is run by
+ * 					  TIMER0 compare interrupt: a running motor ramps down to 0 first,
+ * 					  then it ramps up in the new direction or stops. Position control
+ * 					  ends, MOTOR_rotate(MOTOR_STOP) releases a held bolt
+ * [Arguments]		: MOTOR_Direction direction: new direction, MOTOR_STOP stops the motor
+ * [Returns]		: void
+ *******************************************************************************/
+void MOTOR_rotate(MOTOR_Direction direction);
+
+/*******************************************************************************
+ * [Function Name]	: MOTOR_moveTo
+ * [Description]	: This function starts position control, or changes its target: the
+ * 					  bolt is moved to the target and held there till MOTOR_rotate is
+ * 					  called. Nothing is done for a bolt without encoder
+ * [Arguments]		: sint16 position: target in encoder counts
+ * [Returns]		: void
+ *******************************************************************************/
+void MOTOR_moveTo(sint16 position);
+
+/*******************************************************************************
+ * [Function Name]	: MOTOR_isRunning
+ * [Description]	: This function returns TRUE while the motor turns or ramps, or holds
+ * 					  a position
+ * [Arguments]		: void
+ * [Returns]		: uint8
+ *******************************************************************************/
+uint8 MOTOR_isRunning(void);
+
+/*******************************************************************************
+ * [Function Name]	: MOTOR_setStallCallBack
+ * [Description]	: This function sets the function called from ADC interrupt (TIMER0
+ * 					  compare interrupt under position control) when the motor stalled
+ * 					  and was braked
+ * [Arguments]		: void(*a_ptr)(void): callback
+ * [Returns]		: void
+ *******************************************************************************/
+void MOTOR_setStallCallBack(void(*a_ptr)(void));
+
+/*******************************************************************************
+ * [Function Name]	: MOTOR_setArrivalCallBack
+ * [Description]	: This function sets the function called from TIMER0 compare interrupt
+ * 					  once the bolt settled at the target of position control
+ * [Arguments]		: void(*a_ptr)(void): callback
+ * [Returns]		: void
+ *******************************************************************************/
+void MOTOR_setArrivalCallBack(void(*a_ptr)(void));
+
+#endif /* MOTOR_H_ */
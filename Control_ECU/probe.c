@@ -0,0 +1,157 @@
+/*******************************************************************************************
+ * [FILE NAME]:		probe.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains implementation of latency probes with log-scale
+ * 					histograms in AVR ATMEGA-16 Micro-controller
+ *******************************************************************************************/
+
+#include "probe.h"
+#include "link.h"
+#include "soft_uart.h"
+
+#if(PROBE_ENABLE)
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+/*Histogram of each probe*/
+static PROBE_HistogramType g_histograms[PROBE_COUNT];
+/*Bit per probe, set while the probe is started*/
+static volatile uint16 g_running;
+
+/******************************************************************
+ * 				  Private Functions Prototypes					  *
+ ******************************************************************/
+static uint16 PROBE_now(PROBE_Id id);
+
+/******************************************************************
+ * 				  Public Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function starts the clock, clears histograms and starts the dump
+ *channel*/
+void PROBE_init(void)
+{
+	uint8 i;
+	uint8 j;
+	for(i=0;i<PROBE_COUNT;i++)
+	{
+		for(j=0;j<PROBE_BUCKETS;j++)
+		{
+			g_histograms[i].count[j]=0;
+		}
+		g_histograms[i].max=0;
+	}
+	g_running=0;
+	CLOCK_init();
+#if(PROBE_CHANNEL == PROBE_SUART)
+	SUART_init();
+#endif
+}
+
+/*Description: This function marks the start of a probe*/
+void PROBE_start(PROBE_Id id)
+{
+	uint8 sreg=SREG;
+	g_histograms[id].start=PROBE_now(id);
+	cli();
+	SET_BIT(g_running,id);
+	SREG=sreg;
+}
+
+/*Description: This function counts the time since start of a probe in the bucket of its
+ *order of magnitude (position of its highest set bit)*/
+void PROBE_stop(PROBE_Id id)
+{
+	PROBE_HistogramType * histogram=&g_histograms[id];
+	uint16 units;
+	uint8 bucket=0;
+	uint8 sreg=SREG;
+	cli();
+	if(IS_BIT_CLEAR(g_running,id))
+	{
+		SREG=sreg;
+		return;
+	}
+	CLEAR_BIT(g_running,id);
+	SREG=sreg;
+	units=PROBE_now(id)-histogram->start;
+	if(units > histogram->max)
+	{
+		histogram->max=units;
+	}
+	while(((units>>1) != 0) && (bucket < (PROBE_BUCKETS-1)))
+	{
+		units>>=1;
+		bucket++;
+	}
+	if(histogram->count[bucket] != 0xFF)
+	{
+		histogram->count[bucket]++;
+	}
+}
+
+/*Description: This function sends a line per probe which counted any duration*/
+void PROBE_dump(void)
+{
+	PROBE_HistogramType * histogram;
+	uint8 id;
+	uint8 last;
+	uint8 i;
+	for(id=0;id<PROBE_COUNT;id++)
+	{
+		histogram=&g_histograms[id];
+		for(last=PROBE_BUCKETS;(last != 0) && (histogram->count[last-1] == 0);last--);
+		if(last == 0)
+		{
+			continue;
+		}
+		PROBE_SEND('P');
+		PROBE_sendHex(id);
+		PROBE_SEND(':');
+		PROBE_sendHex(PROBE_IS_LONG(id) ? (PROBE_TICK_US<<PROBE_LONG_SHIFT) : PROBE_TICK_US);
+		PROBE_SEND(':');
+		PROBE_sendHex(histogram->max);
+		PROBE_SEND(':');
+		for(i=0;i<last;i++)
+		{
+			if(i != 0)
+			{
+				PROBE_SEND(',');
+			}
+			PROBE_sendHex(histogram->count[i]);
+		}
+		PROBE_SEND('\n');
+	}
+}
+
+/*Description: This function sends a number in upper case hex without leading zeros*/
+void PROBE_sendHex(uint32 value)
+{
+	uint8 shift=28;
+	uint8 digit;
+	uint8 started=FALSE;
+	while(1)
+	{
+		digit=(value>>shift)&0x0F;
+		if((digit != 0) || started || (shift == 0))
+		{
+			PROBE_SEND((digit < 10) ? ('0'+digit) : ('A'+digit-10));
+			started=TRUE;
+		}
+		if(shift == 0)
+		{
+			break;
+		}
+		shift-=4;
+	}
+}
+
+/******************************************************************
+ * 				  Private Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function returns the clock in the unit of a probe, on 16 bits*/
+static uint16 PROBE_now(PROBE_Id id)
+{
+	return (uint16)(PROBE_IS_LONG(id) ? (CLOCK_now()>>PROBE_LONG_SHIFT) : CLOCK_now());
+}
+#endif
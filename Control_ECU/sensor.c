@@ -0,0 +1,87 @@
+/*******************************************************************************************
+ * [FILE NAME]:		sensor.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains implementation of the door sensors driver on
+ * 					external interrupts in AVR ATMEGA-16 Micro-controller
+ *******************************************************************************************/
+
+#include "sensor.h"
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+/*State of each switch (TRUE closed) as last reported*/
+static volatile uint8 g_closed[2]={FALSE,FALSE};
+
+static void (* volatile g_callBackPtr)(SENSOR_Id,uint8) = NULL_PTR;
+
+/******************************************************************
+ * 				  Private Functions Prototypes					  *
+ ******************************************************************/
+static void SENSOR_edge(SENSOR_Id id, uint8 pin);
+
+/******************************************************************
+ * 				  Interrupt Service Routines					  *
+ ******************************************************************/
+ISR(INT0_vect)
+{
+	SENSOR_edge(SENSOR_DOOR,SENSOR_DOOR_PIN);
+}
+
+ISR(INT1_vect)
+{
+	SENSOR_edge(SENSOR_BOLT,SENSOR_BOLT_PIN);
+}
+
+/******************************************************************
+ * 				  Public Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function initialises the sensors:
+ * 1. Sets sensor pins as inputs with pull-ups (a closed switch reads low)
+ * 2. Takes the state of both switches
+ * 3. Selects any logical change as sense of INT0/INT1, clears their flags and enables them*/
+void SENSOR_init(void)
+{
+	CLEAR_BIT(SENSOR_DIR,SENSOR_DOOR_PIN);
+	CLEAR_BIT(SENSOR_DIR,SENSOR_BOLT_PIN);
+	SET_BIT(SENSOR_PORT,SENSOR_DOOR_PIN);
+	SET_BIT(SENSOR_PORT,SENSOR_BOLT_PIN);
+	g_closed[SENSOR_DOOR]=IS_BIT_CLEAR(SENSOR_PIN,SENSOR_DOOR_PIN) ? TRUE : FALSE;
+	g_closed[SENSOR_BOLT]=IS_BIT_CLEAR(SENSOR_PIN,SENSOR_BOLT_PIN) ? TRUE : FALSE;
+	MCUCR=(MCUCR & ~((1<<ISC11)|(1<<ISC01))) | (1<<ISC10) | (1<<ISC00);
+	GIFR=(1<<INTF0)|(1<<INTF1);
+	GICR|=(1<<INT0)|(1<<INT1);
+}
+
+/*Description: This function returns TRUE if the switch of a sensor is closed*/
+uint8 SENSOR_isClosed(SENSOR_Id id)
+{
+	return g_closed[id];
+}
+
+/*Description: This function sets call back function for sensors*/
+void SENSOR_setCallBack(void(*a_ptr)(SENSOR_Id,uint8))
+{
+	g_callBackPtr=a_ptr;
+}
+
+/******************************************************************
+ * 				  Private Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function takes the level of a sensor pin after its edge, a change is
+ *reported to the callback. An edge leaving the level unchanged (a glitch shorter than the
+ *interrupt latency) isn't reported*/
+static void SENSOR_edge(SENSOR_Id id, uint8 pin)
+{
+	uint8 closed=IS_BIT_CLEAR(SENSOR_PIN,pin) ? TRUE : FALSE;
+	if(closed == g_closed[id])
+	{
+		return;
+	}
+	g_closed[id]=closed;
+	if(g_callBackPtr != NULL_PTR)
+	{
+		(*g_callBackPtr)(id,closed);
+	}
+}
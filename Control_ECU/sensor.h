@@ -0,0 +1,74 @@
+/*******************************************************************************************
+ * [FILE NAME]:		sensor.h
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This header file contains static configurations, data types and function
+ * 					prototypes of the door sensors driver: the door contact on INT0 (PD2) and
+ * 					the bolt position switch on INT1 (PD3), both switches to ground read with
+ * 					the internal pull-ups. Contacts are debounced in hardware by an RC filter
+ * 					on each input (10 KOhm/100 nF, 1 msec) ahead of the Schmitt trigger of the
+ * 					pin, so each change gives a single clean edge and the interrupt reports
+ * 					it at once, no timer is needed (all three timers are used)
+ *******************************************************************************************/
+
+#ifndef SENSOR_H_
+#define SENSOR_H_
+
+/******************************************************************
+ * 				Common Header Files Inclusion					  *
+ ******************************************************************/
+#include "micro_config.h"
+#include "std_types.h"
+#include "common_macros.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+/*Static Configuration for sensor pins, SENSOR_DOOR_PIN is INT0 and SENSOR_BOLT_PIN is INT1*/
+#define SENSOR_DIR				DDRD
+#define SENSOR_PORT				PORTD
+#define SENSOR_PIN				PIND
+#define SENSOR_DOOR_PIN			PD2
+#define SENSOR_BOLT_PIN			PD3
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[ENUM Name]		 : SENSOR_Id
+ *[ENUM Description]: This enum contains the sensors: door contact is closed while the door
+ *					   is closed, bolt switch is closed while the bolt is thrown (locked)*/
+typedef enum{
+	SENSOR_DOOR,SENSOR_BOLT
+}SENSOR_Id;
+
+/******************************************************************
+ * 				    Public Functions Prototypes					  *
+ ******************************************************************/
+/*******************************************************************************
+ * [Function Name]	: SENSOR_init
+ * [Description]	: This function sets sensor pins as inputs with pull-ups, takes their
+ * 					  state and enables INT0/INT1 on any logical change
+ * [Arguments]		: void
+ * [Returns]		: void
+ *******************************************************************************/
+void SENSOR_init(void);
+
+/*******************************************************************************
+ * [Function Name]	: SENSOR_isClosed
+ * [Description]	: This function returns the state of a sensor switch as last reported
+ * [Arguments]		: SENSOR_Id id: sensor
+ * [Returns]		: uint8: TRUE if its switch is closed
+ *******************************************************************************/
+uint8 SENSOR_isClosed(SENSOR_Id id);
+
+/*******************************************************************************
+ * [Function Name]	: SENSOR_setCallBack
+ * [Description]	: This function sets the function called from INT0/INT1 interrupt
+ * 					  each time a sensor switch changes
+ * [Arguments]		: void(*a_ptr)(SENSOR_Id,uint8): callback, given the sensor and TRUE
+ * 					  if its switch closed
+ * [Returns]		: void
+ *******************************************************************************/
+void SENSOR_setCallBack(void(*a_ptr)(SENSOR_Id,uint8));
+
+#endif /* SENSOR_H_ */
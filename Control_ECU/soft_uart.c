@@ -0,0 +1,176 @@
+/*******************************************************************************************
+ * [FILE NAME]:		soft_uart.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains implementation of the transmit-only software UART
+ * 					driven by TIMER2 in AVR ATMEGA-16 Micro-controller
+ *******************************************************************************************/
+
+#include "soft_uart.h"
+#include "trace.h"
+
+/*The software UART is built only as the dump channel of probes and trace, other builds leave
+ *its buffer and interrupt out*/
+#if((PROBE_ENABLE || TRACE_ENABLE) && (PROBE_CHANNEL == PROBE_SUART))
+
+/*Value of the bit counter when no frame is being sent*/
+#define SUART_IDLE				0xFF
+/*TIMER2 in CTC mode with OC2 set on compare match, and its F_CPU/8 clock select*/
+#define SUART_TIMER_MODE		((1<<WGM21) | (1<<COM21) | (1<<COM20))
+#define SUART_TIMER_CLOCK		(1<<CS21)
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+/*Circular buffer of bytes waiting to be sent, filled by main code and emptied by the ISR*/
+static volatile uint8 g_buffer[SUART_BUFFER_SIZE];
+static volatile uint8 g_head=0;
+static volatile uint8 g_tail=0;
+
+/*Bit of the frame sent at the next compare match: 0 start bit, 1-8 data bits, 9 stop bit*/
+static volatile uint8 g_bit=SUART_IDLE;
+static uint8 g_shift;
+
+/*Number of bytes dropped as the buffer was full*/
+static volatile uint16 g_dropped=0;
+
+/******************************************************************
+ * 				  Interrupt Service Routines					  *
+ ******************************************************************/
+/*Pin is driven by the OC2 compare output, so each edge is made by hardware exactly on a
+ *compare match. Each interrupt sets the level of the next bit of the frame (COM20 set for
+ *high, clear for low) which gives the ISR a whole bit time of latency tolerance. A new frame
+ *is started right after a stop bit if a byte is queued or else the interrupt and the timer
+ *clock are stopped, the output was set by the stop bit so the line stays idle high*/
+ISR(TIMER2_COMP_vect)
+{
+	if(g_bit == SUART_IDLE)
+	{
+		if(g_head == g_tail)
+		{
+			CLEAR_BIT(TIMSK,OCIE2);
+			TCCR2=SUART_TIMER_MODE;
+			return;
+		}
+		g_shift=g_buffer[g_tail];
+		g_tail=(g_tail+1) & SUART_BUFFER_MASK;
+		g_bit=0;
+	}
+	if(g_bit == 0)
+	{
+		CLEAR_BIT(TCCR2,COM20);
+		g_bit++;
+	}
+	else if(g_bit <= 8)
+	{
+		if(g_shift & 0x01)
+		{
+			SET_BIT(TCCR2,COM20);
+		}
+		else
+		{
+			CLEAR_BIT(TCCR2,COM20);
+		}
+		g_shift>>=1;
+		g_bit++;
+	}
+	else
+	{
+		SET_BIT(TCCR2,COM20);
+		g_bit=SUART_IDLE;
+	}
+}
+
+/******************************************************************
+ * 				  Public Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function initialises the software UART:
+ * 1. TX pin is output and idle high
+ * 2. TIMER2 in CTC mode with compare value of a bit time and OC2 set on compare match,
+ *    OC2 is forced high
+ * 3. Timer clock and compare match interrupt are enabled only while bytes are sent*/
+void SUART_init(void)
+{
+	SET_BIT(SUART_PORT,SUART_PIN);
+	SET_BIT(SUART_DIR,SUART_PIN);
+	CLEAR_BIT(TIMSK,OCIE2);
+	g_head=0;
+	g_tail=0;
+	g_bit=SUART_IDLE;
+	OCR2=SUART_COMPARE_VAL;
+	TCNT2=0;
+	TCCR2=SUART_TIMER_MODE | (1<<FOC2);
+}
+
+/*Description: This function adds a byte at the head of the buffer, the timer is started if
+ *the channel was idle so the start bit goes out two bit times later*/
+uint8 SUART_sendByte(uint8 data)
+{
+	uint8 next=(g_head+1) & SUART_BUFFER_MASK;
+	uint8 sreg;
+	if(next == g_tail)
+	{
+		if(g_dropped != 0xFFFF)
+		{
+			g_dropped++;
+		}
+		return FALSE;
+	}
+	g_buffer[g_head]=data;
+	g_head=next;
+	/*ISR may disable its interrupt meanwhile, so TIMSK is changed with interrupts disabled*/
+	sreg=SREG;
+	cli();
+	if(IS_BIT_CLEAR(TIMSK,OCIE2))
+	{
+		TCNT2=0;
+		/*Clear a compare match flag left from the last frame*/
+		TIFR=(1<<OCF2);
+		TCCR2=SUART_TIMER_MODE | SUART_TIMER_CLOCK;
+		SET_BIT(TIMSK,OCIE2);
+	}
+	SREG=sreg;
+	return TRUE;
+}
+
+/*Description: This function queues the bytes of a string till its end or a full buffer*/
+uint8 SUART_sendString(const uint8 * str)
+{
+	uint8 i=0;
+	while(str[i] != '\0')
+	{
+		if(!SUART_sendByte(str[i]))
+		{
+			return FALSE;
+		}
+		i++;
+	}
+	return TRUE;
+}
+
+/*Description: This function busy-waits till the ISR frees a place in the buffer, then
+ *queues the byte*/
+void SUART_sendByteWaiting(uint8 data)
+{
+	while(SUART_getFree() == 0);
+	SUART_sendByte(data);
+}
+
+/*Description: This function returns the number of free places in the buffer*/
+uint8 SUART_getFree(void)
+{
+	return (g_tail-g_head-1) & SUART_BUFFER_MASK;
+}
+
+/*Description: This function returns TRUE while the interrupt is sending frames*/
+uint8 SUART_isBusy(void)
+{
+	return IS_BIT_SET(TIMSK,OCIE2) ? TRUE : FALSE;
+}
+
+/*Description: This function returns the number of dropped bytes*/
+uint16 SUART_getDropped(void)
+{
+	return g_dropped;
+}
+#endif
@@ -0,0 +1,107 @@
+/*******************************************************************************************
+ * [FILE NAME]:		soft_uart.h
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This header file contains static configurations and function prototypes
+ * 					of the software UART, a transmit-only debug/telemetry channel in AVR
+ * 					ATMEGA-16 Micro-controller. Hardware UART is taken by the HMI-Control
+ * 					link, so frames (8 data bits, no parity, 1 stop bit) are shifted out on
+ * 					the spare OC2 pin, TIMER2 compare match makes each edge and its interrupt
+ * 					sets the level of the next bit. Bytes are queued in a buffer and sent in
+ * 					the background, TIMER2 is stopped while there is nothing to send
+ *******************************************************************************************/
+
+#ifndef SOFT_UART_H_
+#define SOFT_UART_H_
+
+/******************************************************************
+ * 				Common Header Files Inclusion					  *
+ ******************************************************************/
+#include "micro_config.h"
+#include "std_types.h"
+#include "common_macros.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+/*TX pin of the debug channel, it's OC2 pin (PD7) which is free on both ECUs*/
+#define SUART_DIR				DDRD
+#define SUART_PORT				PORTD
+#define SUART_PIN				PD7
+/*Baud rate of the debug channel, TIMER2 runs at F_CPU/8 so the bit time is a whole number
+ *of counts: 19200 baud is 52 counts (+0.16% error) at 8 MHz*/
+#define SUART_BAUD				19200UL
+#define SUART_COMPARE_VAL		((F_CPU/(8UL*SUART_BAUD))-1)
+/*Size of the transmit buffer, it shall be a power of 2 up to 256*/
+#define SUART_BUFFER_SIZE		16u
+#define SUART_BUFFER_MASK		(SUART_BUFFER_SIZE-1u)
+
+/******************************************************************
+ * 				    Public Functions Prototypes					  *
+ ******************************************************************/
+/*******************************************************************************
+ * [Function Name]	: SUART_init
+ * [Description]	: This function sets the TX pin idle (high) and TIMER2 in CTC mode at
+ * 					  the bit rate, the timer is started when bytes are queued. Global
+ * 					  interrupts shall be enabled
+ * [Arguments]		: void
+ * [Returns]		: void
+ *******************************************************************************/
+void SUART_init(void);
+
+/*******************************************************************************
+ * [Function Name]	: SUART_sendByte
+ * [Description]	: This function queues a byte without waiting, the byte is dropped
+ * 					  and counted if the buffer is full
+ * [Arguments]		: uint8 data
+ * [Returns]		: uint8
+ * 						TRUE if the byte is queued
+ *******************************************************************************/
+uint8 SUART_sendByte(uint8 data);
+
+/*******************************************************************************
+ * [Function Name]	: SUART_sendString
+ * [Description]	: This function queues a null terminated string without waiting, it
+ * 					  stops at the first byte dropped
+ * [Arguments]		: const uint8 * str
+ * [Returns]		: uint8
+ * 						TRUE if the whole string is queued
+ *******************************************************************************/
+uint8 SUART_sendString(const uint8 * str);
+
+/*******************************************************************************
+ * [Function Name]	: SUART_sendByteWaiting
+ * [Description]	: This function queues a byte and waits for room in the buffer if it's
+ * 					  full, for dumps which shall not lose bytes. It's not called from ISRs
+ * [Arguments]		: uint8 data
+ * [Returns]		: void
+ *******************************************************************************/
+void SUART_sendByteWaiting(uint8 data);
+
+/*******************************************************************************
+ * [Function Name]	: SUART_getFree
+ * [Description]	: This function returns the number of bytes that can be queued now,
+ * 					  a record is sent whole or not at all by checking its length first
+ * [Arguments]		: void
+ * [Returns]		: uint8
+ *******************************************************************************/
+uint8 SUART_getFree(void);
+
+/*******************************************************************************
+ * [Function Name]	: SUART_isBusy
+ * [Description]	: This function tells whether bytes are still queued or being sent
+ * [Arguments]		: void
+ * [Returns]		: uint8
+ *******************************************************************************/
+uint8 SUART_isBusy(void);
+
+/*******************************************************************************
+ * [Function Name]	: SUART_getDropped
+ * [Description]	: This function returns the number of bytes dropped as the buffer was
+ * 					  full, it stops at its maximum
+ * [Arguments]		: void
+ * [Returns]		: uint16
+ *******************************************************************************/
+uint16 SUART_getDropped(void);
+
+#endif /* SOFT_UART_H_ */
@@ -35,13 +35,21 @@ typedef unsigned char 		bool;
 /**********************UNSIGNED DECIMAL TYPES**************************/
 typedef unsigned char 		uint8;			/*1 Byte		0 -> 255*/
 typedef unsigned short 		uint16;			/*2 Bytes		0 -> 65536*/
+#ifdef HOST_BUILD
+typedef unsigned int 		uint32;			/*4 Bytes on 64-bit host*/
+#else
 typedef unsigned long 		uint32;			/*4 Bytes		0 -> 4294967296*/
+#endif
 typedef unsigned long long 	uint64;			/*8 Bytes		0 -> 18446744073709551615*/
 
 /**********************SIGNED DECIMAL TYPES**************************/
 typedef signed char 		sint8;			/*1 Byte		       -128 -> +127*/
 typedef signed short 		sint16;			/*2 Bytes		     -32768 -> +32767*/
+#ifdef HOST_BUILD
+typedef signed int 			sint32;			/*4 Bytes on 64-bit host*/
+#else
 typedef signed long 		sint32;			/*4 Bytes		-2147483648 -> +2147483647*/
+#endif
 typedef signed long long 	sint64;			/*8 Bytes								  */
 
 /**********************FLOAT TYPES**************************/
@@ -0,0 +1,51 @@
+/*******************************************************************************************
+ * [FILE NAME]:		tick.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains implementation of the tick service on TIMER0
+ * 					overflow in AVR ATMEGA-16 Micro-controller
+ *******************************************************************************************/
+
+#include "tick.h"
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+static void (* volatile g_callBackPtr[TICK_CLIENTS])(void);
+
+/******************************************************************
+ * 				  Private Functions Prototypes					  *
+ ******************************************************************/
+static void TICK_overflow(void);
+
+/******************************************************************
+ * 				  Public Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function starts the clock and sets the tick as its overflow callback*/
+void TICK_init(void)
+{
+	CLOCK_init();
+	CLOCK_setOverflowCallBack(TICK_overflow);
+}
+
+/*Description: This function sets call back function of a tick client*/
+void TICK_setCallBack(TICK_Client client, void(*a_ptr)(void))
+{
+	g_callBackPtr[client]=a_ptr;
+}
+
+/******************************************************************
+ * 				  Private Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function calls the clients on a tick*/
+static void TICK_overflow(void)
+{
+	uint8 client;
+	for(client=0;client<TICK_CLIENTS;client++)
+	{
+		if(g_callBackPtr[client] != NULL_PTR)
+		{
+			(*g_callBackPtr[client])();
+		}
+	}
+}
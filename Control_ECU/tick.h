@@ -0,0 +1,65 @@
+/*******************************************************************************************
+ * [FILE NAME]:		tick.h
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This header file contains static configurations, data types and function
+ * 					prototypes of the tick service: TIMER0 overflow, every 256 counts at
+ * 					F_CPU/64 (2.048 msec at 8 MHz), calls each client registered for it.
+ * 					TIMER0 runs all the time for the motor PWM (motor.h) and the clock
+ * 					(clock.h) which keep this overflow period, so the tick costs no timer:
+ * 					TIMER1 is left to the buzzer tones. The clock owns the overflow
+ * 					interrupt and the tick is its overflow callback
+ *******************************************************************************************/
+
+#ifndef TICK_H_
+#define TICK_H_
+
+/******************************************************************
+ * 				Common Header Files Inclusion					  *
+ ******************************************************************/
+#include "micro_config.h"
+#include "std_types.h"
+#include "common_macros.h"
+#include "clock.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+/*Macro to define the time of a tick in micro-seconds (256 counts of TIMER0 at F_CPU/64)*/
+#define TICK_US					(16384000000UL/F_CPU)
+/*Macro to convert a time in milli-seconds to ticks, rounded up*/
+#define TICK_FROM_MS(MS)		((((uint32)(MS)*1000UL)+TICK_US-1UL)/TICK_US)
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[ENUM Name]		: TICK_Client
+ *[ENUM Description]: This enum contains the modules taking the tick, called in this order*/
+typedef enum{
+	TICK_TIMELINE,TICK_BUZZER,TICK_CLIENTS
+}TICK_Client;
+
+/******************************************************************
+ * 				    Public Functions Prototypes					  *
+ ******************************************************************/
+/*******************************************************************************
+ * [Function Name]	: TICK_init
+ * [Description]	: This function takes TIMER0 overflow as the tick: the clock is
+ * 					  started and the tick is set as its overflow callback
+ * [Arguments]		: void
+ * [Returns]		: void
+ *******************************************************************************/
+void TICK_init(void);
+
+/*******************************************************************************
+ * [Function Name]	: TICK_setCallBack
+ * [Description]	: This function sets the function a client is called with on each
+ * 					  tick from TIMER0 overflow interrupt, it shall return quickly while
+ * 					  the client has nothing to time
+ * [Arguments]		: TICK_Client client
+ * 					  void(*a_ptr)(void): callback, NULL_PTR to remove it
+ * [Returns]		: void
+ *******************************************************************************/
+void TICK_setCallBack(TICK_Client client, void(*a_ptr)(void));
+
+#endif /* TICK_H_ */
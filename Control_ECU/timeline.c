@@ -0,0 +1,201 @@
+/*******************************************************************************************
+ * [FILE NAME]:		timeline.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains implementation of the actuation timeline engine
+ *******************************************************************************************/
+
+#include "timeline.h"
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+/*Running timeline: its steps, the current step, the ticks left till the next one and the
+ *periods of the tick service left till the next tick*/
+static const TIMELINE_StepType * volatile g_steps=NULL_PTR;
+static volatile uint8 g_count=0;
+static volatile uint8 g_step=0;
+static volatile uint8 g_ticks=0;
+static volatile uint16 g_periods=0;
+
+/*Circular buffer of notifications, filled by the steps and emptied by the main loop*/
+static volatile uint8 g_events[TIMELINE_QUEUE_SIZE];
+static volatile uint8 g_eventsHead=0;
+static volatile uint8 g_eventsTail=0;
+/*Notifications dropped as the queue was full*/
+static volatile uint16 g_overflows=0;
+
+/******************************************************************
+ * 				  Private Functions Prototypes					  *
+ ******************************************************************/
+static void TIMELINE_tick(void);
+static void TIMELINE_runStep(void);
+static void TIMELINE_restart(void);
+static void TIMELINE_cancel(void);
+static void TIMELINE_queue(uint8 event, uint8 reserve);
+
+/******************************************************************
+ * 				  Public Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function sets the engine as client of the tick service and empties
+ *the queue*/
+void TIMELINE_init(void)
+{
+	g_steps=NULL_PTR;
+	g_eventsHead=0;
+	g_eventsTail=0;
+	g_overflows=0;
+	TICK_setCallBack(TICK_TIMELINE,TIMELINE_tick);
+}
+
+/*Description: This function starts a timeline from its first step, with interrupts disabled
+ *as the tick and the end causes change the running timeline from interrupts*/
+void TIMELINE_start(const TIMELINE_StepType * steps, uint8 count)
+{
+	uint8 sreg=SREG;
+	cli();
+	g_steps=steps;
+	g_count=count;
+	g_step=0;
+	TIMELINE_restart();
+	SREG=sreg;
+}
+
+/*Description: This function ends the current step if it may end for the given causes,
+ *nothing is done when no timeline runs*/
+void TIMELINE_endStep(uint8 cause)
+{
+	if((g_steps == NULL_PTR) || ((g_steps[g_step].endOn & cause) == 0))
+	{
+		return;
+	}
+	g_step++;
+	TIMELINE_restart();
+}
+
+/*Description: This function queues a notification, the slots kept for steps left free*/
+void TIMELINE_notify(uint8 event)
+{
+	TIMELINE_queue(event,TIMELINE_QUEUE_RESERVE);
+}
+
+/*Description: This function returns TRUE while a timeline is running*/
+uint8 TIMELINE_isRunning(void)
+{
+	return (g_steps != NULL_PTR) ? TRUE : FALSE;
+}
+
+/*Description: This function takes the oldest notification from the queue*/
+uint8 TIMELINE_getEvent(uint8 * event)
+{
+	if(g_eventsHead == g_eventsTail)
+	{
+		return FALSE;
+	}
+	*event=g_events[g_eventsTail];
+	/*Only the tail is changed here and only the head by interrupts (steps and notifications),
+	 *so no locking is needed*/
+	g_eventsTail=(g_eventsTail+1) & TIMELINE_QUEUE_MASK;
+	return TRUE;
+}
+
+/*Description: This function returns TRUE while a notification is queued*/
+uint8 TIMELINE_hasEvent(void)
+{
+	return (g_eventsHead != g_eventsTail) ? TRUE : FALSE;
+}
+
+/*Description: This function returns the dropped notifications, read with interrupts off as
+ *they're counted by interrupts*/
+uint16 TIMELINE_getOverflows(void)
+{
+	uint16 overflows;
+	uint8 sreg=SREG;
+	cli();
+	overflows=g_overflows;
+	SREG=sreg;
+	return overflows;
+}
+
+/******************************************************************
+ * 				  Private Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function is the tick service callback, a tick is over each
+ *TIMELINE_TICK_PERIODS and the next step runs when the ticks of the current one are over*/
+static void TIMELINE_tick(void)
+{
+	if(g_steps == NULL_PTR)
+	{
+		return;
+	}
+	g_periods--;
+	if(g_periods != 0)
+	{
+		return;
+	}
+	g_periods=TIMELINE_TICK_PERIODS;
+	g_ticks--;
+	if(g_ticks == 0)
+	{
+		g_step++;
+		TIMELINE_runStep();
+	}
+}
+
+/*Description: This function runs the current step: its command, its notification queued
+ *(in any free slot) and its ticks loaded. A step of 0 ticks is followed by the
+ *next one at once, past the last step the timeline ends*/
+static void TIMELINE_runStep(void)
+{
+	const TIMELINE_StepType * step;
+	while(g_step != g_count)
+	{
+		step=&g_steps[g_step];
+		if(step->command != NULL_PTR)
+		{
+			(*step->command)();
+		}
+		if(step->event != TIMELINE_NO_EVENT)
+		{
+			TIMELINE_queue(step->event,0);
+		}
+		g_ticks=step->ticks;
+		if(g_ticks != 0)
+		{
+			return;
+		}
+		g_step++;
+	}
+	TIMELINE_cancel();
+}
+
+/*Description: This function runs the current step with its ticks counted from now, it's
+ *called from interrupts or with interrupts disabled so the tick doesn't run meanwhile*/
+static void TIMELINE_restart(void)
+{
+	g_periods=TIMELINE_TICK_PERIODS;
+	TIMELINE_runStep();
+}
+
+/*Description: This function stops the running timeline, the tick is then ignored*/
+static void TIMELINE_cancel(void)
+{
+	g_steps=NULL_PTR;
+}
+
+/*Description: This function queues a notification if more than the given slots are free,
+ *else it's dropped and counted. It's called from interrupts or with interrupts disabled, and
+ *only the head is changed here so no locking is needed against TIMELINE_getEvent*/
+static void TIMELINE_queue(uint8 event, uint8 reserve)
+{
+	uint8 used=(g_eventsHead-g_eventsTail) & TIMELINE_QUEUE_MASK;
+	if((used+reserve) < TIMELINE_QUEUE_MASK)
+	{
+		g_events[g_eventsHead]=event;
+		g_eventsHead=(g_eventsHead+1) & TIMELINE_QUEUE_MASK;
+	}
+	else if(g_overflows != 0xFFFF)
+	{
+		g_overflows++;
+	}
+}
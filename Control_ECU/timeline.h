@@ -0,0 +1,136 @@
+/*******************************************************************************************
+ * [FILE NAME]:		timeline.h
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This header file contains static configurations, data types and function
+ * 					prototypes of the actuation timeline engine: a timeline is a table of
+ * 					steps, each step runs an actuator command, queues a notification and
+ * 					lasts a number of 5 sec ticks before the next step. Steps run from
+ * 					the tick service (tick.h, TIMER0 overflow), notifications are taken by the main loop from the
+ * 					events queue so nothing is sent on the link from the interrupt. A step
+ * 					may be ended before its ticks are over by the events its table entry
+ * 					selects (e.g. a motor reaching its end stop or the door closing)
+ *******************************************************************************************/
+
+#ifndef TIMELINE_H_
+#define TIMELINE_H_
+
+/******************************************************************
+ * 				Common Header Files Inclusion					  *
+ ******************************************************************/
+#include "micro_config.h"
+#include "std_types.h"
+#include "common_macros.h"
+#include "tick.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+/*Tick of timelines: 5 sec, counted in ticks of the tick service (2442 of 2.048 msec)*/
+#define TIMELINE_TICK_MS		5000u
+#define TIMELINE_TICK_PERIODS	((uint16)TICK_FROM_MS(TIMELINE_TICK_MS))
+/*Macro to define the size of events queue, a power of 2. Notifications are dropped and
+ *counted when the main loop doesn't take them in time*/
+#define TIMELINE_QUEUE_SIZE		8u
+#define TIMELINE_QUEUE_MASK		(TIMELINE_QUEUE_SIZE-1u)
+/*Macro to define the slots of the queue TIMELINE_notify leaves free for the notifications of
+ *steps, so a burst of notifications from interrupts doesn't drop a step HMI waits for (a
+ *timeline notifies 3 steps at most, DOOR_UNLOCKING, DOOR_LOCKING and DOOR_LOCKED)*/
+#define TIMELINE_QUEUE_RESERVE	3u
+/*Notification of a step which has none*/
+#define TIMELINE_NO_EVENT		0x00
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[Structure Name]		 : TIMELINE_StepType
+ *[Structure Description]: This structure contains a step of a timeline: the actuator
+ * 						   command run when the step starts, the notification queued then
+ * 						   and the ticks till the next step (0 runs the next step at once),
+ * 						   and the causes (bits defined by the application) TIMELINE_endStep
+ * 						   may end the step earlier for, 0 for none*/
+typedef struct{
+	void (*command)(void);
+	uint8 ticks;
+	uint8 event;
+	uint8 endOn;
+}TIMELINE_StepType;
+
+/******************************************************************
+ * 				    Public Functions Prototypes					  *
+ ******************************************************************/
+/*******************************************************************************
+ * [Function Name]	: TIMELINE_init
+ * [Description]	: This function sets the engine as client of the tick service and
+ * 					  empties the events queue, the tick service shall be initialised
+ * [Arguments]		: void
+ * [Returns]		: void
+ *******************************************************************************/
+void TIMELINE_init(void);
+
+/*******************************************************************************
+ * [Function Name]	: TIMELINE_start
+ * [Description]	: This function starts a timeline, any running one is stopped: the
+ * 					  first step runs now and the ticks of the next ones are counted
+ * 					  from now
+ * [Arguments]		: const TIMELINE_StepType * steps: table of steps, kept by the engine
+ * 					  uint8 count: number of steps
+ * [Returns]		: void
+ *******************************************************************************/
+void TIMELINE_start(const TIMELINE_StepType * steps, uint8 count);
+
+/*******************************************************************************
+ * [Function Name]	: TIMELINE_endStep
+ * [Description]	: This function ends the current step now if its endOn has one of
+ * 					  the given causes: the next step runs and its ticks are counted from
+ * 					  now. It's meant to be called from interrupts (motor stall, sensors)
+ * [Arguments]		: uint8 cause: cause bits of the event
+ * [Returns]		: void
+ *******************************************************************************/
+void TIMELINE_endStep(uint8 cause);
+
+/*******************************************************************************
+ * [Function Name]	: TIMELINE_notify
+ * [Description]	: This function queues a notification besides the ones of steps,
+ * 					  it's dropped if only the slots kept for steps are free. It's meant
+ * 					  to be called from interrupts
+ * [Arguments]		: uint8 event: notification
+ * [Returns]		: void
+ *******************************************************************************/
+void TIMELINE_notify(uint8 event);
+
+/*******************************************************************************
+ * [Function Name]	: TIMELINE_isRunning
+ * [Description]	: This function returns TRUE while a timeline is running
+ * [Arguments]		: void
+ * [Returns]		: uint8
+ *******************************************************************************/
+uint8 TIMELINE_isRunning(void);
+
+/*******************************************************************************
+ * [Function Name]	: TIMELINE_getEvent
+ * [Description]	: This function takes the oldest notification from the events queue
+ * [Arguments]		: uint8 * event: notification taken
+ * [Returns]		: uint8: TRUE if a notification was taken, FALSE if the queue is empty
+ *******************************************************************************/
+uint8 TIMELINE_getEvent(uint8 * event);
+
+/*******************************************************************************
+ * [Function Name]	: TIMELINE_hasEvent
+ * [Description]	: This function returns TRUE while a notification is queued, it's
+ * 					  checked with interrupts disabled before sleeping
+ * [Arguments]		: void
+ * [Returns]		: uint8
+ *******************************************************************************/
+uint8 TIMELINE_hasEvent(void);
+
+/*******************************************************************************
+ * [Function Name]	: TIMELINE_getOverflows
+ * [Description]	: This function returns the number of notifications dropped as the
+ * 					  queue was full, it stops at its maximum
+ * [Arguments]		: void
+ * [Returns]		: uint16
+ *******************************************************************************/
+uint16 TIMELINE_getOverflows(void);
+
+#endif /* TIMELINE_H_ */
@@ -0,0 +1,109 @@
+/*******************************************************************************************
+ * [FILE NAME]:		trace.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains implementation of the trace recorder, a RAM ring of
+ * 					events time stamped by clock ticks
+ *******************************************************************************************/
+
+#include "trace.h"
+#include "link.h"
+#include "soft_uart.h"
+
+#if(TRACE_ENABLE)
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+/*Ring of events, it's not static so a debugger or the simulator can find it by its name
+ *and read it while the firmware is stopped*/
+TRACE_RingType g_traceRing;
+
+/******************************************************************
+ * 				  Private Functions Prototypes					  *
+ ******************************************************************/
+static void TRACE_sendHex(uint32 value, uint8 digits);
+
+/******************************************************************
+ * 				  Public Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function starts the clock and the dump channel*/
+void TRACE_init(void)
+{
+	CLOCK_init();
+#if(PROBE_CHANNEL == PROBE_SUART)
+	SUART_init();
+#endif
+}
+
+/*Description: This function writes an event at the head of the ring, the oldest event is
+ *overwritten if the ring is full. Interrupts are disabled meanwhile as ISRs record too*/
+void TRACE_record(uint8 id, uint16 arg)
+{
+	uint8 sreg=SREG;
+	TRACE_EventType * event;
+	cli();
+	if(!g_traceRing.paused)
+	{
+		event=&g_traceRing.events[g_traceRing.head];
+		event->id=id;
+		event->time=CLOCK_now();
+		event->arg=arg;
+		g_traceRing.head=(g_traceRing.head+1) & TRACE_MASK;
+		if(g_traceRing.count < TRACE_SIZE)
+		{
+			g_traceRing.count++;
+		}
+		else if(g_traceRing.lost != 0xFFFF)
+		{
+			g_traceRing.lost++;
+		}
+	}
+	SREG=sreg;
+}
+
+/*Description: This function sends the header line and a line per event from the oldest*/
+void TRACE_dump(void)
+{
+	const TRACE_EventType * event;
+	uint16 index;
+	uint16 i;
+	g_traceRing.paused=TRUE;
+	PROBE_SEND('T');
+	PROBE_SEND('R');
+	PROBE_SEND(':');
+	TRACE_sendHex(CLOCK_TICK_US,2);
+	PROBE_SEND(':');
+	TRACE_sendHex(g_traceRing.count,4);
+	PROBE_SEND(':');
+	TRACE_sendHex(g_traceRing.lost,4);
+	PROBE_SEND('\n');
+	index=(g_traceRing.head-g_traceRing.count) & TRACE_MASK;
+	for(i=0;i<g_traceRing.count;i++)
+	{
+		event=&g_traceRing.events[(index+i) & TRACE_MASK];
+		PROBE_SEND('T');
+		TRACE_sendHex(event->id,2);
+		TRACE_sendHex(event->time,8);
+		TRACE_sendHex(event->arg,4);
+		PROBE_SEND('\n');
+	}
+	g_traceRing.count=0;
+	g_traceRing.lost=0;
+	g_traceRing.paused=FALSE;
+}
+
+/******************************************************************
+ * 				  Private Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function sends the lower digits of a number in upper case hex*/
+static void TRACE_sendHex(uint32 value, uint8 digits)
+{
+	uint8 digit;
+	while(digits != 0)
+	{
+		digits--;
+		digit=(value>>(digits*4u))&0x0F;
+		PROBE_SEND((digit < 10) ? ('0'+digit) : ('A'+digit-10));
+	}
+}
+#endif
@@ -0,0 +1,149 @@
+/*******************************************************************************************
+ * [FILE NAME]:		trace.h
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This header file contains static configurations and function prototypes
+ * 					of the trace recorder: compact events (source, phase, time stamp and a
+ * 					16-bit argument) are recorded from ISRs and main code in a RAM ring, the
+ * 					oldest events are overwritten when it's full (flight recorder). The ring
+ * 					is dumped as text on the probes dump channel (PROBE_CHANNEL) on a
+ * 					diagnostic request and converted on PC
+ * 					by Host/traceconv to Chrome trace JSON or VCD.
+ * 					Time stamps are clock ticks (clock.h), tracing doesn't need probes
+ *******************************************************************************************/
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+/******************************************************************
+ * 				Common Header Files Inclusion					  *
+ ******************************************************************/
+#include "micro_config.h"
+#include "std_types.h"
+#include "common_macros.h"
+#include "clock.h"
+#include "probe.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+/*Macro to enable (1) or remove (0) tracing at compile time, when removed the trace macros
+ *expand to nothing. It's off by default like probes and doesn't need them, the ring doesn't
+ *fit in the SRAM of ATmega16 with the probe histograms*/
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE			0
+#endif
+/*Macro to define the number of events kept in the ring, it shall be a power of 2
+ *(7 bytes of RAM each on AVR)*/
+#ifndef TRACE_SIZE
+#define TRACE_SIZE				16u
+#endif
+#define TRACE_MASK				(TRACE_SIZE-1u)
+/*Macro to select the sources recorded, a bit per TRACE_Source (e.g. 0xFD drops TRACE_TIMER1
+ *so the 5 msec keypad scan of HMI doesn't fill the ring)*/
+#ifndef TRACE_SOURCES
+#define TRACE_SOURCES			0xFFu
+#endif
+
+/*Phase of an event, kept in the upper 2 bits of its ID byte*/
+#define TRACE_INSTANT			0x00
+#define TRACE_PHASE_BEGIN		0x40
+#define TRACE_PHASE_END			0x80
+#define TRACE_PHASE_MASK		0xC0
+#define TRACE_SOURCE_MASK		0x3F
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[ENUM Name]		: TRACE_Source
+ *[ENUM Description]: This enum contains the sources of events of both ECUs and the
+ *					  argument each one records*/
+typedef enum{
+	TRACE_STATE,		/*State function called by main loop, begin argument is its ID and end
+						 *argument is the ID of the next one*/
+	TRACE_TIMER1,		/*TIMER1 callback, argument is 0 for compare match and 1 for overflow*/
+	TRACE_UART_RX,		/*Wait for a UART frame, end argument is the received frame (9th bit included)*/
+	TRACE_UART_TX,		/*Frame written to UART transmitter, argument is the frame (9th bit included)*/
+	TRACE_TWI,			/*TWI transaction from start to stop, begin argument is TWI status
+						 *(0x08 START or 0x10 repeated START)*/
+	TRACE_LCD,			/*LCD string write or clear, end argument is the number of characters*/
+	TRACE_SPI,			/*Wait for a byte on SPI link, end argument is the received byte, and each
+						 *transfer carrying data, argument is sent byte << 8 | received byte*/
+	TRACE_SOURCE_COUNT
+}TRACE_Source;
+
+/*[Structure Name]		 : TRACE_EventType
+ *[Structure Description]: This structure contains an event recorded in the ring*/
+typedef struct{
+	uint32 time;		/*Clock ticks*/
+	uint16 arg;
+	uint8 id;			/*Phase | source*/
+}TRACE_EventType;
+
+/*[Structure Name]		 : TRACE_RingType
+ *[Structure Description]: This structure contains the ring of events, head is the next event
+ *						   to be written and count the number of kept events*/
+typedef struct{
+	TRACE_EventType events[TRACE_SIZE];
+	uint16 head;
+	uint16 count;
+	uint16 lost;		/*Events overwritten before being dumped, stops at its maximum*/
+	uint8 paused;
+}TRACE_RingType;
+
+/******************************************************************
+ * 						Function-like Macros					  *
+ ******************************************************************/
+#if(TRACE_ENABLE)
+#define TRACE_INIT()			TRACE_init()
+#define TRACE_EVENT(SOURCE,ARG)	(IS_BIT_SET((TRACE_SOURCES),SOURCE) ? TRACE_record(TRACE_INSTANT | (SOURCE),(ARG)) : (void)0)
+#define TRACE_BEGIN(SOURCE,ARG)	(IS_BIT_SET((TRACE_SOURCES),SOURCE) ? TRACE_record(TRACE_PHASE_BEGIN | (SOURCE),(ARG)) : (void)0)
+#define TRACE_END(SOURCE,ARG)	(IS_BIT_SET((TRACE_SOURCES),SOURCE) ? TRACE_record(TRACE_PHASE_END | (SOURCE),(ARG)) : (void)0)
+#define TRACE_DUMP()			TRACE_dump()
+#else
+#define TRACE_INIT()			((void)0)
+#define TRACE_EVENT(SOURCE,ARG)	((void)0)
+#define TRACE_BEGIN(SOURCE,ARG)	((void)0)
+#define TRACE_END(SOURCE,ARG)	((void)0)
+#define TRACE_DUMP()			((void)0)
+#endif
+
+/******************************************************************
+ * 				    Public Functions Prototypes					  *
+ ******************************************************************/
+#if(TRACE_ENABLE)
+/*******************************************************************************
+ * [Function Name]	: TRACE_init
+ * [Description]	: This function starts the clock as time base of events and the
+ * 					  software UART if it's the dump channel, global interrupts shall be
+ * 					  enabled
+ * [Arguments]		: void
+ * [Returns]		: void
+ *******************************************************************************/
+void TRACE_init(void);
+
+/*******************************************************************************
+ * [Function Name]	: TRACE_record
+ * [Description]	: This function records an event in the ring with the current clock
+ * 					  time, it can be called from ISRs
+ * [Arguments]		: uint8 id
+ * 						This is the phase of the event ORed with its source
+ * 					  uint16 arg
+ * [Returns]		: void
+ *******************************************************************************/
+void TRACE_record(uint8 id, uint16 arg);
+
+/*******************************************************************************
+ * [Function Name]	: TRACE_dump
+ * [Description]	: This function sends the kept events on the dump channel as text lines of hex
+ * 					  numbers from the oldest one and empties the ring, recording is paused
+ * 					  meanwhile so the dump doesn't trace itself:
+ * 					  TR:<tick us>:<count>:<lost>
+ * 					  T<id 2 digits><time 8 digits><arg 4 digits>	(one line per event)
+ * [Arguments]		: void
+ * [Returns]		: void
+ *******************************************************************************/
+void TRACE_dump(void);
+#endif
+
+#endif /* TRACE_H_ */
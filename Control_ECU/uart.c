@@ -8,6 +8,9 @@
 
 
 #include "uart.h"
+#include "probe.h"
+#include "trace.h"
+#include "idle.h"
 
 /******************************************************************
  * 						Global Variables						  *
@@ -18,11 +21,18 @@
 static volatile void (*g_callBackPtr)(void) = NULL_PTR;
 /*Global variable to hold byte to be used in receiveByte API in case of receiving
  *with interrupts and to be extern-ed*/
-volatile uint8 g_RxData;
+volatile uint16 g_RxData;
 /*Global variable to hold string to be used in receiveString API in case of receiving
  *with interrupts and to be extern-ed*/
 volatile uint8 g_RxString[20];
 #endif
+/*Node address on a multi-drop bus, UART_NO_ADDRESS if MPCM isn't used*/
+static uint8 g_address=UART_NO_ADDRESS;
+
+/******************************************************************
+ * 				  Private Functions Prototypes					  *
+ ******************************************************************/
+static uint8 UART_takeAddress(uint16 frame);
 
 /******************************************************************
  * 				   Interrupt Service Routines					  *
@@ -33,25 +43,39 @@ volatile uint8 g_RxString[20];
  *the data is ready to be read from UDR register*/
 ISR(USART_RXC_vect)
 {
-	/*Error Checking*/
+	uint16 frame;
+	/*Error Checking, the frame is read to drop it and clear RXC*/
 	if (UCSRA & ((1<<FE)|(1<<DOR)|(1<<PE)))
 	{
+		frame=UDR;
 		return;
 	}
 
 	/*Read data byte from UDR buffer in global variable*/
 	/*Automatically, the RXC flag will be cleared  when the data is read from UDR buffer*/
-	if(IS_BIT_SET(UCSRB,RXB8))
+	/*9th bit shall be read from RXB8 before UDR*/
+	frame=IS_BIT_SET(UCSRB,RXB8) ? UART_ADDRESS_BIT : 0;
+	frame|=UDR;
+	TRACE_EVENT(TRACE_UART_RX,frame);
+	if(UART_takeAddress(frame))
 	{
-		SET_BIT(g_RxData,8);
+		return;
 	}
-	g_RxData=(g_RxData&0x100)|(UDR);
+	g_RxData=frame;
 	if(g_callBackPtr != NULL_PTR)
 	{
 		/*Call callback function through callback pointer*/
 		(*g_callBackPtr)();
 	}
 }
+#else
+/*ISR of USART, Rx Complete, enabled only while the CPU sleeps waiting for a frame: it
+ *wakes the CPU and is disabled again, the frame is left in UDR to be received*/
+ISR(USART_RXC_vect)
+{
+	IDLE_WAKE();
+	CLEAR_BIT(UCSRB,RXCIE);
+}
 #endif
 /******************************************************************
  * 				  	  Functions Definitions				 		  *
@@ -63,7 +87,8 @@ ISR(USART_RXC_vect)
  * 		a. Parity type (even/odd/disabled)
  * 		b. Number of stop bit(s) (1/2)
  * 		c. Number of data bits (5/6/7/8/9)
- * 4. Sets mode of UART (polling/interrupt)*/
+ * 4. Sets mode of UART (polling/interrupt)
+ * 5. Sets multi-processor communication mode if the node has an address*/
 void UART_init(const UART_ConfigType * Config_Ptr)
 {
 	/*1. SETS BAUD RATE VALUE*/
@@ -85,11 +110,19 @@ void UART_init(const UART_ConfigType * Config_Ptr)
 	UCSRA=0;
 	/*2. Enable Double UART Transmission Speed*/
 	SET_BIT(UCSRA,U2X);
+	/*Node with an address starts deselected, receiver takes address frames only*/
+	g_address=Config_Ptr->address;
+	if(g_address != UART_NO_ADDRESS)
+	{
+		SET_BIT(UCSRA,MPCM);
+	}
 	/****************************************************************************/
 	/*Clear UCSRB register
 	 * 1. Clears UCSZ2 bit in case of data frame less than 9-bit
 	 * 2. Disable RX Complete, Data Register Empty and TX complete Interrupts*/
 	UCSRB=0;
+	/*UCSZ2 bit in case of 9-bit data frame*/
+	UCSRB=(UCSRB&0xFB) | (((Config_Ptr->characterSize)>>2)<<UCSZ2);
 	#if(UART_MODE == UART_INTERRUPT)
 	/*Enable RX Complete Interrupt for receiving API with interrupts*/
 		SET_BIT(UCSRB,RXCIE);
@@ -101,7 +134,7 @@ void UART_init(const UART_ConfigType * Config_Ptr)
 	/*Enable URSEL bit to write in UCSRC register*/
 	SET_BIT(UCSRC,URSEL);
 	/*3. Inserts character size type (data frame number of bits) in UCSZ1:0 bits in UCSRC register*/
-	UCSRC=(UCSRC&0xF9) | ((Config_Ptr->characterSize)<<UCSZ0);
+	UCSRC=(UCSRC&0xF9) | (((Config_Ptr->characterSize)&0x03)<<UCSZ0);
 	/*4. Inserts parity mode type in UPM1:0 bits in UCSRC register*/
 	UCSRC=(UCSRC&0xCF) | ((Config_Ptr->parity)<<UPM0);
 	/****************************************************************************/
@@ -117,35 +150,94 @@ void UART_init(const UART_ConfigType * Config_Ptr)
 
 /*Description: This function sends a byte of data by UART protocol*/
 void UART_sendByte(const uint8 data)
+{
+	UART_sendFrame(data);
+}
+
+/*Description: This function sends a frame of 5-9 bits by UART protocol*/
+void UART_sendFrame(const uint16 data)
 {
 	/*Busy-wait loop till the UDR register is empty to transmit data*/
 	while(IS_BIT_CLEAR(UCSRA,UDRE));
 	/*Once the UDRE flag is set, the buffer is empty to put data inside it
 	 *to be transmitted and the flag will be cleared automatically again when
 	 *data is put inside UDR register*/
-	/*Handle the 8th bit and insert it in TXB8 bit in USCRB register in case
-	 *of 9-bits data frame*/
-	if(IS_BIT_SET(data,8))
+	/*Handle the 9th bit and insert it in TXB8 bit in USCRB register in case
+	 *of 9-bits data frame, it shall be written before UDR*/
+	if(data & UART_ADDRESS_BIT)
 	{
 		SET_BIT(UCSRB,TXB8);
 	}
-	UDR=data;
+	else
+	{
+		CLEAR_BIT(UCSRB,TXB8);
+	}
+	TRACE_EVENT(TRACE_UART_TX,data);
+	UDR=(uint8)data;
+}
+
+/*Description: This function sends an address frame on a multi-drop bus*/
+void UART_sendAddress(const uint8 address)
+{
+	UART_sendFrame(UART_ADDRESS_BIT | address);
 }
 
 #if(UART_MODE == UART_POLLING)
 /*Description: This function receives a byte using UART protocol*/
 uint8 UART_receiveByte(void)
 {
-	/*Busy-wait loop till the buffer is full with data to read it*/
-	while(IS_BIT_CLEAR(UCSRA,RXC));
-	/*Error Checking*/
+	uint16 frame;
+	PROBE_START(PROBE_LINK_RX);
+	TRACE_BEGIN(TRACE_UART_RX,0);
+	/*Address frames select or deselect this node and aren't returned*/
+	do
+	{
+		frame=UART_receiveFrame();
+	}while(UART_takeAddress(frame));
+	PROBE_STOP(PROBE_LINK_RX);
+	TRACE_END(TRACE_UART_RX,frame);
+	return (uint8)frame;
+}
+
+/*Description: This function receives a frame of 5-9 bits using UART protocol*/
+uint16 UART_receiveFrame(void)
+{
+	uint16 frame;
+	uint8 sreg=SREG;
+	/*Sleep till the buffer is full with data to read it, RX complete interrupt wakes the CPU.
+	 *Interrupts are enabled only by the sleep, the caller's state is restored after*/
+	cli();
+	while(IS_BIT_CLEAR(UCSRA,RXC))
+	{
+		UART_armWake();
+		IDLE_sleep();
+		cli();
+	}
+	SREG=sreg;
+	/*Error Checking, the frame is read to drop it and clear RXC*/
 	if (UCSRA & ((1<<FE)|(1<<DOR)|(1<<PE)))
 	{
-		return -1;
+		frame=UDR;
+		return UART_FRAME_ERROR;
 	}
 	/*Once the RXC flag is set, the data is ready to be read from UDR register
-	 *and the flag will be cleared automatically when the data is read from UDR buffer*/
-	return UDR;
+	 *and the flag will be cleared automatically when the data is read from UDR buffer,
+	 *9th bit shall be read from RXB8 before UDR*/
+	frame=IS_BIT_SET(UCSRB,RXB8) ? UART_ADDRESS_BIT : 0;
+	frame|=UDR;
+	return frame;
+}
+
+/*Description: This function returns TRUE if RXC flag is set*/
+uint8 UART_isDataReceived(void)
+{
+	return IS_BIT_SET(UCSRA,RXC) ? TRUE : FALSE;
+}
+
+/*Description: This function enables RX complete interrupt to wake the CPU*/
+void UART_armWake(void)
+{
+	SET_BIT(UCSRB,RXCIE);
 }
 #endif
 
@@ -186,3 +278,29 @@ void UART_setCallBack (void(*a_ptr)(void))
 	g_callBackPtr=a_ptr;
 }
 #endif
+
+/******************************************************************
+ * 				  Private Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function takes an address frame on a multi-drop bus: the node is
+ *selected by its address or the broadcast address (MPCM cleared, data frames received) and
+ *deselected by any other address (MPCM set, data frames filtered by hardware). It returns
+ *TRUE if the frame is an address frame taken by the node*/
+static uint8 UART_takeAddress(uint16 frame)
+{
+	if((g_address == UART_NO_ADDRESS) || (frame == UART_FRAME_ERROR) || !(frame & UART_ADDRESS_BIT))
+	{
+		return FALSE;
+	}
+	/*UCSRA is written whole, keeping U2X: a read-modify-write would write back a set TXC
+	 *flag, which clears it*/
+	if(((uint8)frame == g_address) || ((uint8)frame == UART_BROADCAST_ADDRESS))
+	{
+		UCSRA=(UCSRA & (1<<U2X));
+	}
+	else
+	{
+		UCSRA=(UCSRA & (1<<U2X)) | (1<<MPCM);
+	}
+	return TRUE;
+}
@@ -19,9 +19,10 @@
  *		3		| HMI_mainMenu
  *		4		| HMI_enterPassword
  *		5		| HMI_enterOldPassword
+ *		6		| HMI_enterAdminPassword
  *******************************************************************************************************/
-void (*func[6])(void)={HMI_welcome,HMI_setNewPassword,HMI_checkNewPassword,HMI_mainMenu,
-					   HMI_enterPassword,HMI_enterOldPassword};
+void (*func[7])(void)={HMI_welcome,HMI_setNewPassword,HMI_checkNewPassword,HMI_mainMenu,
+					   HMI_enterPassword,HMI_enterOldPassword,HMI_enterAdminPassword};
 
 /*Global variable to hold the function ID being executed,
  *initially it's 0 to execute HMI_welcome function*/
@@ -29,34 +30,67 @@ uint8 g_functionID=0;
 
 int main()
 {
-	/*Initialises LCD*/
-	LCD_init();
+	/*Enable global interrupts for keypad scan timer to operate*/
+	sei();
+	/*Start latency probes time base*/
+	PROBE_INIT();
+	/*Start the trace recorder time base*/
+	TRACE_INIT();
+	/*Boot time is counted from here till Control ECU status is known*/
+	PROBE_START(PROBE_BOOT);
+	/*Select idle sleep mode for the waits on keys and bytes*/
+	IDLE_init();
+#if(LINK_TRANSPORT == LINK_SPI)
+	/*Configuration structure for SPI module:
+	 * 1. HMI is the master of the link
+	 * 2. SCK = F_CPU/2*/
+	SPI_ConfigType SPI_Config={SPI_MASTER,SPI_F_CPU_2};
+	/*Initialises SPI module with SPI_Config structure parameters*/
+	SPI_init(&SPI_Config);
+#else
 	/*Configuration structure for UART module:
 	 * 1. Baud rate = 9600
 	 * 2. No parity bits is used (parity is disabled)
 	 * 3. One stop bit is used
-	 * 4. Data frame is 8-bit data*/
-	UART_ConfigType UART_Config={9600,NO_PARITY,ONE_STOP_BIT,EIGHT_BITS};
+	 * 4. Data frame is 8-bit data (9-bit on a multi-drop bus)
+	 * 5. HMI receives every frame, only Control ECUs are addressed*/
+	UART_ConfigType UART_Config={9600,NO_PARITY,ONE_STOP_BIT,LINK_CHARACTER_SIZE,UART_NO_ADDRESS};
 	/*Initialises UART module with UART_Config structure parameters*/
 	UART_init(&UART_Config);
+#endif
+	/*Start scanning keypad in the background, its ticks time the boot waits*/
+	KEYPAD_init();
+	/*Initialises LCD after the link, so Control ECU status pushed at reset is received
+	 *while LCD is initialised*/
+	LCD_init();
+#if(BUS_NODES != 0)
+	/*Start polling doors of the bus*/
+	BUS_init();
+#endif
 	while(1)
 	{
 		/*Call function through pointer to function from the array of pointers to functions*/
+		PROBE_START(PROBE_STATE);
+		TRACE_BEGIN(TRACE_STATE,g_functionID);
 		(*func[g_functionID])();
+		TRACE_END(TRACE_STATE,g_functionID);
+		PROBE_STOP(PROBE_STATE);
 	}
 }
 
 /******************************************************************************
  *[Function Name] : HMI_welcome
  *[Description]   : This function is the first function to run in HMI ECU:
- *					1. Displays "Door Locker" statement on LCD first row
- *					2. Displays "Press ON to cont." statement on LCD second row
- *					3. Wait until user presses ON key from keypad
+ *					1. Displays "Door Locker" statement on LCD first row, unless Control ECU
+ *					   status came in while LCD was initialised
+ *					2. Waits for the status Control ECU pushes once it has loaded its saved
+ *					   password at reset (point to point UART link only)
+ *					3. If it doesn't come (Control ECU was running before this reset, or the
+ *					   link can't carry it), asks Control ECU for it till it's answered
  *					4. Then, it clears LCD for other menus to be displayed
- *					5. Waits until Control ECU checks if there is a previously saved password or not
- *					6. If there is a previously saved password, it will take the user to main menu
+ *					5. If there is a previously saved password, it will take the user to main menu
  *					   to select what to do (open the door/change the password)
- *					7. If there is a previously saved password, it will take the user to set new
+ *					6. If there is no saved password, it will take the user to set new
  *					   password menu
  *					### g_functionID = 0 ###
  *[Arguments]     : void
@@ -64,20 +98,32 @@ int main()
  ******************************************************************************/
 void HMI_welcome(void)
 {
-	/*Display welcome message on LCD screen*/
-	LCD_displayStringRowColumn(0,3,"Door Locker");
-	/*Display a message for user to press ON to continue to other screens*/
-	LCD_displayStringRowColumn(1,0,"Press ON to cont");
-	/*Busy-wait till ON key is pressed in keypad*/
-	while(KEYPAD_getPressedKey() != 13);
-	/*Delay for the press time*/
-	_delay_ms(300);
+	/*Variable to hold if a byte came from Control ECU*/
+	uint8 received=FALSE;
+	/*First screen is drawn from HMI constants without any round trip, it's skipped if
+	 *Control ECU status is already there*/
+	if(!LINK_isDataReceived())
+	{
+		/*Display welcome message on LCD screen*/
+		LCD_displayStringRowColumn(0,3,"Door Locker");
+	}
+#if(LINK_PUSH)
+	/*Control ECU pushes its status once it's loaded at reset*/
+	received=HMI_waitByte(HMI_BOOT_STATUS_SCANS);
+#endif
+	/*Ask for the status if it didn't come, again till Control ECU answers as it may still be
+	 *starting. Control ECU of this door is selected first on a multi-drop bus*/
+	while(!received)
+	{
+		LINK_select();
+		LINK_sendByte(CHECK_FOR_SAVED_PASSWORD);
+		received=HMI_waitByte(HMI_STATUS_RETRY_SCANS);
+	}
 	/*Clears screen for further options to be displayed*/
 	LCD_clearScreen();
-	/*Check for password from Control ECU, if there is a saved password go to HMI_mainMenu function
-	 *if not, go to HMI_setNewPassword function*/
-	UART_sendByte(CHECK_FOR_SAVED_PASSWORD);
-	if(UART_receiveByte() == NO_SAVED_PASSWORD)
+	/*If there is a saved password go to HMI_mainMenu function, if not, go to
+	 *HMI_setNewPassword function*/
+	if(LINK_receiveByte() == NO_SAVED_PASSWORD)
 	{
 		/*Go to HMI_setNewPassword function to set a new password*/
 		g_functionID=1;
@@ -89,6 +135,7 @@ void HMI_welcome(void)
 		g_functionID=3;
 
 	}
+	PROBE_STOP(PROBE_BOOT);
 }
 
 
@@ -104,7 +151,7 @@ void HMI_welcome(void)
 void HMI_setNewPassword(void)
 {
 	/*Send a ready signal to Control ECU to be ready to receive the new password*/
-	UART_sendByte(HMI_ECU_READY);
+	LINK_sendByte(HMI_ECU_READY);
 	/*Variable to for loop till password size*/
 	uint8 loop_idx=0;
 	/*Display a message for user to set new password*/
@@ -116,11 +163,9 @@ void HMI_setNewPassword(void)
 	for(loop_idx=0;loop_idx<PASSWORD_SIZE;loop_idx++)
 	{
 		/*Send pressed key to Control ECU*/
-		UART_sendByte(KEYPAD_getPressedKey());
+		LINK_sendByte(KEYPAD_getPressedKey());
 		/*Display * on LCD for each pressed key*/
 		LCD_displayCharacter('*');
-		/*Delay for press time*/
-		_delay_ms(500);
 	}
 	/*Go to HMI_checkNewPassword function to ask user to re-enter password*/
 	g_functionID=2;
@@ -143,7 +188,7 @@ void HMI_setNewPassword(void)
 void HMI_checkNewPassword(void)
 {
 	/*Send a ready signal to Control ECU to be ready to receive the new password*/
-	UART_sendByte(HMI_ECU_READY);
+	LINK_sendByte(HMI_ECU_READY);
 	/*Variable to for loop till password size*/
 	uint8 loop_idx=0;
 	/*Display a message for user to reenter password*/
@@ -155,11 +200,9 @@ void HMI_checkNewPassword(void)
 	for(loop_idx=0;loop_idx<PASSWORD_SIZE;loop_idx++)
 	{
 		/*Send pressed key to Control ECU*/
-		UART_sendByte(KEYPAD_getPressedKey());
+		LINK_sendByte(KEYPAD_getPressedKey());
 		/*Display * on LCD for each pressed key*/
 		LCD_displayCharacter('*');
-		/*Delay for press time*/
-		_delay_ms(500);
 	}
 	/*Clears the screen for coming screens on LCD*/
 	LCD_clearScreen();
@@ -167,7 +210,7 @@ void HMI_checkNewPassword(void)
 	 * 1. If received signal from Control_ECU indicates a correct compare match, go to main menu
 	 * 2. If received signal from Control_ECU indicates a non-correct compare match, display
 	 *	  "wrong password" message and goes again to set a new password screen*/
-	uint8 flag=UART_receiveByte();
+	uint8 flag=LINK_receiveByte();
 	if(flag == CORRECT_NEW_PASSWORD)
 	{
 		/*Go to HMI_mainMenu*/
@@ -192,6 +235,7 @@ void HMI_checkNewPassword(void)
  *                  the user to choose one option:
  *                  1. Open the door by pressing '+' on keypad
  *                  2. Change the old password by pressing '-' on keypad
+ *                  3. Add a user by pressing '*' on keypad (not shown, administrators only)
  *					### g_functionID = 3 ###
  *[Arguments]     : void
  *[Return]        : void
@@ -204,38 +248,67 @@ void HMI_mainMenu(void)
 	LCD_displayStringRowColumn(0,0,"(+) Open Door");
 	LCD_displayStringRowColumn(1,0,"(-) Change Pass");
 
-	/*Check for pressed key if it's '+' or '-'*/
-	if(KEYPAD_getPressedKey() == '+')
+	uint8 key;
+#if(BUS_NODES != 0)
+	KEYPAD_EventType event;
+	/*Poll the doors of the bus while waiting for a key press event, then select this door
+	 *again to talk with it*/
+	do
+	{
+		BUS_service();
+	}while(!KEYPAD_getEvent(&event) || (event.kind != KEYPAD_PRESSED));
+	BUS_suspend();
+	key=event.key;
+#else
+	/*Check for pressed key if it's '+' or '-'
+	 *Key is read once as each call waits for a new key press event*/
+	key=KEYPAD_getPressedKey();
+#endif
+	if(key == '+')
 	{
-		/*Press time delay*/
-		_delay_ms(500);
 		/*Send an OPEN_DOOR signal to Control ECU to inform it that option 1 is selected*/
-		UART_sendByte(OPEN_DOOR);
+		LINK_sendByte(OPEN_DOOR);
 		/*Go to HMI_enterPassword function*/
 		g_functionID=4;
 		/*Clears the screen for coming screens on LCD*/
 		LCD_clearScreen();
 	}
-	else if(KEYPAD_getPressedKey() == '-')
+	else if(key == '-')
 	{
-		/*Press time delay*/
-		_delay_ms(500);
 		/*Send an CHANGE_PASSWORD signal to Control ECU to inform it that option 2 is selected*/
-		UART_sendByte(CHANGE_PASSWORD);
+		LINK_sendByte(CHANGE_PASSWORD);
 		/*Go to HMI_enterOldPassword function*/
 		g_functionID=5;
 		/*Clears the screen for coming screens on LCD*/
 		LCD_clearScreen();
 	}
+	else if(key == '*')
+	{
+		/*Send an ADD_USER signal to Control ECU to inform it that option 3 is selected*/
+		LINK_sendByte(ADD_USER);
+		/*Go to HMI_enterAdminPassword function*/
+		g_functionID=6;
+		/*Clears the screen for coming screens on LCD*/
+		LCD_clearScreen();
+	}
+	else if(key == PROBE_DUMP_KEY)
+	{
+		/*Diagnostic: send latency histograms, keypad counters and trace ring on the dump
+		 *channel*/
+		PROBE_DUMP();
+		HMI_DUMP_KEYPAD();
+		BUS_DUMP();
+		TRACE_DUMP();
+	}
 }
 
 /******************************************************************************
  *[Function Name] : HMI_enterPassword
  *[Description]   : This function asks the user to enter the password for open the door
  *					option and sends it to Control ECU to be checked
- *                  1. If it matches with saved password, "Unlocking door.." statement is displayed
- *                     on LCD while it's unlocking and then displays "Locking door.." statement till
- *                     it's locked. Then it goes to HMI_mainMenu function
+ *                  1. If it matches with saved password, "Door" statement is displayed on LCD
+ *                     followed by unlocked/opening icons while it's unlocking and then locked/closing
+ *                     icons till it's locked. Then it goes to HMI_mainMenu function
  *                  2. If it doesn't match, it asks the user to enter the password 2 more times
  *                     At any time of them, if it's entered correctly it will execute step(1)
  *                     If the user failed 3 times to enter the password, "THIEF!!" message is displayed
@@ -255,27 +328,35 @@ void HMI_enterPassword(void)
 	/*For loop from 0 --> password size
 	 *Each loop, send the pressed key to Control ECU*/
 	/*Send a ready signal to Control ECU to be ready to receive the new password*/
-	UART_sendByte(HMI_ECU_READY);
+	LINK_sendByte(HMI_ECU_READY);
 	for(loop_idx=0;loop_idx<PASSWORD_SIZE;loop_idx++)
 	{
 		/*Send pressed key to Control ECU*/
-		UART_sendByte(KEYPAD_getPressedKey());
+		LINK_sendByte(KEYPAD_getPressedKey());
+		/*Unlock latency is counted from the first key of password*/
+		if(loop_idx == 0)
+		{
+			PROBE_START(PROBE_UNLOCK);
+		}
 		/*Display * on LCD for each pressed key*/
 		LCD_displayCharacter('*');
-		/*Delay for press time*/
-		_delay_ms(500);
 	}
-	UART_sendByte(OPEN_DOOR);
-	uint8 key=UART_receiveByte();
+	LINK_sendByte(OPEN_DOOR);
+	uint8 key=LINK_receiveByte();
 	if(key == CORRECT_PASSWORD)
 	{
 		LCD_clearScreen();
-		while(UART_receiveByte() != DOOR_UNLOCKING);
-		LCD_displayStringRowColumn(0,0,"Unlocking door..");
-		while(UART_receiveByte() != DOOR_LOCKING);
-		LCD_clearScreen();
-		LCD_displayStringRowColumn(0,0,"Locking door..");
-		while(UART_receiveByte() != DOOR_LOCKED);
+		while(LINK_receiveByte() != DOOR_UNLOCKING);
+		PROBE_STOP(PROBE_UNLOCK);
+		/*Door status is shown as two icon cells after "Door" word, so each status change
+		 *rewrites only these two cells instead of clearing and rewriting the whole row*/
+		LCD_displayStringRowColumn(0,0,"Door");
+		LCD_displayGlyphRowColumn(0,5,LCD_GLYPH_UNLOCKED);
+		LCD_displayGlyph(LCD_GLYPH_OPENING);
+		HMI_waitDoorSignal(DOOR_LOCKING);
+		LCD_displayGlyphRowColumn(0,5,LCD_GLYPH_LOCKED);
+		LCD_displayGlyph(LCD_GLYPH_CLOSING);
+		HMI_waitDoorSignal(DOOR_LOCKED);
 		LCD_clearScreen();
 		g_functionID=3;
 	}
@@ -292,9 +373,7 @@ void HMI_enterPassword(void)
 		}
 		else
 		{
-			LCD_displayStringRowColumn(0,4,"THIEF!!!");
-			LCD_displayStringRowColumn(1,1,"SYSTEM LOCKED");
-			while(UART_receiveByte() != SYSTEM_UNLOCKED);
+			HMI_waitUnlock();
 			LCD_clearScreen();
 			g_functionID=3;
 		}
@@ -326,18 +405,16 @@ void HMI_enterOldPassword(void)
 	/*For loop from 0 --> password size
 	 *Each loop, send the pressed key to Control ECU*/
 	/*Send a ready signal to Control ECU to be ready to receive the new password*/
-	UART_sendByte(HMI_ECU_READY);
+	LINK_sendByte(HMI_ECU_READY);
 	for(loop_idx=0;loop_idx<PASSWORD_SIZE;loop_idx++)
 	{
 		/*Send pressed key to Control ECU*/
-		UART_sendByte(KEYPAD_getPressedKey());
+		LINK_sendByte(KEYPAD_getPressedKey());
 		/*Display * on LCD for each pressed key*/
 		LCD_displayCharacter('*');
-		/*Delay for press time*/
-		_delay_ms(500);
 	}
-	UART_sendByte(CHANGE_PASSWORD);
-	uint8 key=UART_receiveByte();
+	LINK_sendByte(CHANGE_PASSWORD);
+	uint8 key=LINK_receiveByte();
 	if(key == CORRECT_PASSWORD)
 	{
 		LCD_clearScreen();
@@ -356,11 +433,205 @@ void HMI_enterOldPassword(void)
 		}
 		else
 		{
-			LCD_displayStringRowColumn(0,4,"THIEF!!!");
-			LCD_displayStringRowColumn(1,1,"SYSTEM LOCKED");
-			while(UART_receiveByte() != SYSTEM_UNLOCKED);
+			HMI_waitUnlock();
+			LCD_clearScreen();
+			g_functionID=3;
+		}
+	}
+}
+
+/******************************************************************************
+ *[Function Name] : HMI_enterAdminPassword
+ *[Description]   : This function asks the user to enter an administrator's password for add
+ *					a user option and sends it to Control ECU to be checked
+ *                  1. If it's an administrator's password, system goes to HMI_setNewPassword
+ *                     function to set the password of the new user
+ *                  2. If no user can be added, "Users full" message is displayed and system
+ *                     returns back to HMI_mainMenu function
+ *                  3. If it isn't, it asks the user to enter the password 2 more times
+ *                     At any time of them, if it's entered correctly it will execute step(1)
+ *                     If the user failed 3 times to enter the password, "THIEF!!" message is displayed
+ *                     on LCD until the system is unlocked again.
+ *					### g_functionID = 6 ###
+ *[Arguments]     : void
+ *[Return]        : void
+ ******************************************************************************/
+void HMI_enterAdminPassword(void)
+{
+	/*Variable to for loop till password size*/
+	uint8 loop_idx=0;
+	/*Display a message for user to enter password*/
+	LCD_displayStringRowColumn(0,0,"Enter admin pass");
+	/*Move cursor to second row first place to display pressed key as '*'*/
+	LCD_goToRowColumn(1,0);
+	/*Send a ready signal to Control ECU to be ready to receive the password*/
+	LINK_sendByte(HMI_ECU_READY);
+	for(loop_idx=0;loop_idx<PASSWORD_SIZE;loop_idx++)
+	{
+		/*Send pressed key to Control ECU*/
+		LINK_sendByte(KEYPAD_getPressedKey());
+		/*Display * on LCD for each pressed key*/
+		LCD_displayCharacter('*');
+	}
+	LINK_sendByte(ADD_USER);
+	uint8 key=LINK_receiveByte();
+	if(key == CORRECT_PASSWORD)
+	{
+		LCD_clearScreen();
+		g_functionID=1;
+	}
+	else
+	{
+		LCD_clearScreen();
+		if(key == USERS_FULL)
+		{
+			LCD_displayStringRowColumn(0,0,"Users full");
+			_delay_ms(300);
+			LCD_clearScreen();
+			g_functionID=3;
+		}
+		else if(key == WRONG_PASSWORD)
+		{
+			LCD_displayStringRowColumn(0,0,"Wrong Password!");
+			_delay_ms(300);
+			LCD_clearScreen();
+			g_functionID=6;
+		}
+		else
+		{
+			HMI_waitUnlock();
 			LCD_clearScreen();
 			g_functionID=3;
 		}
 	}
 }
+
+/******************************************************************************
+ *[Function Name] : HMI_waitDoorSignal
+ *[Description]   : This function waits until Control ECU sends the given door timeline signal,
+ *					door contact notifications received meanwhile are shown on LCD second row
+ *[Arguments]     : uint8 signal
+ *[Return]        : void
+ ******************************************************************************/
+void HMI_waitDoorSignal(uint8 signal)
+{
+	uint8 received;
+	while((received=LINK_receiveByte()) != signal)
+	{
+		if(received == DOOR_OPENED)
+		{
+			LCD_displayStringRowColumn(1,0,"Open  ");
+		}
+		else if(received == DOOR_CLOSED)
+		{
+			LCD_displayStringRowColumn(1,0,"Closed");
+		}
+	}
+}
+
+/******************************************************************************
+ *[Function Name] : HMI_waitUnlock
+ *[Description]   : This function shows the system is locked till Control ECU unlocks it:
+ *					"THIEF!!!" on the first row and a lockout countdown on the second one, an
+ *					hourglass icon and the seconds left. Only the two digit cells are rewritten
+ *					each second, the countdown stops at 0 if the unlock signal comes late.
+ *					Keys typed ahead during lock time are dropped so they don't count as a
+ *					new trial
+ *[Arguments]     : void
+ *[Return]        : void
+ ******************************************************************************/
+void HMI_waitUnlock(void)
+{
+	uint8 seconds=HMI_LOCKOUT_SECONDS;
+	uint16 second=KEYPAD_getTicks();
+	uint16 elapsed;
+	LCD_displayStringRowColumn(0,4,"THIEF!!!");
+	LCD_displayStringRowColumn(1,1,"LOCKED");
+	LCD_displayGlyphRowColumn(1,9,LCD_GLYPH_HOURGLASS);
+	LCD_displayStringRowColumn(1,13,"s");
+	HMI_displaySeconds(seconds);
+	while(1)
+	{
+		elapsed=(uint16)(KEYPAD_getTicks()-second);
+		if(elapsed >= HMI_SECOND_SCANS)
+		{
+			second+=HMI_SECOND_SCANS;
+			if(seconds != 0)
+			{
+				seconds--;
+				HMI_displaySeconds(seconds);
+			}
+		}
+		else if(HMI_waitByte(HMI_SECOND_SCANS-elapsed) && (LINK_receiveByte() == SYSTEM_UNLOCKED))
+		{
+			break;
+		}
+	}
+	KEYPAD_flushEvents();
+}
+
+/******************************************************************************
+ *[Function Name] : HMI_displaySeconds
+ *[Description]   : This function rewrites the two digits of the lockout countdown
+ *[Arguments]     : uint8 seconds: 0 to 99
+ *[Return]        : void
+ ******************************************************************************/
+void HMI_displaySeconds(uint8 seconds)
+{
+	LCD_goToRowColumn(1,11);
+	LCD_displayCharacter((char)('0'+(seconds/10u)));
+	LCD_displayCharacter((char)('0'+(seconds%10u)));
+}
+
+#if(PROBE_ENABLE)
+/******************************************************************************
+ *[Function Name] : HMI_dumpKeypad
+ *[Description]   : This function sends the keypad counters on the probes dump channel as a
+ *					line of hex numbers: K<held keys>:<queue overflows>:<ghost scans>
+ *[Arguments]     : void
+ *[Return]        : void
+ ******************************************************************************/
+void HMI_dumpKeypad(void)
+{
+	uint16 overflows;
+	uint16 ghostScans;
+	KEYPAD_getStatistics(&overflows,&ghostScans);
+	PROBE_SEND('K');
+	PROBE_sendHex(KEYPAD_getHeldKeysCount());
+	PROBE_SEND(':');
+	PROBE_sendHex(overflows);
+	PROBE_SEND(':');
+	PROBE_sendHex(ghostScans);
+	PROBE_SEND('\n');
+}
+#endif
+
+/******************************************************************************
+ *[Function Name] : HMI_waitByte
+ *[Description]   : This function waits for a byte from Control ECU for a given time at most,
+ *					the CPU sleeps till the byte or the keypad scan tick wakes it
+ *[Arguments]     : uint16 scans: time to wait in keypad scan ticks
+ *[Return]        : uint8: TRUE if a byte came, FALSE on time out
+ ******************************************************************************/
+uint8 HMI_waitByte(uint16 scans)
+{
+	uint16 start=KEYPAD_getTicks();
+	uint8 sreg=SREG;
+	while(1)
+	{
+		cli();
+		if(LINK_isDataReceived())
+		{
+			SREG=sreg;
+			return TRUE;
+		}
+		if((uint16)(KEYPAD_getTicks()-start) >= scans)
+		{
+			SREG=sreg;
+			return FALSE;
+		}
+		LINK_armWake();
+		IDLE_sleep();
+		SREG=sreg;
+	}
+}
@@ -13,7 +13,12 @@
  ******************************************************************/
 #include "lcd.h"
 #include "keypad.h"
-#include "uart.h"
+#include "link.h"
+#include "probe.h"
+#include "trace.h"
+#include "idle.h"
+#include "bus.h"
+#include "soft_uart.h"
 
 /******************************************************************
  * 				  			  Macros					          *
@@ -35,21 +40,49 @@
 #define OPEN_DOOR					0x23
 #define CHANGE_PASSWORD				0x24
 #define CHECK_DONE					0x25
+/*Door contact notifications of Control ECU while the door timeline runs*/
+#define DOOR_OPENED					0x2E
+#define DOOR_CLOSED					0x2F
 #define KEY_RECEIVED				0x30
+/*Option to add a user, taken with an administrator's password, and the answer if no user
+ *can be added*/
+#define ADD_USER					0x31
+#define USERS_FULL					0x32
+/*Time HMI waits for the status Control ECU pushes at reset, then the period it asks for it
+ *at, in msec and in keypad scan ticks they're counted in*/
+#define HMI_BOOT_STATUS_MS			100u
+#define HMI_STATUS_RETRY_MS			250u
+#define HMI_BOOT_STATUS_SCANS		(HMI_BOOT_STATUS_MS/KEYPAD_SCAN_PERIOD_MS)
+#define HMI_STATUS_RETRY_SCANS		(HMI_STATUS_RETRY_MS/KEYPAD_SCAN_PERIOD_MS)
+/*Lockout time after 3 wrong passwords, the buzzer time of the alarm timeline of Control ECU,
+ *counted down on LCD in seconds of keypad scan ticks*/
+#define HMI_LOCKOUT_SECONDS			60u
+#define HMI_SECOND_SCANS			(1000u/KEYPAD_SCAN_PERIOD_MS)
+/******************************************************************
+ * 						Function-like Macros					  *
+ ******************************************************************/
+#if(PROBE_ENABLE)
+#define HMI_DUMP_KEYPAD()			HMI_dumpKeypad()
+#else
+#define HMI_DUMP_KEYPAD()			((void)0)
+#endif
+
 /******************************************************************
  * 				    Public Functions Prototypes					  *
  ******************************************************************/
 /******************************************************************************
  *[Function Name] : HMI_welcome
  *[Description]   : This function is the first function to run in HMI ECU:
- *					1. Displays "Door Locker" statement on LCD first row
- *					2. Displays "Press ON to cont." statement on LCD second row
- *					3. Wait until user presses ON key from keypad
+ *					1. Displays "Door Locker" statement on LCD first row, unless Control ECU
+ *					   status came in while LCD was initialised
+ *					2. Waits for the status Control ECU pushes once it has loaded its saved
+ *					   password at reset (point to point UART link only)
+ *					3. If it doesn't come (Control ECU was running before this reset, or the
+ *					   link can't carry it), asks Control ECU for it till it's answered
  *					4. Then, it clears LCD for other menus to be displayed
- *					5. Waits until Control ECU checks if there is a previously saved password or not
- *					6. If there is a previously saved password, it will take the user to main menu
+ *					5. If there is a previously saved password, it will take the user to main menu
  *					   to select what to do (open the door/change the password)
- *					7. If there is a previously saved password, it will take the user to set new
+ *					6. If there is no saved password, it will take the user to set new
  *					   password menu
  *					### g_functionID = 0 ###
  *[Arguments]     : void
@@ -88,6 +121,7 @@ void HMI_checkNewPassword(void);
  *                  the user to choose one option:
  *                  1. Open the door by pressing '+' on keypad
  *                  2. Change the old password by pressing '-' on keypad
+ *                  3. Add a user by pressing '*' on keypad (not shown, administrators only)
  *					### g_functionID = 3 ###
  *[Arguments]     : void
  *[Return]        : void
@@ -98,9 +132,9 @@ void HMI_mainMenu(void);
  *[Function Name] : HMI_enterPassword
  *[Description]   : This function asks the user to enter the password for open the door
  *					option and sends it to Control ECU to be checked
- *                  1. If it matches with saved password, "Unlocking door.." statement is displayed
- *                     on LCD while it's unlocking and then displays "Locking door.." statement till
- *                     it's locked. Then it goes to HMI_mainMenu function
+ *                  1. If it matches with saved password, "Door" statement is displayed on LCD
+ *                     followed by unlocked/opening icons while it's unlocking and then locked/closing
+ *                     icons till it's locked. Then it goes to HMI_mainMenu function
  *                  2. If it doesn't match, it asks the user to enter the password 2 more times
  *                     At any time of them, if it's entered correctly it will execute step(1)
  *                     If the user failed 3 times to enter the password, "THIEF!!" message is displayed
@@ -126,4 +160,72 @@ void HMI_enterPassword(void);
  ******************************************************************************/
 void HMI_enterOldPassword(void);
 
+/******************************************************************************
+ *[Function Name] : HMI_enterAdminPassword
+ *[Description]   : This function asks the user to enter an administrator's password for add
+ *					a user option and sends it to Control ECU to be checked
+ *                  1. If it's an administrator's password, system goes to HMI_setNewPassword
+ *                     function to set the password of the new user
+ *                  2. If no user can be added, "Users full" message is displayed and system
+ *                     returns back to HMI_mainMenu function
+ *                  3. If it isn't, it asks the user to enter the password 2 more times
+ *                     At any time of them, if it's entered correctly it will execute step(1)
+ *                     If the user failed 3 times to enter the password, "THIEF!!" message is displayed
+ *                     on LCD until the system is unlocked again.
+ *					### g_functionID = 6 ###
+ *[Arguments]     : void
+ *[Return]        : void
+ ******************************************************************************/
+void HMI_enterAdminPassword(void);
+
+/******************************************************************************
+ *[Function Name] : HMI_waitDoorSignal
+ *[Description]   : This function waits until Control ECU sends the given door timeline signal,
+ *					door contact notifications received meanwhile are shown on LCD second row
+ *[Arguments]     : uint8 signal
+ *[Return]        : void
+ ******************************************************************************/
+void HMI_waitDoorSignal(uint8 signal);
+
+/******************************************************************************
+ *[Function Name] : HMI_waitUnlock
+ *[Description]   : This function shows the system is locked till Control ECU unlocks it:
+ *					"THIEF!!!" on the first row and a lockout countdown on the second one, an
+ *					hourglass icon and the seconds left. Only the two digit cells are rewritten
+ *					each second, the countdown stops at 0 if the unlock signal comes late.
+ *					Keys typed ahead during lock time are dropped so they don't count as a
+ *					new trial
+ *[Arguments]     : void
+ *[Return]        : void
+ ******************************************************************************/
+void HMI_waitUnlock(void);
+
+/******************************************************************************
+ *[Function Name] : HMI_displaySeconds
+ *[Description]   : This function rewrites the two digits of the lockout countdown
+ *[Arguments]     : uint8 seconds: 0 to 99
+ *[Return]        : void
+ ******************************************************************************/
+void HMI_displaySeconds(uint8 seconds);
+
+#if(PROBE_ENABLE)
+/******************************************************************************
+ *[Function Name] : HMI_dumpKeypad
+ *[Description]   : This function sends the keypad counters on the probes dump channel as a
+ *					line of hex numbers: K<held keys>:<queue overflows>:<ghost scans>
+ *[Arguments]     : void
+ *[Return]        : void
+ ******************************************************************************/
+void HMI_dumpKeypad(void);
+#endif
+
+/******************************************************************************
+ *[Function Name] : HMI_waitByte
+ *[Description]   : This function waits for a byte from Control ECU for a given time at most,
+ *					the byte is left in the link to be received
+ *[Arguments]     : uint16 scans: time to wait in keypad scan ticks
+ *[Return]        : uint8: TRUE if a byte came, FALSE on time out
+ ******************************************************************************/
+uint8 HMI_waitByte(uint16 scans);
+
 #endif /* HMI_ECU_H_ */
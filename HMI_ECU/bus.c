@@ -0,0 +1,265 @@
+/*******************************************************************************************
+ * [FILE NAME]:		bus.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains implementation of the bus master scheduler which
+ * 					polls the doors of a multi-drop UART bus
+ *******************************************************************************************/
+
+#include "bus.h"
+#include "soft_uart.h"
+
+#if(BUS_NODES != 0)
+/*Reply timeout in clock ticks*/
+#define BUS_REPLY_TIMEOUT		(BUS_REPLY_TIMEOUT_US/CLOCK_TICK_US)
+/*Time of a clock period in micro-seconds*/
+#define BUS_PERIOD_US			(CLOCK_TICK_US*CLOCK_PERIOD_TICKS)
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[Structure Name]		 : BUS_NodeType
+ *[Structure Description]: This structure contains the scheduling state of a door and, with
+ * 						   probes, its statistics: counts and maximums stop at their maximum
+ * 						   instead of wrapping*/
+typedef struct{
+	uint8 hold;						/*Cycles the door is kept active, 0 if it's idle*/
+#if(PROBE_ENABLE)
+	uint8 polled;					/*lastPoll is valid, polls weren't suspended since*/
+	uint16 lastPoll;				/*Clock periods*/
+	uint16 polls;
+	uint16 missed;
+	uint16 maxReply;				/*Clock ticks*/
+	uint16 maxInterval;				/*Clock periods*/
+	uint8 count[BUS_BUCKETS];
+#endif
+}BUS_NodeType;
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+static BUS_NodeType g_nodes[BUS_NODES];
+/*Door polled next and the current cycle*/
+static uint8 g_next=0;
+static uint8 g_cycle=0;
+
+/******************************************************************
+ * 				  Private Functions Prototypes					  *
+ ******************************************************************/
+static uint8 BUS_isDue(uint8 index);
+static void BUS_poll(uint8 index);
+#if(PROBE_ENABLE)
+static void BUS_countInterval(BUS_NodeType * node, uint16 periods);
+#endif
+
+/******************************************************************
+ * 				  Public Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function clears the doors table, starts a new cycle and the clock*/
+void BUS_init(void)
+{
+	uint8 i;
+#if(PROBE_ENABLE)
+	uint8 bucket;
+#endif
+	for(i=0;i<BUS_NODES;i++)
+	{
+		g_nodes[i].hold=0;
+#if(PROBE_ENABLE)
+		g_nodes[i].polled=FALSE;
+		g_nodes[i].polls=0;
+		g_nodes[i].missed=0;
+		g_nodes[i].maxReply=0;
+		g_nodes[i].maxInterval=0;
+		for(bucket=0;bucket<BUS_BUCKETS;bucket++)
+		{
+			g_nodes[i].count[bucket]=0;
+		}
+#endif
+	}
+	g_next=0;
+	g_cycle=0;
+	CLOCK_init();
+}
+
+/*Description: This function finds the next door due in the cycle and polls it, a cycle
+ *ends when the round reaches the first door again. Idle doors are spread over the
+ *BUS_IDLE_DIVIDER cycles by their index, a cycle with no door due takes no time*/
+void BUS_service(void)
+{
+	while(!BUS_isDue(g_next))
+	{
+		g_next++;
+		if(g_next == BUS_NODES)
+		{
+			g_next=0;
+			g_cycle++;
+		}
+	}
+	BUS_poll(g_next);
+	g_next++;
+	if(g_next == BUS_NODES)
+	{
+		g_next=0;
+		g_cycle++;
+	}
+}
+
+/*Description: This function selects HMI's own door again, intervals restart at next poll*/
+void BUS_suspend(void)
+{
+#if(PROBE_ENABLE)
+	uint8 i;
+	for(i=0;i<BUS_NODES;i++)
+	{
+		g_nodes[i].polled=FALSE;
+	}
+#endif
+	LINK_select();
+}
+
+#if(PROBE_ENABLE)
+/*Description: This function sends a line per door which was polled*/
+void BUS_dump(void)
+{
+	BUS_NodeType * node;
+	uint8 i;
+	uint8 last;
+	uint8 bucket;
+	for(i=0;i<BUS_NODES;i++)
+	{
+		node=&g_nodes[i];
+		if(node->polls == 0)
+		{
+			continue;
+		}
+		for(last=BUS_BUCKETS;(last != 0) && (node->count[last-1] == 0);last--);
+		PROBE_SEND('B');
+		PROBE_sendHex(BUS_FIRST_ADDRESS+i);
+		PROBE_SEND(':');
+		PROBE_sendHex(CLOCK_TICK_US);
+		PROBE_SEND(':');
+		PROBE_sendHex(node->polls);
+		PROBE_SEND(':');
+		PROBE_sendHex(node->missed);
+		PROBE_SEND(':');
+		PROBE_sendHex(node->maxReply);
+		PROBE_SEND(':');
+		PROBE_sendHex(node->maxInterval);
+		PROBE_SEND(':');
+		PROBE_sendHex(((node->hold != 0) ? BUS_ACTIVE_WORST_US : BUS_IDLE_WORST_US)/BUS_PERIOD_US);
+		PROBE_SEND(':');
+		for(bucket=0;bucket<last;bucket++)
+		{
+			if(bucket != 0)
+			{
+				PROBE_SEND(',');
+			}
+			PROBE_sendHex(node->count[bucket]);
+		}
+		PROBE_SEND('\n');
+	}
+}
+#endif
+
+/******************************************************************
+ * 				  Private Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function returns TRUE if a door is polled in the current cycle: active
+ *doors in every cycle, idle doors in one cycle of BUS_IDLE_DIVIDER*/
+static uint8 BUS_isDue(uint8 index)
+{
+	if(g_nodes[index].hold != 0)
+	{
+		return TRUE;
+	}
+	return (((uint8)(g_cycle+index) % BUS_IDLE_DIVIDER) == 0) ? TRUE : FALSE;
+}
+
+/*Description: This function polls a door: the address frame selects it (and deselects
+ *the others), then its status answer is waited for till the reply timeout. An active
+ *answer keeps the door active for BUS_ACTIVE_HOLD cycles, a silent door counts a miss*/
+static void BUS_poll(uint8 index)
+{
+	BUS_NodeType * node=&g_nodes[index];
+	uint32 start;
+	uint32 ticks;
+	uint16 status;
+#if(PROBE_ENABLE)
+	uint16 periods;
+#endif
+	/*Drop an answer which came after its timeout so it isn't taken for this door's*/
+	while(UART_isDataReceived())
+	{
+		UART_receiveFrame();
+	}
+	UART_sendAddress(BUS_FIRST_ADDRESS+index);
+	UART_sendByte(BUS_POLL);
+	start=CLOCK_now();
+#if(PROBE_ENABLE)
+	periods=(uint16)(start/CLOCK_PERIOD_TICKS);
+	if(node->polled)
+	{
+		BUS_countInterval(node,periods-node->lastPoll);
+	}
+	node->lastPoll=periods;
+	node->polled=TRUE;
+	if(node->polls != 0xFFFF)
+	{
+		node->polls++;
+	}
+#endif
+	if(node->hold != 0)
+	{
+		node->hold--;
+	}
+	/*Busy-wait loop till the answer arrives or the timeout*/
+	do
+	{
+		ticks=CLOCK_now()-start;
+		if(ticks >= BUS_REPLY_TIMEOUT)
+		{
+#if(PROBE_ENABLE)
+			if(node->missed != 0xFFFF)
+			{
+				node->missed++;
+			}
+#endif
+			return;
+		}
+	}while(!UART_isDataReceived());
+	status=UART_receiveFrame();
+#if(PROBE_ENABLE)
+	if(ticks > node->maxReply)
+	{
+		node->maxReply=(uint16)ticks;
+	}
+#endif
+	if(status == BUS_NODE_ACTIVE)
+	{
+		node->hold=BUS_ACTIVE_HOLD;
+	}
+}
+
+#if(PROBE_ENABLE)
+/*Description: This function counts a poll interval in the bucket of its order of
+ *magnitude (position of its highest set bit)*/
+static void BUS_countInterval(BUS_NodeType * node, uint16 periods)
+{
+	uint8 bucket=0;
+	if(periods > node->maxInterval)
+	{
+		node->maxInterval=periods;
+	}
+	while(((periods>>1) != 0) && (bucket < (BUS_BUCKETS-1)))
+	{
+		periods>>=1;
+		bucket++;
+	}
+	if(node->count[bucket] != 0xFF)
+	{
+		node->count[bucket]++;
+	}
+}
+#endif
+#endif
@@ -0,0 +1,125 @@
+/*******************************************************************************************
+ * [FILE NAME]:		bus.h
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This header file contains static configurations and function prototypes
+ * 					of the bus master scheduler: HMI polls the Control ECUs of several doors on
+ * 					a multi-drop UART bus (link.h, LINK_ADDRESS) in round robin while it waits
+ * 					in its main menu. HMI is the only master so the bus access is
+ * 					deterministic: a door speaks only in its poll slot.
+ * 					A door answers a poll with its status, active doors (motor or buzzer
+ * 					running, or door open) are polled each cycle and idle or silent doors each
+ * 					BUS_IDLE_DIVIDER cycles, which bounds the poll interval of every door.
+ * 					Timeouts and intervals are taken from the clock (clock.h), per door
+ * 					latency statistics are kept and dumped with the probes
+ *******************************************************************************************/
+
+#ifndef BUS_H_
+#define BUS_H_
+
+/******************************************************************
+ * 				Common Header Files Inclusion					  *
+ ******************************************************************/
+#include "micro_config.h"
+#include "std_types.h"
+#include "common_macros.h"
+#include "link.h"
+#include "clock.h"
+#include "probe.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+/*Macro to define the number of doors on the bus, at addresses BUS_FIRST_ADDRESS onwards,
+ *0 removes the scheduler*/
+#ifndef BUS_NODES
+#define BUS_NODES				0u
+#endif
+#define BUS_FIRST_ADDRESS		1u
+/*Poll signal and status answers of a door, same values in Control_ECU.h*/
+#define BUS_POLL				0x2B
+#define BUS_NODE_IDLE			0x2C
+#define BUS_NODE_ACTIVE			0x2D
+/*Macro to define the cycles between two polls of an idle door*/
+#define BUS_IDLE_DIVIDER		4u
+/*Macro to define the cycles a door is kept active after it answered active*/
+#define BUS_ACTIVE_HOLD			8u
+/*Macro to define the time a door may take to answer, counted from the poll written to UART:
+ *address and poll frames, the door's reaction and its answer frame*/
+#define BUS_REPLY_TIMEOUT_US	5000UL
+/*Longest slot of a poll: the frames are queued at once, so it's the reply timeout*/
+#define BUS_SLOT_US				BUS_REPLY_TIMEOUT_US
+/*Worst case poll interval of an active door (a cycle polls BUS_NODES doors at most) and of
+ *an idle door, that's the worst case time the master takes to see a change of a door while
+ *it polls. Number of doors a bus serves at a target response time is T/BUS_SLOT_US for
+ *active doors and T/(BUS_IDLE_DIVIDER*BUS_SLOT_US) for idle ones*/
+#define BUS_ACTIVE_WORST_US		((uint32)BUS_NODES*BUS_SLOT_US)
+#define BUS_IDLE_WORST_US		(BUS_IDLE_DIVIDER*BUS_ACTIVE_WORST_US)
+/*Macro to define the number of buckets of poll interval histograms: bucket N counts
+ *intervals of 2^N up to 2^(N+1)-1 clock periods (2.048 msec at 8 MHz) and the last one all
+ *longer intervals (262 msec and more)*/
+#define BUS_BUCKETS				8u
+
+#if(BUS_NODES != 0)
+#if((LINK_TRANSPORT != LINK_UART) || (LINK_ADDRESS == 0))
+#error "Bus scheduler needs a multi-drop UART link (LINK_ADDRESS)"
+#endif
+#endif
+
+/******************************************************************
+ * 						Function-like Macros					  *
+ ******************************************************************/
+#if((BUS_NODES != 0) && PROBE_ENABLE)
+#define BUS_DUMP()				BUS_dump()
+#else
+#define BUS_DUMP()				((void)0)
+#endif
+
+/******************************************************************
+ * 				    Public Functions Prototypes					  *
+ ******************************************************************/
+#if(BUS_NODES != 0)
+/*******************************************************************************
+ * [Function Name]	: BUS_init
+ * [Description]	: This function clears the doors table, every door starts idle, and
+ * 					  starts the clock
+ * [Arguments]		: void
+ * [Returns]		: void
+ *******************************************************************************/
+void BUS_init(void);
+
+/*******************************************************************************
+ * [Function Name]	: BUS_service
+ * [Description]	: This function polls the next door due in the current cycle: it
+ * 					  selects the door, sends BUS_POLL and waits for its status up to
+ * 					  BUS_REPLY_TIMEOUT_US. It's called repeatedly while HMI is idle
+ * [Arguments]		: void
+ * [Returns]		: void
+ *******************************************************************************/
+void BUS_service(void);
+
+/*******************************************************************************
+ * [Function Name]	: BUS_suspend
+ * [Description]	: This function stops polling to let HMI talk with its own door, which
+ * 					  is selected again. Intervals across the pause aren't counted
+ * [Arguments]		: void
+ * [Returns]		: void
+ *******************************************************************************/
+void BUS_suspend(void);
+
+#if(PROBE_ENABLE)
+/*******************************************************************************
+ * [Function Name]	: BUS_dump
+ * [Description]	: This function sends a line per door on the probes dump channel:
+ * 					  B<address>:<tick us>:<polls>:<missed>:<max reply>:<max interval>:
+ * 					  <worst case>:<bucket 0>,<bucket 1>,...<last used bucket>
+ * 					  max reply in clock ticks, intervals and worst case (as the door is
+ * 					  active or idle now) in clock periods of 256 ticks
+ * [Arguments]		: void
+ * [Returns]		: void
+ *******************************************************************************/
+void BUS_dump(void);
+#endif
+#endif
+
+#endif /* BUS_H_ */
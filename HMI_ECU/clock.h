@@ -0,0 +1,62 @@
+/*******************************************************************************************
+ * [FILE NAME]:		clock.h
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This header file contains static configurations and function prototypes
+ * 					of the time base: TIMER0 runs free at F_CPU/64 (normal mode, Control's
+ * 					motor driver sets fast PWM mode which keeps the same period) and its
+ * 					overflow interrupt counts periods of 256 ticks. Probes, trace, the bus
+ * 					scheduler and the tick service of Control all take their time from it
+ *******************************************************************************************/
+
+#ifndef CLOCK_H_
+#define CLOCK_H_
+
+/******************************************************************
+ * 				Common Header Files Inclusion					  *
+ ******************************************************************/
+#include "micro_config.h"
+#include "std_types.h"
+#include "common_macros.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+/*Macro to define the time of a clock tick in micro-seconds (TIMER0 at F_CPU/64)*/
+#define CLOCK_TICK_US			(64000000UL/F_CPU)
+/*Macro to define the ticks of a period, between two TIMER0 overflows*/
+#define CLOCK_PERIOD_TICKS		256u
+
+/******************************************************************
+ * 				    Public Functions Prototypes					  *
+ ******************************************************************/
+/*******************************************************************************
+ * [Function Name]	: CLOCK_init
+ * [Description]	: This function starts TIMER0 in normal mode at F_CPU/64 if nothing
+ * 					  runs it yet and enables its overflow interrupt, it may be called by
+ * 					  each module taking its time from the clock. Global interrupts shall
+ * 					  be enabled
+ * [Arguments]		: void
+ * [Returns]		: void
+ *******************************************************************************/
+void CLOCK_init(void);
+
+/*******************************************************************************
+ * [Function Name]	: CLOCK_now
+ * [Description]	: This function returns the time in clock ticks since the clock was
+ * 					  started
+ * [Arguments]		: void
+ * [Returns]		: uint32
+ *******************************************************************************/
+uint32 CLOCK_now(void);
+
+/*******************************************************************************
+ * [Function Name]	: CLOCK_setOverflowCallBack
+ * [Description]	: This function sets the function called from TIMER0 overflow
+ * 					  interrupt after the period is counted
+ * [Arguments]		: void(*a_ptr)(void): callback
+ * [Returns]		: void
+ *******************************************************************************/
+void CLOCK_setOverflowCallBack(void(*a_ptr)(void));
+
+#endif /* CLOCK_H_ */
@@ -0,0 +1,65 @@
+/*******************************************************************************************
+ * [FILE NAME]:		idle.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains implementation of the idle manager in AVR
+ * 					ATMEGA-16 Micro-controller
+ *******************************************************************************************/
+
+#include "idle.h"
+
+#if(IDLE_ENABLE && PROBE_ENABLE)
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+/*The CPU sleeps and no interrupt marked its wake yet*/
+static volatile uint8 g_asleep=FALSE;
+#endif
+
+/******************************************************************
+ * 				  Public Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function selects idle mode (SM2:0 = 0) as sleep mode*/
+void IDLE_init(void)
+{
+	set_sleep_mode(SLEEP_MODE_IDLE);
+}
+
+/*Description: This function sleeps till an interrupt. The sleep instruction follows sei,
+ *and the instruction after sei always runs before any pending interrupt, so such an
+ *interrupt wakes the CPU from the sleep instead of being served before it. Time asleep is
+ *counted by PROBE_SLEEP and the time from the waking interrupt till the waiting code runs
+ *again by PROBE_WAKE (when the interrupt marked the wake)*/
+void IDLE_sleep(void)
+{
+#if(IDLE_ENABLE)
+	PROBE_START(PROBE_SLEEP);
+#if(PROBE_ENABLE)
+	g_asleep=TRUE;
+#endif
+	sleep_enable();
+	sei();
+	sleep_cpu();
+	sleep_disable();
+#if(PROBE_ENABLE)
+	g_asleep=FALSE;
+#endif
+	PROBE_STOP(PROBE_SLEEP);
+	PROBE_STOP(PROBE_WAKE);
+#else
+	sei();
+#endif
+}
+
+#if(IDLE_ENABLE && PROBE_ENABLE)
+/*Description: This function marks the wake of a sleeping CPU, only the first interrupt
+ *after the sleep starts the wake latency probe*/
+void IDLE_wake(void)
+{
+	if(g_asleep)
+	{
+		g_asleep=FALSE;
+		PROBE_START(PROBE_WAKE);
+	}
+}
+#endif
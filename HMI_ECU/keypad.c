@@ -6,140 +6,354 @@
  ***********************************************************************************************/
 
 #include "keypad.h"
+#include "idle.h"
 
 /******************************************************************
  * 				  Private Functions Prototypes					  *
  ******************************************************************/
-#if (N_COL == 3)
-/*[Function Name] : KEYPAD_4x3_adjustKeyNumber
- *[Description]	  : This function to map the switch number in the 4x3 keypad to its functional
- *					number on proteus 4x3 keypad
- *[Arguments]     : uint8 button_number
- *						This is the input number of pressed button in 4x3 keypad
- *[Return]        : uint8
- *						This function returns a uint8 variable holding functional key
- *						of input number*/
-static uint8 KEYPAD_4x3_adjustKeyNumber (uint8 button_number);
-
-#elif (N_COL == 4)
-/*[Function Name] : KEYPAD_4x4_adjustKeyNumber
- *[Description]	  : This function to map the switch number in the 4x3 keypad to its functional
- *					number on proteus 4x4 keypad
- *[Arguments]     : uint8 button_number
- *						This is the input number of pressed button in 4x3 keypad
- *[Return]        : uint8
- *						This function returns a uint8 variable holding functional key
- *						of input number*/
-static uint8 KEYPAD_4x4_adjustKeyNumber (uint8 button_number);
-#endif
+/*[Function Name] : KEYPAD_pushEvent
+ *[Description]	  : This function maps the switch to its functional key through the selected
+ *					keymap and adds an event at the tail of keypad queue, the event is dropped
+ *					if the queue is full or the switch has no key in the keymap
+ *[Arguments]     : uint8 scan_code
+ *						This is the number of the switch in keypad matrix (row*N_COL+col)
+ *					KEYPAD_EventKind kind
+ *						This is the kind of the event (pressed/released)
+ *[Return]        : void*/
+static void KEYPAD_pushEvent (uint8 scan_code, KEYPAD_EventKind kind);
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+/*Configuration structure for TIMER1 module to scan the keypad:
+ * 1. Compare match (CTC) mode
+ * 2. Prescalar = 64 --> T_Timer = 8 usec
+ * 3. Initial value = 0
+ * 4. Compare value = 624 --> Interrupt every 5 msec*/
+static const TIMER1_ConfigType g_keypadTimerConfig={CTC,F_CPU_64,0,KEYPAD_SCAN_COMPARE_VAL};
+
+/*Keymaps saved in flash, each one maps the switch scan code (row*N_COL+col) to its functional key
+ *Indexed by KEYPAD_Layout enum. HMI menus take '+' (open door), '-' (change password), '*' (add
+ *a user) and '=' (diagnostic dump) besides the digits*/
+static const uint8 g_keymaps[KEYPAD_LAYOUT_COUNT][N_ROW*N_COL] PROGMEM = {
+	/*KEYPAD_PROTEUS_4X4*/
+	{7,  8,  9,  '%',
+	 4,  5,  6,  '*',
+	 1,  2,  3,  '-',
+	 13, 0,  '=','+'},
+	/*KEYPAD_PHONE_4X3, 4th column is not connected. Its 12 keys are the digits, '*' and '#',
+	 *which give the two main menu options '+' and '-', so it has no add user or dump key*/
+	{1,  2,  3,  KEYPAD_NO_KEY,
+	 4,  5,  6,  KEYPAD_NO_KEY,
+	 7,  8,  9,  KEYPAD_NO_KEY,
+	 '+',0,  '-',KEYPAD_NO_KEY},
+	/*KEYPAD_ACCESS_PANEL, ON key is placed at the bottom right corner and the key above it
+	 *dumps diagnostics*/
+	{1,  2,  3,  '+',
+	 4,  5,  6,  '-',
+	 7,  8,  9,  '=',
+	 '*',0,  '#',13}
+};
+
+/*Keymap used to decode the scanned switches and the one selected to replace it once no key
+ *is held, so the press and release of a key are decoded with the same keymap*/
+static volatile KEYPAD_Layout g_layout=KEYPAD_LAYOUT;
+static volatile KEYPAD_Layout g_nextLayout=KEYPAD_LAYOUT;
+
+/*Debounce integrator of each switch, it counts up each scan the switch is closed
+ *and down each scan it's open between 0 and KEYPAD_DEBOUNCE_SCANS*/
+static uint8 g_integrator[N_ROW*N_COL];
+
+/*Debounced state of each switch, bit (scan code) is set while the switch is pressed*/
+static volatile uint16 g_keyState=0;
+
+/*Number of scans done since KEYPAD_init, used as time stamp of events*/
+static volatile uint16 g_scanTicks=0;
+
+/*Circular queue of keypad events filled by KEYPAD_scan and emptied by KEYPAD_getEvent,
+ *keys pressed while the application is busy wait in it till they're read (type-ahead)*/
+static volatile KEYPAD_EventType g_eventQueue[KEYPAD_QUEUE_SIZE];
+static volatile uint8 g_queueHead=0;
+static volatile uint8 g_queueTail=0;
+
+/*Number of events dropped as the queue was full*/
+static volatile uint16 g_queueOverflows=0;
+
+/*Number of scans which found switches that may be ghosts of other pressed switches*/
+static volatile uint16 g_ghostScans=0;
 
 /******************************************************************
  * 				  	  Functions Definitions				 		  *
  ******************************************************************/
-/*[Function Name] : KEYPAD_getPressedKey
- *[Description]	  : This function gets the value of pressed key on keypad
+/*[Function Name] : KEYPAD_init
+ *[Description]	  : This function selects the keymap of the build (KEYPAD_LAYOUT) and starts
+ *					TIMER1 to scan the keypad every KEYPAD_SCAN_PERIOD_MS in the background,
+ *					global interrupts shall be enabled
  *[Arguments]     : void
- *[Return]        : uint8
- *					This function returns a uint8 variable holding data of
- *					pressed key*/
-uint8 KEYPAD_getPressedKey (void)
+ *[Return]        : void*/
+void KEYPAD_init (void)
 {
-	uint8 col,row;
-	while(1)
+	KEYPAD_setLayout(KEYPAD_LAYOUT);
+	TIMER1_setCallBack(KEYPAD_scan);
+	TIMER1_init(&g_keypadTimerConfig);
+}
+
+/*[Function Name] : KEYPAD_scan
+ *[Description]	  : This function scans all keypad switches once, debounces each switch alone
+ *					and queues an event for each accepted press/release:
+ *					1. Reads the whole matrix so any number of held keys are seen (n-key rollover)
+ *					2. Finds switches which may be ghosts of other pressed switches and holds
+ *					   them from being accepted as pressed till the matrix is unambiguous again
+ *					It's the TIMER1 callback function so it runs in interrupt context
+ *[Arguments]     : void
+ *[Return]        : void*/
+void KEYPAD_scan (void)
+{
+	uint8 col,row,other,button;
+	/*Columns read closed in each row during this scan*/
+	uint8 rowCols[N_ROW];
+	/*Switches that can't be told from ghosts during this scan*/
+	uint16 ghostMask=0;
+	uint8 common;
+	g_scanTicks++;
+	for(row=0;row<N_ROW;row++)
+	{
+		rowCols[row]=0;
+	}
+	for(col=0;col<N_COL;col++)
+	{
+		/*Each loop, set a column to be output at a time
+		 *and clear the first 4 pins to be input pins for the rows*/
+		KEYPAD_PORT_DIRECTION = (0b00010000<<col);
+		/*Each loop, column output is 0 at a time
+		 *and set the first 4 pins to use internal pull-up resistor for each row*/
+		KEYPAD_PORT_OUT = ~(0b00010000<<col);
+		for(row=0;row<N_ROW;row++)
+		{
+			if(IS_BIT_CLEAR(KEYPAD_PORT_IN,row))
+			{
+				SET_BIT(rowCols[row],col);
+			}
+		}
+	}
+	/*Keypad has no diodes, so if 3 corners of a rectangle are pressed the 4th corner reads
+	 *pressed too. Any two rows sharing 2 or more closed columns are ambiguous*/
+	for(row=0;row<N_ROW;row++)
+	{
+		for(other=row+1;other<N_ROW;other++)
+		{
+			common=rowCols[row] & rowCols[other];
+			if(common & (common-1))
+			{
+				ghostMask |= ((uint16)common<<(row*N_COL)) | ((uint16)common<<(other*N_COL));
+			}
+		}
+	}
+	if(ghostMask != 0)
+	{
+		g_ghostScans++;
+	}
+	for(row=0;row<N_ROW;row++)
 	{
-		for(col=0;col<4;col++)
+		for(col=0;col<N_COL;col++)
 		{
-			/*Each loop, set a column to be output at a time
-			 *and clear the first 4 pins to be input pins for the rows*/
-			KEYPAD_PORT_DIRECTION = (0b00010000<<col);
-			/*Each loop, column output is 0 at a time
-			 *and set the first 4 pins to use internal pull-up resistor for each row*/
-			KEYPAD_PORT_OUT = ~(0b00010000<<col);
-			for(row=0;row<N_ROW;row++)
+			button=(row*N_COL)+col;
+			if(IS_BIT_SET(rowCols[row],col))
 			{
-				if(IS_BIT_CLEAR(KEYPAD_PORT_IN,row))
+				/*Switch may be a ghost, don't accept it as a new press*/
+				if(IS_BIT_SET(ghostMask,button) && IS_BIT_CLEAR(g_keyState,button))
 				{
-					#if (N_COL == 3)
-						return KEYPAD_4x3_adjustKeyNumber((row*N_COL)+col+1);
-					#elif (N_COL == 4)
-						return KEYPAD_4x4_adjustKeyNumber((row*N_COL)+col+1);
-					#endif
+					continue;
+				}
+				/*Switch is closed, integrate up till it's accepted as pressed*/
+				if(g_integrator[button] < KEYPAD_DEBOUNCE_SCANS)
+				{
+					g_integrator[button]++;
+					if((g_integrator[button] == KEYPAD_DEBOUNCE_SCANS) && IS_BIT_CLEAR(g_keyState,button))
+					{
+						SET_BIT(g_keyState,button);
+						KEYPAD_pushEvent(button,KEYPAD_PRESSED);
+					}
+				}
+			}
+			else
+			{
+				/*Switch is open, integrate down till it's accepted as released*/
+				if(g_integrator[button] > 0)
+				{
+					g_integrator[button]--;
+					if((g_integrator[button] == 0) && IS_BIT_SET(g_keyState,button))
+					{
+						CLEAR_BIT(g_keyState,button);
+						KEYPAD_pushEvent(button,KEYPAD_RELEASED);
+					}
 				}
 			}
 		}
 	}
+	/*A new keymap is taken only while no key is held*/
+	if(g_keyState == 0)
+	{
+		g_layout=g_nextLayout;
+	}
+}
+
+/*[Function Name] : KEYPAD_pushEvent
+ *[Description]	  : This function maps the switch to its functional key through the selected
+ *					keymap and adds an event at the tail of keypad queue, the event is dropped
+ *					if the queue is full or the switch has no key in the keymap
+ *[Arguments]     : uint8 scan_code
+ *						This is the number of the switch in keypad matrix (row*N_COL+col)
+ *					KEYPAD_EventKind kind
+ *						This is the kind of the event (pressed/released)
+ *[Return]        : void*/
+static void KEYPAD_pushEvent (uint8 scan_code, KEYPAD_EventKind kind)
+{
+	uint8 next=(g_queueTail+1) & KEYPAD_QUEUE_MASK;
+	uint8 key=pgm_read_byte(&g_keymaps[g_layout][scan_code]);
+	if(key == KEYPAD_NO_KEY)
+	{
+		/*Switch isn't connected in this layout*/
+		return;
+	}
+	if(next == g_queueHead)
+	{
+		/*Queue is full, count the lost event*/
+		g_queueOverflows++;
+		return;
+	}
+	g_eventQueue[g_queueTail].key=key;
+	g_eventQueue[g_queueTail].kind=kind;
+	g_eventQueue[g_queueTail].time=g_scanTicks;
+	g_queueTail=next;
+}
+
+/*[Function Name] : KEYPAD_setLayout
+ *[Description]	  : This function selects the keymap used to decode the keypad switches, the scan
+ *					takes it once no key is held so a held key is released with the keymap it
+ *					was pressed with
+ *[Arguments]     : KEYPAD_Layout layout
+ *						This enum variable holds the keypad layout
+ *[Return]        : uint8
+ *						TRUE if the layout is selected, FALSE if it's out of range*/
+uint8 KEYPAD_setLayout (KEYPAD_Layout layout)
+{
+	if(layout >= KEYPAD_LAYOUT_COUNT)
+	{
+		return FALSE;
+	}
+	g_nextLayout=layout;
+	return TRUE;
 }
 
-#if (N_COL == 3)
-/*[Function Name] : KEYPAD_4x3_adjustKeyNumber
- *[Description]	  : This function to map the switch number in the 4x3 keypad to its functional
- *					number on proteus 4x3 keypad
- *[Arguments]     : uint8 button_number
- *						This is the input number of pressed button in 4x3 keypad
+/*[Function Name] : KEYPAD_getEvent
+ *[Description]	  : This function takes the oldest event out of keypad queue without waiting
+ *[Arguments]     : KEYPAD_EventType * event
+ *						This is a pointer to structure to be filled with the event
  *[Return]        : uint8
- *						This function returns a uint8 variable holding functional key
- *						of input number*/
-static uint8 KEYPAD_4x3_adjustKeyNumber (uint8 button_number)
+ *						TRUE if an event is returned, FALSE if the queue is empty*/
+uint8 KEYPAD_getEvent (KEYPAD_EventType * event)
 {
-	switch (button_number)
+	if(g_queueHead == g_queueTail)
 	{
-		case 10:return '*'; /*ASCII of '*'*/
-				break;
-		case 11:return 0;
-				break;
-		case 12:return '#'; /*ASCII of '#'*/
-				break;
-		default: return button_number;
+		return FALSE;
 	}
+	event->key=g_eventQueue[g_queueHead].key;
+	event->kind=g_eventQueue[g_queueHead].kind;
+	event->time=g_eventQueue[g_queueHead].time;
+	/*Only the consumer moves the head, so no need to disable interrupts*/
+	g_queueHead=(g_queueHead+1) & KEYPAD_QUEUE_MASK;
+	return TRUE;
 }
 
-#elif(N_COL == 4)
-/*[Function Name] : KEYPAD_4x4_adjustKeyNumber
- *[Description]	  : This function to map the switch number in the 4x3 keypad to its functional
- *					number on proteus 4x4 keypad
- *[Arguments]     : uint8 button_number
- *						This is the input number of pressed button in 4x3 keypad
+/*[Function Name] : KEYPAD_flushEvents
+ *[Description]	  : This function drops all events waiting in keypad queue (type-ahead)
+ *[Arguments]     : void
+ *[Return]        : void*/
+void KEYPAD_flushEvents (void)
+{
+	g_queueHead=g_queueTail;
+}
+
+/*[Function Name] : KEYPAD_getHeldKeysCount
+ *[Description]	  : This function gets the number of keys held down at the moment
+ *[Arguments]     : void
  *[Return]        : uint8
- *						This function returns a uint8 variable holding functional key
- *						of input number*/
-static uint8 KEYPAD_4x4_adjustKeyNumber (uint8 button_number)
+ *						Number of debounced pressed keys*/
+uint8 KEYPAD_getHeldKeysCount (void)
 {
-	switch (button_number)
+	uint8 count=0;
+	uint16 state;
+	/*16-bit state is updated from interrupt, so read it with interrupts off*/
+	uint8 sreg=SREG;
+	cli();
+	state=g_keyState;
+	SREG=sreg;
+	while(state != 0)
 	{
-		case 1:	return 7;
-				break;
-		case 2:	return 8;
-				break;
-		case 3:	return 9;
-				break;
-		case 4:	return '%'; /*ASCII of '%'*/
-				break;
-		case 5:	return 4;
-				break;
-		case 6:	return 5;
-				break;
-		case 7:	return 6;
-				break;
-		case 8:	return '*'; /*ASCII of '*'*/
-				break;
-		case 9:	return 1;
-				break;
-		case 10:return 2;
-				break;
-		case 11:return 3;
-				break;
-		case 12:return '-'; /*ASCII of '-'*/
-				break;
-		case 13:return 13;
-				break;
-		case 14:return 0;
-				break;
-		case 15:return '='; /*ASCII of '='*/
-				break;
-		case 16:return '+'; /*ASCII of '+'*/
-				break;
-		default: return button_number;
+		/*Clear the lowest set bit*/
+		state &= (state-1);
+		count++;
 	}
+	return count;
 }
-#endif
 
+/*[Function Name] : KEYPAD_getTicks
+ *[Description]	  : This function gets the number of scans since KEYPAD_init
+ *[Arguments]     : void
+ *[Return]        : uint16
+ *						Scan ticks*/
+uint16 KEYPAD_getTicks (void)
+{
+	/*16-bit counter is updated from interrupt, so read it with interrupts off*/
+	uint16 ticks;
+	uint8 sreg=SREG;
+	cli();
+	ticks=g_scanTicks;
+	SREG=sreg;
+	return ticks;
+}
+
+/*[Function Name] : KEYPAD_getStatistics
+ *[Description]	  : This function gets the keypad error counters
+ *[Arguments]     : uint16 * overflows
+ *						Pointer to be filled with number of events lost as the queue was full
+ *					uint16 * ghostScans
+ *						Pointer to be filled with number of scans that found an ambiguous matrix
+ *[Return]        : void*/
+void KEYPAD_getStatistics (uint16 * overflows, uint16 * ghostScans)
+{
+	/*16-bit counters are updated from interrupt, so read them with interrupts off*/
+	uint8 sreg=SREG;
+	cli();
+	*overflows=g_queueOverflows;
+	*ghostScans=g_ghostScans;
+	SREG=sreg;
+}
+
+/*[Function Name] : KEYPAD_getPressedKey
+ *[Description]	  : This function waits for the next key press event in keypad queue,
+ *					release events are dropped. The CPU sleeps while the queue is empty
+ *					and the scan interrupt wakes it each 5 msec
+ *[Arguments]     : void
+ *[Return]        : uint8
+ *					This function returns a uint8 variable holding data of
+ *					pressed key*/
+uint8 KEYPAD_getPressedKey (void)
+{
+	KEYPAD_EventType event;
+	uint8 sreg=SREG;
+	while(1)
+	{
+		if(KEYPAD_getEvent(&event) && (event.kind == KEYPAD_PRESSED))
+		{
+			return event.key;
+		}
+		cli();
+		if(g_queueHead == g_queueTail)
+		{
+			IDLE_sleep();
+		}
+		SREG=sreg;
+	}
+}
@@ -3,7 +3,7 @@
  * [AUTHOR]:		Omar Yousry
  * [DATE CREATED]:	29 Dec 2019
  * [DESCRIPTION]:	This header file contains the protoypes of functions of keypad driver
- * 					either it is 4x3 or 4x4
+ * 					either it is 4x3 or 4x4 with the layout selected at run time
  *******************************************************************************************/
 
 #ifndef KEYPAD_H_
@@ -15,32 +15,151 @@
 #include "common_macros.h"
 #include "std_types.h"
 #include "micro_config.h"
+#include "timer1.h"
 
 
 /******************************************************************
  * 				    Static Configurations					      *
  ******************************************************************/
-/*Macro to define the number of columns of keypad*/
+/*Macro to define the number of scanned columns of keypad
+ *(keypads with less columns leave the last columns unconnected)*/
 #define N_COL					4
-/*Macro to define the number of rows of keypad*/
+/*Macro to define the number of scanned rows of keypad*/
 #define N_ROW					4
+/*Macro to select the keymap of the keypad fitted on the board, taken by KEYPAD_init
+ *(e.g. -DKEYPAD_LAYOUT=KEYPAD_PHONE_4X3)*/
+#ifndef KEYPAD_LAYOUT
+#define KEYPAD_LAYOUT			KEYPAD_PROTEUS_4X4
+#endif
 /*Macro to define input port the keypad connected to*/
 #define KEYPAD_PORT_IN 			PINA
 /*Macro to define output port the keypad connected to*/
 #define KEYPAD_PORT_OUT			PORTA
 /*Macro to define direction port the keypad connected to*/
 #define KEYPAD_PORT_DIRECTION 	DDRA
+/*Macro to define the period of keypad scan in milli-seconds (TIMER1 tick)*/
+#define KEYPAD_SCAN_PERIOD_MS	5u
+/*Macro to define number of successive scans a key shall keep its new level
+ *to be accepted as pressed/released (debounce time = 4 x 5 ms = 20 ms)*/
+#define KEYPAD_DEBOUNCE_SCANS	4u
+/*Macro to define number of events the keypad queue can hold, it shall be a power of 2
+ *(16 events hold 8 complete key strokes typed ahead)*/
+#define KEYPAD_QUEUE_SIZE		16u
+
+/******************************************************************
+ * 				   			 Macros					      		  *
+ ******************************************************************/
+/*Macro to calculate TIMER1 compare value for the scan period with F_CPU/64 prescaler*/
+#define KEYPAD_SCAN_COMPARE_VAL	((uint16)(((F_CPU/64u)/1000u)*KEYPAD_SCAN_PERIOD_MS)-1u)
+/*Macro to wrap keypad queue indices*/
+#define KEYPAD_QUEUE_MASK		(KEYPAD_QUEUE_SIZE-1u)
+/*Macro for keymap entries of switches not connected in the layout*/
+#define KEYPAD_NO_KEY			0xFFu
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[ENUM Name]		: KEYPAD_Layout
+ *[ENUM Description]: This enum contains the supported keypad layouts, each has a keymap in flash*/
+typedef enum{
+	KEYPAD_PROTEUS_4X4,KEYPAD_PHONE_4X3,KEYPAD_ACCESS_PANEL,KEYPAD_LAYOUT_COUNT
+}KEYPAD_Layout;
+
+/*[ENUM Name]		: KEYPAD_EventKind
+ *[ENUM Description]: This enum contains the kinds of keypad events*/
+typedef enum{
+	KEYPAD_PRESSED,KEYPAD_RELEASED
+}KEYPAD_EventKind;
+
+/*[Structure Name]		 : KEYPAD_EventType
+ *[Structure Description]: This structure holds a debounced keypad event:
+ *						   1. Functional key of the switch
+ *						   2. Kind of the event (pressed/released)
+ *						   3. Time of the event in scan ticks (KEYPAD_SCAN_PERIOD_MS each)*/
+typedef struct{
+	uint8 key;
+	KEYPAD_EventKind kind;
+	uint16 time;
+}KEYPAD_EventType;
 
 
 /******************************************************************
  * 				  Public Functions Prototypes					  *
  ******************************************************************/
+/*[Function Name] : KEYPAD_init
+ *[Description]	  : This function selects the keymap of the build (KEYPAD_LAYOUT) and starts
+ *					TIMER1 to scan the keypad every KEYPAD_SCAN_PERIOD_MS in the background,
+ *					global interrupts shall be enabled
+ *[Arguments]     : void
+ *[Return]        : void*/
+void KEYPAD_init (void);
+
+/*[Function Name] : KEYPAD_scan
+ *[Description]	  : This function scans all keypad switches once, debounces each switch alone
+ *					and queues an event for each accepted press/release:
+ *					1. Reads the whole matrix so any number of held keys are seen (n-key rollover)
+ *					2. Finds switches which may be ghosts of other pressed switches and holds
+ *					   them from being accepted as pressed till the matrix is unambiguous again
+ *					It's the TIMER1 callback function so it runs in interrupt context
+ *[Arguments]     : void
+ *[Return]        : void*/
+void KEYPAD_scan (void);
+
+/*[Function Name] : KEYPAD_setLayout
+ *[Description]	  : This function selects the keymap used to decode the keypad switches, the scan
+ *					takes it once no key is held so a held key is released with the keymap it
+ *					was pressed with
+ *[Arguments]     : KEYPAD_Layout layout
+ *						This enum variable holds the keypad layout
+ *[Return]        : uint8
+ *						TRUE if the layout is selected, FALSE if it's out of range*/
+uint8 KEYPAD_setLayout (KEYPAD_Layout layout);
+
+/*[Function Name] : KEYPAD_getEvent
+ *[Description]	  : This function takes the oldest event out of keypad queue without waiting
+ *[Arguments]     : KEYPAD_EventType * event
+ *						This is a pointer to structure to be filled with the event
+ *[Return]        : uint8
+ *						TRUE if an event is returned, FALSE if the queue is empty*/
+uint8 KEYPAD_getEvent (KEYPAD_EventType * event);
+
 /*[Function Name] : KEYPAD_getPressedKey
- *[Description]	  : This function gets the value of pressed key on keypad
+ *[Description]	  : This function waits for the next key press event in keypad queue,
+ *					release events are dropped
  *[Arguments]     : void
  *[Return]        : uint8
  *					This function returns a uint8 variable holding data of
  *					pressed key*/
 uint8 KEYPAD_getPressedKey (void);
 
+/*[Function Name] : KEYPAD_flushEvents
+ *[Description]	  : This function drops all events waiting in keypad queue (type-ahead)
+ *[Arguments]     : void
+ *[Return]        : void*/
+void KEYPAD_flushEvents (void);
+
+/*[Function Name] : KEYPAD_getHeldKeysCount
+ *[Description]	  : This function gets the number of keys held down at the moment
+ *[Arguments]     : void
+ *[Return]        : uint8
+ *						Number of debounced pressed keys*/
+uint8 KEYPAD_getHeldKeysCount (void);
+
+/*[Function Name] : KEYPAD_getTicks
+ *[Description]	  : This function gets the number of scans since KEYPAD_init, the time base
+ *					of event times (KEYPAD_SCAN_PERIOD_MS each, wrapping around)
+ *[Arguments]     : void
+ *[Return]        : uint16
+ *						Scan ticks*/
+uint16 KEYPAD_getTicks (void);
+
+/*[Function Name] : KEYPAD_getStatistics
+ *[Description]	  : This function gets the keypad error counters
+ *[Arguments]     : uint16 * overflows
+ *						Pointer to be filled with number of events lost as the queue was full
+ *					uint16 * ghostScans
+ *						Pointer to be filled with number of scans that found an ambiguous matrix
+ *[Return]        : void*/
+void KEYPAD_getStatistics (uint16 * overflows, uint16 * ghostScans);
+
 #endif /* KEYPAD_H_ */
@@ -7,6 +7,52 @@
  ***********************************************************************************************/
 
 #include "lcd.h"
+#include "trace.h"
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+/*Bitmaps of custom glyphs saved in flash, each row holds 5 pixels in its 5 LSBs
+ *Indexed by LCD_Glyph enum*/
+static const uint8 g_glyphBitmaps[LCD_GLYPH_COUNT][LCD_GLYPH_ROWS] PROGMEM = {
+	/*LCD_GLYPH_LOCKED*/
+	{0b01110,0b10001,0b10001,0b11111,0b11011,0b11011,0b11111,0b00000},
+	/*LCD_GLYPH_UNLOCKED*/
+	{0b01110,0b10000,0b10000,0b11111,0b11011,0b11011,0b11111,0b00000},
+	/*LCD_GLYPH_OPENING*/
+	{0b00000,0b00100,0b00010,0b11111,0b00010,0b00100,0b00000,0b00000},
+	/*LCD_GLYPH_CLOSING*/
+	{0b00000,0b00100,0b01000,0b11111,0b01000,0b00100,0b00000,0b00000},
+	/*LCD_GLYPH_HOURGLASS*/
+	{0b11111,0b10001,0b01010,0b00100,0b01010,0b10001,0b11111,0b00000},
+	/*LCD_GLYPH_BELL*/
+	{0b00100,0b01110,0b01110,0b01110,0b11111,0b00000,0b00100,0b00000},
+	/*LCD_GLYPH_KEY*/
+	{0b01110,0b10001,0b01110,0b00100,0b00110,0b00100,0b00110,0b00000},
+	/*LCD_GLYPH_CHECK*/
+	{0b00000,0b00001,0b00011,0b10110,0b11100,0b01000,0b00000,0b00000},
+	/*LCD_GLYPH_CROSS*/
+	{0b00000,0b10001,0b01010,0b00100,0b01010,0b10001,0b00000,0b00000},
+	/*LCD_GLYPH_SIGNAL_0*/
+	{0b00000,0b00000,0b00000,0b00000,0b00000,0b00000,0b10101,0b00000},
+	/*LCD_GLYPH_SIGNAL_1*/
+	{0b00000,0b00000,0b00000,0b00000,0b10000,0b10000,0b10101,0b00000},
+	/*LCD_GLYPH_SIGNAL_2*/
+	{0b00000,0b00000,0b00100,0b00100,0b10100,0b10100,0b10101,0b00000},
+	/*LCD_GLYPH_SIGNAL_3*/
+	{0b00001,0b00001,0b00101,0b00101,0b10101,0b10101,0b10101,0b00000}
+};
+
+/*Glyph cached in each CGRAM slot, LCD_GLYPH_COUNT means that the slot is empty*/
+static uint8 g_slotGlyph[LCD_CGRAM_SLOTS];
+
+/*CGRAM slots ordered by last usage, g_slotOrder[0] is the most recently used slot
+ *and g_slotOrder[LCD_CGRAM_SLOTS-1] is the one to be evicted next*/
+static uint8 g_slotOrder[LCD_CGRAM_SLOTS];
+
+/*Current DDRAM address (cursor place), kept to return the cursor back after
+ *writing a glyph bitmap in CGRAM*/
+static uint8 g_ddramAddress=0;
 
 /******************************************************************
  * 				  Private Functions Prototypes					  *
@@ -38,6 +84,14 @@ static void reverseString (char * str, uint8 length);
  *						Returns a pointer to character*/
 static char * intToString (int data, char * buff, int base);
 
+/*[Function Name] : touchSlot
+ *[Description]	  : This function moves a CGRAM slot to the head of the usage order list
+ *					so as to be the last one to be evicted
+ *[Arguments]     : uint8 slot
+ *						This uint8 variable holds the CGRAM slot which is just used
+ *[Return]        : void*/
+static void touchSlot (uint8 slot);
+
 
 /******************************************************************
  * 				  	  Functions Definitions				 		  *
@@ -111,6 +165,29 @@ static char * intToString (int data, char * buff, int base)
     return buff;
 }
 
+/*[Function Name] : touchSlot
+ *[Description]	  : This function moves a CGRAM slot to the head of the usage order list
+ *					so as to be the last one to be evicted
+ *[Arguments]     : uint8 slot
+ *						This uint8 variable holds the CGRAM slot which is just used
+ *[Return]        : void*/
+static void touchSlot (uint8 slot)
+{
+	uint8 i=0;
+	/*Find the place of the slot in the usage order list*/
+	while(g_slotOrder[i] != slot)
+	{
+		i++;
+	}
+	/*Shift the more recently used slots one place back and put the slot at head*/
+	while(i>0)
+	{
+		g_slotOrder[i]=g_slotOrder[i-1];
+		i--;
+	}
+	g_slotOrder[0]=slot;
+}
+
 /*[Function Name] : LCD_init
  *[Description]	  : This function initialises LCD (set direction for data and control ports
  *					and clears screen
@@ -118,6 +195,13 @@ static char * intToString (int data, char * buff, int base)
  *[Return]        : void*/
 void LCD_init(void)
 {
+	uint8 slot;
+	/*Mark all CGRAM slots as empty as CGRAM content is undefined after power on*/
+	for(slot=0;slot<LCD_CGRAM_SLOTS;slot++)
+	{
+		g_slotGlyph[slot]=LCD_GLYPH_COUNT;
+		g_slotOrder[slot]=slot;
+	}
 	SET_BIT(LCD_CTRL_DIR,RS);		/*Set RS to be output pin*/
 	SET_BIT(LCD_CTRL_DIR,RW);		/*Set RW to be output pin*/
 	SET_BIT(LCD_CTRL_DIR,E);		/*Set E  to be output pin*/
@@ -217,6 +301,17 @@ void LCD_displayCharacter (uint8 data)
 		CLEAR_BIT(LCD_CTRL_PORT,E); 	 /*E=0 to disable*/
 		_delay_ms(1); 					 /*delay for th*/
 	#endif
+	/*LCD increments its address counter after each write, wrapping from the end of the first
+	 *line (0x27) to the second one (0x40) and from the end of the second one back to 0x00*/
+	g_ddramAddress++;
+	if(g_ddramAddress == 0x28)
+	{
+		g_ddramAddress=0x40;
+	}
+	else if(g_ddramAddress == 0x68)
+	{
+		g_ddramAddress=0x00;
+	}
 }
 
 /*[Function Name] : LCD_displayString
@@ -227,11 +322,13 @@ void LCD_displayCharacter (uint8 data)
 void LCD_displayString (const char * data)
 {
 	uint8 i=0;
+	TRACE_BEGIN(TRACE_LCD,0);
 	while(data[i] != '\0')
 	{
 		LCD_displayCharacter(data[i]);
 		i++;
 	}
+	TRACE_END(TRACE_LCD,i);
 }
 
 /*[Function Name] : LCD_clearScreen
@@ -240,7 +337,10 @@ void LCD_displayString (const char * data)
  *[Return]        : void*/
 void LCD_clearScreen (void)
 {
+	TRACE_BEGIN(TRACE_LCD,0);
 	LCD_sendCommand(0x01); /*Clear Screen*/
+	g_ddramAddress=0;	   /*Clear command returns the cursor home*/
+	TRACE_END(TRACE_LCD,0);
 }
 
 /*[Function Name] : LCD_displayStringRowColumn
@@ -282,8 +382,12 @@ void LCD_goToRowColumn (uint8 row,uint8 col)
 		case 3:
 			address=0x50+col;
 			break;
+		default:
+			address=col;
+			break;
 	}
 	LCD_sendCommand(address | SET_CURSOR_LOCATION);
+	g_ddramAddress=address;
 }
 
 /*[Function Name] : LCD_intgerToString
@@ -298,3 +402,76 @@ void LCD_intgerToString (int data)
 	//itoa(data,buff,10);
 	LCD_displayString(buff);
 }
+
+/*[Function Name] : LCD_loadGlyph
+ *[Description]	  : This function makes sure a custom glyph is resident in CGRAM:
+ *					1. If the glyph is already cached in a slot, it only marks the slot as
+ *					   most recently used
+ *					2. If not, it copies the glyph bitmap from flash into the least recently
+ *					   used slot (any character of the evicted glyph still on screen changes
+ *					   with it, so at most 8 different glyphs can be shown at the same time)
+ *					The cursor position is kept as it was before the call
+ *[Arguments]     : LCD_Glyph glyph
+ *						This enum variable holds the glyph to be loaded
+ *[Return]        : uint8
+ *						This function returns the character code (0-7) to display the glyph,
+ *						a blank for a glyph out of range*/
+uint8 LCD_loadGlyph (LCD_Glyph glyph)
+{
+	uint8 slot,row;
+	/*Variable to hold cursor place to return to it after writing in CGRAM*/
+	uint8 cursor=g_ddramAddress;
+	if(glyph >= LCD_GLYPH_COUNT)
+	{
+		return ' ';
+	}
+	/*Check if the glyph is already cached in one of CGRAM slots*/
+	for(slot=0;slot<LCD_CGRAM_SLOTS;slot++)
+	{
+		if(g_slotGlyph[slot] == glyph)
+		{
+			touchSlot(slot);
+			return slot;
+		}
+	}
+	/*Cache miss, replace the least recently used slot with the glyph bitmap from flash*/
+	slot=g_slotOrder[LCD_CGRAM_SLOTS-1];
+	LCD_sendCommand(SET_CGRAM_ADDRESS | (slot*LCD_GLYPH_ROWS));
+	for(row=0;row<LCD_GLYPH_ROWS;row++)
+	{
+		LCD_displayCharacter(pgm_read_byte(&g_glyphBitmaps[glyph][row]));
+	}
+	g_slotGlyph[slot]=glyph;
+	touchSlot(slot);
+	/*Return the address counter back to DDRAM at the same cursor place*/
+	LCD_sendCommand(cursor | SET_CURSOR_LOCATION);
+	g_ddramAddress=cursor;
+	return slot;
+}
+
+/*[Function Name] : LCD_displayGlyph
+ *[Description]	  : This function displays a custom glyph in the current cursor place
+ *[Arguments]     : LCD_Glyph glyph
+ *						This enum variable holds the glyph to be displayed on LCD
+ *[Return]        : void*/
+void LCD_displayGlyph (LCD_Glyph glyph)
+{
+	LCD_displayCharacter(LCD_loadGlyph(glyph));
+}
+
+/*[Function Name] : LCD_displayGlyphRowColumn
+ *[Description]	  : This function displays a custom glyph on certain place (row&column) on LCD
+ *[Arguments]     : uint8 row
+ *						This uint8 variable holds row place of the glyph
+ *					uint8 col
+ *						This uint8 variable holds column place of the glyph
+ *					LCD_Glyph glyph
+ *						This enum variable holds the glyph to be displayed on LCD
+ *[Return]        : void*/
+void LCD_displayGlyphRowColumn (uint8 row, uint8 col, LCD_Glyph glyph)
+{
+	/*Load the glyph first as writing in CGRAM moves the address counter*/
+	uint8 code=LCD_loadGlyph(glyph);
+	LCD_goToRowColumn(row,col);
+	LCD_displayCharacter(code);
+}
@@ -43,8 +43,26 @@
 #define CURSOR_OFF 					0x0C
 #define CURSOR_ON 					0x0E
 #define CLEAR_COMMAND 				0x01
+#define SET_CGRAM_ADDRESS 			0x40
 #define SET_CURSOR_LOCATION 		0x80
 
+/*CGRAM holds 8 user-defined characters (codes 0-7) of 8 rows each in 5x8 font*/
+#define LCD_CGRAM_SLOTS				8u
+#define LCD_GLYPH_ROWS				8u
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[ENUM Name]		: LCD_Glyph
+ *[ENUM Description]: This enum contains the custom status icons whose bitmaps are
+ *					  stored in flash. Only 8 of them can live in CGRAM at a time, the
+ *					  rest are swapped in on demand in least-recently-used order*/
+typedef enum{
+	LCD_GLYPH_LOCKED,LCD_GLYPH_UNLOCKED,LCD_GLYPH_OPENING,LCD_GLYPH_CLOSING,LCD_GLYPH_HOURGLASS,
+	LCD_GLYPH_BELL,LCD_GLYPH_KEY,LCD_GLYPH_CHECK,LCD_GLYPH_CROSS,LCD_GLYPH_SIGNAL_0,
+	LCD_GLYPH_SIGNAL_1,LCD_GLYPH_SIGNAL_2,LCD_GLYPH_SIGNAL_3,LCD_GLYPH_COUNT
+}LCD_Glyph;
+
 /******************************************************************
  * 				  Public Functions Prototypes					  *
  ******************************************************************/
@@ -109,4 +127,37 @@ void LCD_goToRowColumn (uint8 row,uint8 col);
  *[Return]        : void*/
 void LCD_intgerToString (int data);
 
+/*[Function Name] : LCD_loadGlyph
+ *[Description]	  : This function makes sure a custom glyph is resident in CGRAM:
+ *					1. If the glyph is already cached in a slot, it only marks the slot as
+ *					   most recently used
+ *					2. If not, it copies the glyph bitmap from flash into the least recently
+ *					   used slot (any character of the evicted glyph still on screen changes
+ *					   with it, so at most 8 different glyphs can be shown at the same time)
+ *					The cursor position is kept as it was before the call
+ *[Arguments]     : LCD_Glyph glyph
+ *						This enum variable holds the glyph to be loaded
+ *[Return]        : uint8
+ *						This function returns the character code (0-7) to display the glyph,
+ *						a blank for a glyph out of range*/
+uint8 LCD_loadGlyph (LCD_Glyph glyph);
+
+/*[Function Name] : LCD_displayGlyph
+ *[Description]	  : This function displays a custom glyph in the current cursor place
+ *[Arguments]     : LCD_Glyph glyph
+ *						This enum variable holds the glyph to be displayed on LCD
+ *[Return]        : void*/
+void LCD_displayGlyph (LCD_Glyph glyph);
+
+/*[Function Name] : LCD_displayGlyphRowColumn
+ *[Description]	  : This function displays a custom glyph on certain place (row&column) on LCD
+ *[Arguments]     : uint8 row
+ *						This uint8 variable holds row place of the glyph
+ *					uint8 col
+ *						This uint8 variable holds column place of the glyph
+ *					LCD_Glyph glyph
+ *						This enum variable holds the glyph to be displayed on LCD
+ *[Return]        : void*/
+void LCD_displayGlyphRowColumn (uint8 row, uint8 col, LCD_Glyph glyph);
+
 #endif /* LCD_H_ */
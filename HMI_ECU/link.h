@@ -0,0 +1,72 @@
+/*******************************************************************************************
+ * [FILE NAME]:		link.h
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This header file selects the transport of the HMI-Control link at build
+ * 					time and maps the link macros on its driver: the UART at 9600 baud
+ * 					(uart.h) or the SPI bus with HMI as master (spi.h). Both ECUs shall be
+ * 					built with the same transport.
+ * 					The UART link can be a multi-drop (RS-485) bus shared by several doors:
+ * 					frames are 9-bit, HMI selects the Control ECU of its door by an address
+ * 					frame and Control filters frames sent to other doors in hardware
+ *******************************************************************************************/
+
+#ifndef LINK_H_
+#define LINK_H_
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+/*Transports the link can use*/
+#define LINK_UART				0
+#define LINK_SPI				1
+/*Macro to select the transport of the link, e.g. -DLINK_TRANSPORT=LINK_SPI*/
+#ifndef LINK_TRANSPORT
+#define LINK_TRANSPORT			LINK_UART
+#endif
+/*Macro to select the address of the door's Control ECU on a multi-drop UART bus (1-254),
+ *0 for a point to point link with 8-bit frames*/
+#ifndef LINK_ADDRESS
+#define LINK_ADDRESS			0
+#endif
+/*Control may send a frame unprompted only on a point to point UART link: SPI slave speaks
+ *when the master clocks it and a door on a bus when it's polled*/
+#if((LINK_TRANSPORT == LINK_UART) && (LINK_ADDRESS == 0))
+#define LINK_PUSH				1
+#else
+#define LINK_PUSH				0
+#endif
+
+/******************************************************************
+ * 					  Header Files Inclusion					  *
+ ******************************************************************/
+#if(LINK_TRANSPORT == LINK_SPI)
+#include "spi.h"
+#else
+#include "uart.h"
+#endif
+
+/******************************************************************
+ * 						Function-like Macros					  *
+ ******************************************************************/
+#if(LINK_TRANSPORT == LINK_SPI)
+#define LINK_sendByte(DATA)		SPI_sendByte(DATA)
+#define LINK_receiveByte()		SPI_receiveByte()
+#define LINK_isDataReceived()	SPI_isDataReceived()
+#define LINK_armWake()			((void)0)
+#define LINK_select()			((void)0)
+#else
+#define LINK_sendByte(DATA)		UART_sendByte(DATA)
+#define LINK_receiveByte()		UART_receiveByte()
+#define LINK_isDataReceived()	UART_isDataReceived()
+#define LINK_armWake()			UART_armWake()
+#if(LINK_ADDRESS != 0)
+#define LINK_CHARACTER_SIZE		NINE_BITS
+#define LINK_select()			UART_sendAddress(LINK_ADDRESS)
+#else
+#define LINK_CHARACTER_SIZE		EIGHT_BITS
+#define LINK_select()			((void)0)
+#endif
+#endif
+
+#endif /* LINK_H_ */
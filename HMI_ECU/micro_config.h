@@ -14,8 +14,16 @@
 #define F_CPU 8000000UL /*F_CPU = 8 MHz*/
 #endif
 
+/*Host build (HOST_BUILD defined) replaces AVR headers by the register level models
+ *in Host directory, so the ECU builds and runs as a Linux program*/
+#ifdef HOST_BUILD
+#include "hal_host.h"
+#else
 #include <avr/io.h>
 #include <util/delay.h>
 #include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include <avr/sleep.h>
+#endif
 
 #endif /* MICRO_CONFIG_H_ */
@@ -0,0 +1,163 @@
+/*******************************************************************************************
+ * [FILE NAME]:		probe.h
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This header file contains static configurations and function prototypes
+ * 					of latency probes: a probe is started and stopped at two points of the
+ * 					code and the time between them is counted in a log-scale histogram in
+ * 					RAM, which is dumped as text on a diagnostic request over the software
+ * 					UART debug channel (or the HMI-Control link).
+ * 					Time is counted by the clock (clock.h, TIMER0 running free)
+ *******************************************************************************************/
+
+#ifndef PROBE_H_
+#define PROBE_H_
+
+/******************************************************************
+ * 				Common Header Files Inclusion					  *
+ ******************************************************************/
+#include "micro_config.h"
+#include "std_types.h"
+#include "common_macros.h"
+#include "clock.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+/*Macro to enable (1) or remove (0) probes at compile time, when removed the probe macros
+ *expand to nothing. Probes are off by default, the host build enables them*/
+#ifndef PROBE_ENABLE
+#define PROBE_ENABLE			0
+#endif
+/*Macro to define the time of a probe tick in micro-seconds, a clock tick*/
+#define PROBE_TICK_US			CLOCK_TICK_US
+/*Macro to define the number of histogram buckets: bucket 0 counts durations under 2 units,
+ *bucket N counts durations of 2^N up to 2^(N+1)-1 units and the last one counts all longer
+ *durations (8 usec tick: 16 usec, 32 usec, ... 16 msec and more)*/
+#define PROBE_BUCKETS			12u
+/*Macro to define the unit of probes which can last seconds as a power of 2 of clock ticks:
+ *periods of 256 ticks (2.048 msec) are timed up to 134 sec on 16 bits, other probes count
+ *ticks up to 524 msec*/
+#define PROBE_LONG_SHIFT		8u
+/*Macro to tell if a probe can last seconds: it waits for the user or the other ECU*/
+#define PROBE_IS_LONG(ID)		(((ID) == PROBE_STATE) || ((ID) == PROBE_LINK_RX) || \
+								 ((ID) == PROBE_UNLOCK) || ((ID) == PROBE_BOOT))
+/*Macro to define the keypad key HMI dumps its probes with in main menu*/
+#define PROBE_DUMP_KEY			'='
+/*Channels dumps of probes and trace can be sent on*/
+#define PROBE_LINK				0
+#define PROBE_SUART				1
+/*Macro to select the channel dumps are sent on: the software UART debug channel on PD7
+ *(soft_uart.h) keeps them off the HMI-Control link, the link serves boards with PD7
+ *not wired out*/
+#ifndef PROBE_CHANNEL
+#define PROBE_CHANNEL			PROBE_SUART
+#endif
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[ENUM Name]		: PROBE_Id
+ *[ENUM Description]: This enum contains the probes of both ECUs*/
+typedef enum{
+	PROBE_STATE,		/*One pass of the state function called by main loop*/
+	PROBE_LINK_RX,		/*UART_receiveByte or SPI_receiveByte call till the byte arrives*/
+	PROBE_UNLOCK,		/*HMI: first password key till DOOR_UNLOCKING arrives
+						 *Control: HMI_ECU_READY till motor starts opening the door*/
+	PROBE_CHECK,		/*Control: last password byte till the password is checked, the
+						 *lookup prefetched while the last key is typed*/
+	PROBE_EEPROM,		/*Control: EEPROM_readByte/EEPROM_writeByte call*/
+	PROBE_SLEEP,		/*Idle sleep (idle.h) till the CPU runs the waiting code again*/
+	PROBE_WAKE,			/*Interrupt waking the CPU from idle sleep till the waiting code runs*/
+	PROBE_BOOT,			/*PROBE_INIT after reset till Control's status is known (HMI) or
+						 *pushed to HMI (Control)*/
+	PROBE_HASH,			/*Control: BLAKE2s digest of a PIN (blake2s.h)*/
+	PROBE_COUNT
+}PROBE_Id;
+
+/*[Structure Name]		 : PROBE_HistogramType
+ *[Structure Description]: This structure contains the histogram of a probe in its unit (ticks
+ * 						   or periods), counts stop at 255 instead of wrapping. Probes nest in each other (a state function pass
+ * 						   waits for the link, which sleeps, ...) so each keeps its start*/
+typedef struct{
+	uint8 count[PROBE_BUCKETS];
+	uint16 max;
+	uint16 start;
+}PROBE_HistogramType;
+
+/******************************************************************
+ * 						Function-like Macros					  *
+ ******************************************************************/
+#if(PROBE_ENABLE)
+#define PROBE_INIT()			PROBE_init()
+#define PROBE_START(ID)			PROBE_start(ID)
+#define PROBE_STOP(ID)			PROBE_stop(ID)
+#define PROBE_DUMP()			PROBE_dump()
+#else
+#define PROBE_INIT()			((void)0)
+#define PROBE_START(ID)			((void)0)
+#define PROBE_STOP(ID)			((void)0)
+#define PROBE_DUMP()			((void)0)
+#endif
+/*Send a byte of a dump, also used by the trace recorder (trace.h)*/
+#if(PROBE_CHANNEL == PROBE_SUART)
+#define PROBE_SEND(DATA)		SUART_sendByteWaiting(DATA)
+#else
+#define PROBE_SEND(DATA)		LINK_sendByte(DATA)
+#endif
+
+/******************************************************************
+ * 				    Public Functions Prototypes					  *
+ ******************************************************************/
+#if(PROBE_ENABLE)
+/*******************************************************************************
+ * [Function Name]	: PROBE_init
+ * [Description]	: This function starts the clock as time base of probes, clears histograms
+ * 					  and initialises the software UART if it's the dump channel, global
+ * 					  interrupts shall be enabled
+ * [Arguments]		: void
+ * [Returns]		: void
+ *******************************************************************************/
+void PROBE_init(void);
+
+/*******************************************************************************
+ * [Function Name]	: PROBE_start
+ * [Description]	: This function marks the start of a probe, starting it again before
+ * 					  it's stopped restarts it
+ * [Arguments]		: PROBE_Id id
+ * [Returns]		: void
+ *******************************************************************************/
+void PROBE_start(PROBE_Id id);
+
+/*******************************************************************************
+ * [Function Name]	: PROBE_stop
+ * [Description]	: This function counts the time since the start of a probe in its
+ * 					  histogram, a probe which is not started is ignored. It may be called
+ * 					  with interrupts enabled or in an interrupt
+ * [Arguments]		: PROBE_Id id
+ * [Returns]		: void
+ *******************************************************************************/
+void PROBE_stop(PROBE_Id id);
+
+/*******************************************************************************
+ * [Function Name]	: PROBE_dump
+ * [Description]	: This function sends histograms of used probes on the dump channel as text lines
+ * 					  of hex numbers, only characters "0-9A-F:,P\n" are used so the dump
+ * 					  can't be taken for a signal of the link:
+ * 					  P<id>:<unit us>:<max units>:<bucket 0>,<bucket 1>,...<last used bucket>
+ * [Arguments]		: void
+ * [Returns]		: void
+ *******************************************************************************/
+void PROBE_dump(void);
+
+/*******************************************************************************
+ * [Function Name]	: PROBE_sendHex
+ * [Description]	: This function sends a number on the dump channel in upper case hex
+ * 					  without leading zeros, for the dump lines of other modules
+ * [Arguments]		: uint32 value
+ * [Returns]		: void
+ *******************************************************************************/
+void PROBE_sendHex(uint32 value);
+#endif
+
+#endif /* PROBE_H_ */
@@ -0,0 +1,259 @@
+/*******************************************************************************************
+ * [FILE NAME]:		spi.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains implementation of functions for SPI Module
+ * 					in AVR ATMEGA-16 Micro-controller
+ *******************************************************************************************/
+
+#include "spi.h"
+#include "probe.h"
+#include "trace.h"
+#include "idle.h"
+#include "link.h"
+
+/*The SPI driver is built only for the SPI link, UART builds leave its buffers and interrupt
+ *out*/
+#if(LINK_TRANSPORT == LINK_SPI)
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+/*Role given to SPI_init*/
+static uint8 g_role=SPI_SLAVE;
+
+/*Circular buffer of received data bytes, filled by the ISR (slave) or by the transfers
+ *(master) and emptied by SPI_receiveByte*/
+static volatile uint8 g_rxBuffer[SPI_BUFFER_SIZE];
+static volatile uint8 g_rxHead=0;
+static volatile uint8 g_rxTail=0;
+/*An SPI_ESCAPE was received, the next byte is escaped*/
+static volatile uint8 g_rxEscaped=FALSE;
+
+/*Slave: circular buffer of data bytes waiting for the master to clock them out, and the
+ *escaped byte to load after an SPI_ESCAPE*/
+static volatile uint8 g_txBuffer[SPI_BUFFER_SIZE];
+static volatile uint8 g_txHead=0;
+static volatile uint8 g_txTail=0;
+static volatile uint8 g_txEscaped=FALSE;
+static volatile uint8 g_txPending;
+
+/******************************************************************
+ * 				  Private Functions Prototypes					  *
+ ******************************************************************/
+static void SPI_receiveRaw(uint8 raw);
+static uint8 SPI_transfer(uint8 data);
+static uint8 SPI_isTxFull(void);
+
+/******************************************************************
+ * 				   Interrupt Service Routines					  *
+ ******************************************************************/
+/*ISR of SPI, Serial Transfer Complete (slave only)*/
+/*The byte for the next transfer is loaded first, as the master may start it right after
+ *its gap, then the received byte is unframed*/
+ISR(SPI_STC_vect)
+{
+	uint8 raw=SPDR;
+	uint8 next=SPI_IDLE;
+	uint8 data;
+	IDLE_WAKE();
+	if(g_txEscaped)
+	{
+		next=g_txPending;
+		g_txEscaped=FALSE;
+	}
+	else if(g_txHead != g_txTail)
+	{
+		data=g_txBuffer[g_txTail];
+		g_txTail=(g_txTail+1) & SPI_BUFFER_MASK;
+		if((data == SPI_IDLE) || (data == SPI_ESCAPE))
+		{
+			g_txPending=data^SPI_ESCAPE_XOR;
+			g_txEscaped=TRUE;
+			next=SPI_ESCAPE;
+		}
+		else
+		{
+			next=data;
+		}
+	}
+	SPDR=next;
+	SPI_receiveRaw(raw);
+	if((raw != SPI_IDLE) || (next != SPI_IDLE))
+	{
+		TRACE_EVENT(TRACE_SPI,((uint16)next<<8) | raw);
+	}
+}
+
+/******************************************************************
+ * 				  	  Functions Definitions				 		  *
+ ******************************************************************/
+/*Description: This function initialises SPI Module
+ * 1. Empties the buffers
+ * 2. Master: SS, MOSI and SCK are outputs (SS low selects the slave), SPI enabled in master
+ *    mode 0 with SCK rate from SPR1:0 and SPI2X
+ * 3. Slave: MISO is output, SPI enabled with its interrupt, SPI_IDLE loaded to be sent*/
+void SPI_init(const SPI_ConfigType * Config_Ptr)
+{
+	g_role=Config_Ptr->role;
+	g_rxHead=0;
+	g_rxTail=0;
+	g_rxEscaped=FALSE;
+	g_txHead=0;
+	g_txTail=0;
+	g_txEscaped=FALSE;
+	if(g_role == SPI_MASTER)
+	{
+		CLEAR_BIT(SPI_PORT,SPI_SS);
+		SET_BIT(SPI_DIR,SPI_SS);
+		SET_BIT(SPI_DIR,SPI_MOSI);
+		SET_BIT(SPI_DIR,SPI_SCK);
+		CLEAR_BIT(SPI_DIR,SPI_MISO);
+		SPCR=(1<<SPE) | (1<<MSTR) | (Config_Ptr->clock & 0x03);
+		SPSR=(Config_Ptr->clock>>2) & 0x01;
+	}
+	else
+	{
+		CLEAR_BIT(SPI_DIR,SPI_SS);
+		CLEAR_BIT(SPI_DIR,SPI_MOSI);
+		CLEAR_BIT(SPI_DIR,SPI_SCK);
+		SET_BIT(SPI_DIR,SPI_MISO);
+		SPCR=(1<<SPE) | (1<<SPIE);
+		SPDR=SPI_IDLE;
+	}
+}
+
+/*Description: This function sends a data byte, escaped if it's a framing byte*/
+void SPI_sendByte(const uint8 data)
+{
+	if(g_role == SPI_MASTER)
+	{
+		if((data == SPI_IDLE) || (data == SPI_ESCAPE))
+		{
+			SPI_transfer(SPI_ESCAPE);
+			SPI_transfer(data^SPI_ESCAPE_XOR);
+		}
+		else
+		{
+			SPI_transfer(data);
+		}
+		return;
+	}
+	/*Busy-wait loop till the ISR frees a place in the buffer*/
+	while(SPI_isTxFull());
+	/*Only the head is changed here and only the tail in the ISR, so no locking is needed*/
+	g_txBuffer[g_txHead]=data;
+	g_txHead=(g_txHead+1) & SPI_BUFFER_MASK;
+}
+
+/*Description: This function waits for a data byte, master polls the slave meanwhile and
+ *slave sleeps till its interrupt receives a byte*/
+uint8 SPI_receiveByte(void)
+{
+	uint8 data;
+	uint8 sreg=SREG;
+	PROBE_START(PROBE_LINK_RX);
+	TRACE_BEGIN(TRACE_SPI,0);
+	while(g_rxHead == g_rxTail)
+	{
+		/*Slave answers SPI_IDLE when it has nothing to send, next poll is a period later*/
+		if(g_role == SPI_MASTER)
+		{
+			if(SPI_transfer(SPI_IDLE) == SPI_IDLE)
+			{
+				_delay_us(SPI_POLL_US);
+			}
+			continue;
+		}
+		/*Slave sleeps till its interrupt receives a byte*/
+		cli();
+		if(g_rxHead == g_rxTail)
+		{
+			IDLE_sleep();
+		}
+		SREG=sreg;
+	}
+	PROBE_STOP(PROBE_LINK_RX);
+	data=g_rxBuffer[g_rxTail];
+	g_rxTail=(g_rxTail+1) & SPI_BUFFER_MASK;
+	TRACE_END(TRACE_SPI,data);
+	return data;
+}
+
+/*Description: This function returns TRUE if the receive buffer is not empty, master polls
+ *the slave once first if it's empty*/
+uint8 SPI_isDataReceived(void)
+{
+	if((g_role == SPI_MASTER) && (g_rxHead == g_rxTail))
+	{
+		SPI_transfer(SPI_IDLE);
+	}
+	return (g_rxHead != g_rxTail) ? TRUE : FALSE;
+}
+
+/*Description: This function sends a string byte by byte*/
+void SPI_sendString(const uint8 * str)
+{
+	uint8 i=0;
+	while(str[i] != '\0')
+	{
+		SPI_sendByte(str[i]);
+		i++;
+	}
+}
+
+/******************************************************************
+ * 				  Private Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function unframes a byte from the bus: SPI_IDLE is dropped, SPI_ESCAPE
+ *marks the next byte as escaped, data bytes go to the receive buffer (dropped if it's full)*/
+static void SPI_receiveRaw(uint8 raw)
+{
+	uint8 next;
+	if(g_rxEscaped)
+	{
+		g_rxEscaped=FALSE;
+		raw^=SPI_ESCAPE_XOR;
+	}
+	else if(raw == SPI_ESCAPE)
+	{
+		g_rxEscaped=TRUE;
+		return;
+	}
+	else if(raw == SPI_IDLE)
+	{
+		return;
+	}
+	next=(g_rxHead+1) & SPI_BUFFER_MASK;
+	if(next != g_rxTail)
+	{
+		g_rxBuffer[g_rxHead]=raw;
+		g_rxHead=next;
+	}
+}
+
+/*Description: This function makes a master transfer: it sends a byte, waits for the byte
+ *shifted in from the slave and unframes it, then waits the gap the slave needs to load
+ *its next byte. It returns the byte received*/
+static uint8 SPI_transfer(uint8 data)
+{
+	uint8 raw;
+	SPDR=data;
+	/*Busy-wait loop till the transfer completes, SPIF is cleared by reading SPSR then SPDR*/
+	while(IS_BIT_CLEAR(SPSR,SPIF));
+	raw=SPDR;
+	if((raw != SPI_IDLE) || (data != SPI_IDLE))
+	{
+		TRACE_EVENT(TRACE_SPI,((uint16)data<<8) | raw);
+	}
+	SPI_receiveRaw(raw);
+	_delay_us(SPI_GAP_US);
+	return raw;
+}
+
+/*Description: This function returns TRUE if the slave transmit buffer is full*/
+static uint8 SPI_isTxFull(void)
+{
+	return (((g_txHead+1) & SPI_BUFFER_MASK) == g_txTail) ? TRUE : FALSE;
+}
+#endif
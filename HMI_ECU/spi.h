@@ -0,0 +1,125 @@
+/*******************************************************************************************
+ * [FILE NAME]:		spi.h
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This header file contains static configurations and function prototypes
+ * 					for SPI Module in AVR ATMEGA-16 Micro-controller, used as a byte link
+ * 					between HMI (master) and Control (slave) ECUs.
+ * 					Both sides exchange a byte on every transfer, so a side with nothing to
+ * 					send sends SPI_IDLE. Data bytes equal to SPI_IDLE or SPI_ESCAPE are sent
+ * 					as SPI_ESCAPE followed by the byte XOR-ed with SPI_ESCAPE_XOR, so every
+ * 					byte value can be carried. The slave frames and unframes bytes in its
+ * 					transfer complete interrupt. The master polls: it sends its bytes with a
+ * 					gap after each transfer for the slave interrupt to load the next one, and
+ * 					clocks SPI_IDLE bytes every SPI_POLL_US while it waits for a byte
+ *******************************************************************************************/
+#ifndef SPI_H_
+#define SPI_H_
+
+/******************************************************************
+ * 				Common Header Files Inclusion					  *
+ ******************************************************************/
+#include "micro_config.h"
+#include "std_types.h"
+#include "common_macros.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+/*SPI pins of ATMEGA-16 on PORTB*/
+#define SPI_DIR					DDRB
+#define SPI_PORT				PORTB
+#define SPI_SS					PB4
+#define SPI_MOSI				PB5
+#define SPI_MISO				PB6
+#define SPI_SCK					PB7
+/*Filler byte sent when there is no data, and escape byte of data bytes equal to them*/
+#define SPI_IDLE				0xFF
+#define SPI_ESCAPE				0xFE
+#define SPI_ESCAPE_XOR			0x20
+/*Master: wait after each transfer for the slave ISR to take the byte and load its next
+ *one (a write to SPDR during a transfer is lost), and period of polls while waiting*/
+#define SPI_GAP_US				10u
+#define SPI_POLL_US				100u
+/*Size of the receive and (slave) transmit buffers, it shall be a power of 2 up to 256*/
+#define SPI_BUFFER_SIZE			32u
+#define SPI_BUFFER_MASK			(SPI_BUFFER_SIZE-1u)
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[ENUM Name]		: SPI_Role
+ *[ENUM Description]: This enum contains the roles of the ECU on the SPI bus*/
+typedef enum{
+	SPI_SLAVE,SPI_MASTER
+}SPI_Role;
+
+/*[ENUM Name]		: SPI_Clock
+ *[ENUM Description]: This enum contains the master SCK rates, value is SPI2X:SPR1:SPR0*/
+typedef enum{
+	SPI_F_CPU_4,SPI_F_CPU_16,SPI_F_CPU_64,SPI_F_CPU_128,SPI_F_CPU_2,SPI_F_CPU_8,SPI_F_CPU_32
+}SPI_Clock;
+
+/*[Structure Name]		 : SPI_ConfigType
+ *[Structure Description]: This structure contains configuration parameters for SPI
+ *						   module: 1. Role on the bus (master/slave)
+ * 								   2. SCK rate, used by master only
+ * 						   Both sides use mode 0 (CPOL=0, CPHA=0) and MSB first*/
+typedef struct{
+	SPI_Role role;
+	SPI_Clock clock;
+}SPI_ConfigType;
+
+/******************************************************************
+ * 				  Public Functions Prototypes					  *
+ ******************************************************************/
+/*********************************************************************************
+ * [Function Name]	: SPI_init
+ * [Description]	: This function initialises SPI Module:
+ * 						1. Master drives SS (held low), MOSI and SCK, slave drives MISO
+ * 						2. Master sets the SCK rate, slave enables transfer complete
+ * 						   interrupt and loads SPI_IDLE for the first transfer
+ * 					  Global interrupts shall be enabled on slave side
+ * [Arguments]		: const SPI_ConfigType * Config_Ptr
+ * 						This is a pointer to structure having the role and clock rate
+ * [Return]			: void
+ ***********************************************************************************/
+void SPI_init(const SPI_ConfigType * Config_Ptr);
+
+/*********************************************************************************
+ * [Function Name]	: SPI_sendByte
+ * [Description]	: This function sends a data byte: master clocks it out at once (two
+ * 					  transfers if it's escaped), slave queues it for the next transfers
+ * 					  and waits only if its buffer is full
+ * [Arguments]		: const uint8 data
+ * [Return]			: void
+ ***********************************************************************************/
+void SPI_sendByte(const uint8 data);
+
+/*********************************************************************************
+ * [Function Name]	: SPI_receiveByte
+ * [Description]	: This function waits for a data byte and returns it, bytes received
+ * 					  meanwhile are kept in order in the receive buffer
+ * [Arguments]		: void
+ * [Return]			: uint8
+ ***********************************************************************************/
+uint8 SPI_receiveByte(void);
+
+/*********************************************************************************
+ * [Function Name]	: SPI_isDataReceived
+ * [Description]	: This function tells whether a data byte waits in the receive buffer,
+ * 					  master clocks one SPI_IDLE byte to poll the slave if it's empty
+ * [Arguments]		: void
+ * [Return]			: uint8
+ ***********************************************************************************/
+uint8 SPI_isDataReceived(void);
+
+/*********************************************************************************
+ * [Function Name]	: SPI_sendString
+ * [Description]	: This function sends a null terminated string
+ * [Arguments]		: const uint8 * str
+ * [Return]			: void
+ ***********************************************************************************/
+void SPI_sendString(const uint8 * str);
+
+#endif /* SPI_H_ */
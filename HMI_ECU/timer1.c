@@ -7,6 +7,8 @@
  *******************************************************************************************/
 
 #include "timer1.h"
+#include "trace.h"
+#include "idle.h"
 
 /******************************************************************
  * 						Global Variables						  *
@@ -18,19 +20,25 @@ static volatile void (*g_callBackPtr)(void) = NULL_PTR;
  ******************************************************************/
 ISR(TIMER1_COMPA_vect)
 {
+	IDLE_WAKE();
 	/*Go to callback function*/
 	if(g_callBackPtr != NULL_PTR)
 	{
+		TRACE_BEGIN(TRACE_TIMER1,0);
 		(*g_callBackPtr)();
+		TRACE_END(TRACE_TIMER1,0);
 	}
 }
 
 ISR(TIMER1_OVF_vect)
 {
+	IDLE_WAKE();
 	/*Go to callback function*/
 	if(g_callBackPtr != NULL_PTR)
 	{
+		TRACE_BEGIN(TRACE_TIMER1,1);
 		(*g_callBackPtr)();
+		TRACE_END(TRACE_TIMER1,1);
 	}
 }
 
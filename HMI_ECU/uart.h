@@ -25,14 +25,22 @@
 #define UART_POLLING	0
 /*Macro definition for UART module mode either it's operating with polling/interrupt*/
 #define UART_MODE		UART_POLLING
+/*9th bit of a frame, on a multi-drop bus it marks an address frame*/
+#define UART_ADDRESS_BIT		0x0100u
+/*Node address of a point to point link (MPCM not used), and the address which selects
+ *every node on a multi-drop bus*/
+#define UART_NO_ADDRESS			0x00u
+#define UART_BROADCAST_ADDRESS	0xFFu
+/*Frame returned by UART_receiveFrame on a framing, overrun or parity error*/
+#define UART_FRAME_ERROR		0xFFFFu
 
 /******************************************************************
  * 						Global Variables					 	  *
  ******************************************************************/
 #if(UART_MODE == UART_INTERRUPT)
 /*Extern for (g_RxData) Global variable to hold byte to be used in
- *receiveByte API in case of receiving with interrupts*/
-extern volatile uint8 g_RxData;
+ *receiveByte API in case of receiving with interrupts, 9th bit included*/
+extern volatile uint16 g_RxData;
 #endif
 /******************************************************************
  * 				    User-defined Data Types					      *
@@ -51,9 +59,10 @@ typedef enum{
 }UART_StopBit;
 
 /*[ENUM Name]		: UART_CharacterSize
- *[ENUM Description]: This enum contains values of allowed data frame from 5-9 bits*/
+ *[ENUM Description]: This enum contains values of allowed data frame from 5-9 bits, value
+ *					  is UCSZ2:0*/
 typedef enum{
-	FIVE_BITS,SIX_BITS,SEVEN_BITS,EIGHT_BITS
+	FIVE_BITS,SIX_BITS,SEVEN_BITS,EIGHT_BITS,NINE_BITS=7
 }UART_CharacterSize;
 
 /*[Structure Name]		 : UART_ConfigType
@@ -61,7 +70,9 @@ typedef enum{
  *						   module: 1. Desired baud rate
  * 								   2. Desired parity type (even/odd/disabled)
  * 								   3. Desired number of stop bits (1/2)
- * 								   4. Desired data frame i.e.Number of data bits (5/6/7/8/9)*/
+ * 								   4. Desired data frame i.e.Number of data bits (5/6/7/8/9)
+ * 								   5. Node address on a multi-drop bus with 9-bit frames,
+ * 									  UART_NO_ADDRESS to receive every frame*/
 typedef struct{
 	/*32-bit unsigned variable to hold supported baud rate values from 100-115200 bps*/
 	uint32 baudRate;
@@ -71,6 +82,9 @@ typedef struct{
 	UART_StopBit stopBit;
 	/*enum from UART_CharacterSize type to hold desired data frame number of bits*/
 	UART_CharacterSize characterSize;
+	/*8-bit unsigned variable to hold the node address, frames of other nodes are filtered
+	 *by hardware (multi-processor communication mode) while the node isn't selected*/
+	uint8 address;
 }UART_ConfigType;
 
 /******************************************************************
@@ -84,7 +98,10 @@ typedef struct{
  * 						3. Determines frame shape:
  * 						   a. Parity type (even/odd/disabled)
  * 						   b. Number of stop bit(s) (1/2)
- * 						   c. Number of data bits (5/6/7/8)
+ * 						   c. Number of data bits (5/6/7/8/9)
+ * 						4. With a node address, enables multi-processor communication
+ * 						   mode: the node starts deselected and only address frames
+ * 						   wake the receiver
  * [Arguments]		: const UART_ConfigType * Config_Ptr
  * 						This is a pointer to structure shall be passed by address
  * 						having all the data to initialise UART module with
@@ -94,27 +111,78 @@ void UART_init(const UART_ConfigType * Config_Ptr);
 
 /*********************************************************************************
  * [Function Name]	: UART_sendByte
- * [Description]	: This function sends a byte of data by UART protocol using polling
+ * [Description]	: This function sends a byte of data by UART protocol using polling,
+ * 					  9th bit is cleared in case of 9-bits data frame (data frame)
+ * [Arguments]		: const uint8 data
+ * 						This is a uint8 variable having the desired byte to be sent
+ * 						const, so as to not be modified by this function
+ * [Return]			: void
+ ***********************************************************************************/
+void UART_sendByte(const uint8 data);
+
+/*********************************************************************************
+ * [Function Name]	: UART_sendFrame
+ * [Description]	: This function sends a frame by UART protocol using polling
  * [Arguments]		: const uint16 data
- * 						This is a uint16 variable having the desired byte to be sent
+ * 						This is a uint16 variable having the desired frame to be sent
  * 						uint16 to be able to hold 9-bits frame in case of 9-bits
  * 						const, so as to not be modified by this function
  * [Return]			: void
  ***********************************************************************************/
-void UART_sendByte(const uint8 data);
+void UART_sendFrame(const uint16 data);
+
+/*********************************************************************************
+ * [Function Name]	: UART_sendAddress
+ * [Description]	: This function sends an address frame (9th bit set) on a multi-drop
+ * 					  bus, it selects the node having this address and deselects the others
+ * 					  till the next address frame. Data frame shall be 9-bits
+ * [Arguments]		: const uint8 address
+ * 						Node address, or UART_BROADCAST_ADDRESS to select every node
+ * [Return]			: void
+ ***********************************************************************************/
+void UART_sendAddress(const uint8 address);
 
 
 #if(UART_MODE == UART_POLLING)
 /*********************************************************************************
  * [Function Name]	: UART_receiveByte
  * [Description]	: This function receives a byte of data by UART protocol in case
- * 					  of polling
+ * 					  of polling. With a node address, address frames are taken to select
+ * 					  or deselect the node and only data frames sent to it are returned
  * [Arguments]		: No input arguments
- * [Return]			: uint16 to hold value of received byte
- * 					  it's of 16-bit size to be able to hold 9-bits data in case of 9-bit
- * 					  data frame
+ * [Return]			: uint8 to hold value of received byte
  ***********************************************************************************/
 uint8 UART_receiveByte(void);
+
+/*********************************************************************************
+ * [Function Name]	: UART_receiveFrame
+ * [Description]	: This function receives a frame by UART protocol in case of polling,
+ * 					  address frames are returned as they are
+ * [Arguments]		: No input arguments
+ * [Return]			: uint16 to hold value of received frame
+ * 					  it's of 16-bit size to be able to hold 9-bits data in case of 9-bit
+ * 					  data frame, UART_FRAME_ERROR on a receive error
+ ***********************************************************************************/
+uint16 UART_receiveFrame(void);
+
+/*********************************************************************************
+ * [Function Name]	: UART_isDataReceived
+ * [Description]	: This function tells whether a frame waits to be read, for receivers
+ * 					  which shall not wait forever
+ * [Arguments]		: No input arguments
+ * [Return]			: uint8
+ ***********************************************************************************/
+uint8 UART_isDataReceived(void);
+
+/*********************************************************************************
+ * [Function Name]	: UART_armWake
+ * [Description]	: This function enables RX complete interrupt till the next frame so
+ * 					  it wakes the CPU from sleep (idle.h), its ISR disables it again and
+ * 					  leaves the frame to be read
+ * [Arguments]		: No input arguments
+ * [Return]			: void
+ ***********************************************************************************/
+void UART_armWake(void);
 #endif
 
 
@@ -0,0 +1,148 @@
+/*******************************************************************************************
+ * [FILE NAME]:		cosim.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains the main function of the two-ECU co-simulator:
+ * 					cosim [-v] [-t limit_ms] [-f firmware_dir] [-e eeprom_file] [-T trace_prefix]
+ * 					      [-d debug_prefix] script
+ * 					It runs HMI and Control firmware of a door on a script and reports the
+ * 					latency each expectation of the script is met after, in virtual time,
+ * 					and the EEPROM activity. EEPROM content and wear are kept in the
+ * 					given file between runs. Trace rings of both ECUs are written at the end
+ * 					to <trace_prefix>-hmi.trace and <trace_prefix>-control.trace, and bytes
+ * 					of both software UART debug channels as received to
+ * 					<debug_prefix>-hmi.debug and <debug_prefix>-control.debug
+ *******************************************************************************************/
+
+#include <libgen.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "sim.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+#define SIM_DEFAULT_LIMIT_MS	600000u
+#define SIM_PATH_SIZE			4096u
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+static SIM_ProgramType g_program;
+static SIM_DoorType g_door;
+
+/******************************************************************
+ * 				  	  Functions Definitions				 		  *
+ ******************************************************************/
+int main(int argc, char * argv[])
+{
+	char directory[SIM_PATH_SIZE];
+	char path[SIM_PATH_SIZE];
+	unsigned long limit=SIM_DEFAULT_LIMIT_MS;
+	const char * eeprom=NULL_PTR;
+	const char * tracePrefix=NULL_PTR;
+	const char * debugPrefix=NULL_PTR;
+	FILE * hmiDebug=NULL_PTR;
+	FILE * controlDebug=NULL_PTR;
+	FILE * trace=NULL_PTR;
+	struct timespec start;
+	struct timespec end;
+	double wall;
+	double simulated;
+	ssize_t length;
+	int option;
+	int status;
+
+	/*Firmware shared objects are looked for next to the simulator by default*/
+	length=readlink("/proc/self/exe",directory,sizeof(directory)-1);
+	directory[(length > 0) ? length : 0]='\0';
+	strcpy(directory,dirname(directory));
+	while((option=getopt(argc,argv,"vt:f:e:T:d:")) != -1)
+	{
+		switch(option)
+		{
+			case 'v': trace=stdout; break;
+			case 't': limit=strtoul(optarg,NULL_PTR,10); break;
+			case 'f': snprintf(directory,sizeof(directory),"%s",optarg); break;
+			case 'e': eeprom=optarg; break;
+			case 'T': tracePrefix=optarg; break;
+			case 'd': debugPrefix=optarg; break;
+			default:
+				fprintf(stderr,"usage: %s [-v] [-t limit_ms] [-f firmware_dir] [-e eeprom_file] [-T trace_prefix] [-d debug_prefix] script\n",argv[0]);
+				return EXIT_FAILURE;
+		}
+	}
+	if((optind != argc-1) || !SIM_scriptLoad(&g_program,argv[optind]))
+	{
+		fprintf(stderr,"usage: %s [-v] [-t limit_ms] [-f firmware_dir] [-e eeprom_file] [-T trace_prefix] [-d debug_prefix] script\n",argv[0]);
+		return EXIT_FAILURE;
+	}
+	snprintf(path,sizeof(path),"%s/hmi_ecu.so",directory);
+	if(!SIM_ecuLoad(&g_door.hmi,"HMI",path))
+	{
+		return EXIT_FAILURE;
+	}
+	snprintf(path,sizeof(path),"%s/control_ecu.so",directory);
+	if(!SIM_ecuLoad(&g_door.control,"Control",path))
+	{
+		return EXIT_FAILURE;
+	}
+	if(!SIM_doorInit(&g_door,&g_program,eeprom,trace))
+	{
+		return EXIT_FAILURE;
+	}
+	if(debugPrefix != NULL_PTR)
+	{
+		snprintf(path,sizeof(path),"%s-hmi.debug",debugPrefix);
+		hmiDebug=fopen(path,"wb");
+		snprintf(path,sizeof(path),"%s-control.debug",debugPrefix);
+		controlDebug=fopen(path,"wb");
+		if((hmiDebug == NULL_PTR) || (controlDebug == NULL_PTR))
+		{
+			perror(path);
+			return EXIT_FAILURE;
+		}
+		SIM_debugInit(&g_door.hmi.debug,hmiDebug);
+		SIM_debugInit(&g_door.control.debug,controlDebug);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC,&start);
+	SIM_doorRun(&g_door,SIM_MS(limit));
+	clock_gettime(CLOCK_MONOTONIC,&end);
+
+	wall=(double)(end.tv_sec-start.tv_sec)+((double)(end.tv_nsec-start.tv_nsec)*1e-9);
+	simulated=(double)SIM_doorNow(&g_door)/SIM_F_CPU;
+	printf("Latencies (from last key down):\n");
+	SIM_scriptReport(&g_door.script,stdout);
+	SIM_eepromReport(&g_door.eeprom,stdout);
+	SIM_debugAdvance(&g_door.hmi.debug,SIM_doorNow(&g_door));
+	SIM_debugAdvance(&g_door.control.debug,SIM_doorNow(&g_door));
+	if(debugPrefix != NULL_PTR)
+	{
+		printf("Debug channels: HMI %u byte(s), Control %u byte(s), %u framing error(s)\n",
+			   g_door.hmi.debug.bytes,g_door.control.debug.bytes,
+			   g_door.hmi.debug.framingErrors+g_door.control.debug.framingErrors);
+		fclose(hmiDebug);
+		fclose(controlDebug);
+	}
+	printf("Simulated %.3f s in %.3f s (x%.1f), %u link frames, %u expectation(s) failed\n",
+		   simulated,wall,(wall > 0) ? simulated/wall : 0.0,g_door.frames,g_door.script.failures);
+	status=(g_door.script.finished && (g_door.script.failures == 0)) ? EXIT_SUCCESS : EXIT_FAILURE;
+	if(tracePrefix != NULL_PTR)
+	{
+		snprintf(path,sizeof(path),"%s-hmi.trace",tracePrefix);
+		if(!SIM_ecuWriteTrace(&g_door.hmi,path))
+		{
+			status=EXIT_FAILURE;
+		}
+		snprintf(path,sizeof(path),"%s-control.trace",tracePrefix);
+		if(!SIM_ecuWriteTrace(&g_door.control,path))
+		{
+			status=EXIT_FAILURE;
+		}
+	}
+	SIM_doorDeinit(&g_door);
+	return status;
+}
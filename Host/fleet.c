@@ -0,0 +1,414 @@
+/*******************************************************************************************
+ * [FILE NAME]:		fleet.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains the main function of the fleet simulator:
+ * 					fleet [-v] [-j threads] [-n doors] [-s seed] [-r sessions] [-t limit_ms]
+ * 					      [-f firmware_dir] [script...]
+ * 					It runs many independent doors (HMI and Control pairs, each with its own
+ * 					virtual clocks) on a work-stealing thread pool. Doors run the given
+ * 					scripts in turn, or random workloads drawn from seed+door number if no
+ * 					script is given. It reports throughput and latency percentiles of each
+ * 					expectation over the fleet
+ *******************************************************************************************/
+
+#include <fcntl.h>
+#include <libgen.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "sim.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+#define FLEET_DEFAULT_DOORS		100u
+#define FLEET_DEFAULT_SESSIONS	4u
+#define FLEET_DEFAULT_LIMIT_MS	3600000u
+#define FLEET_MAX_SCRIPTS		16u
+#define FLEET_MAX_STATS			64u
+#define FLEET_MAX_REPORTED		10u
+#define FLEET_TEXT_SIZE			64u
+#define FLEET_PATH_SIZE			4096u
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[Structure Name]		 : FLEET_DequeType
+ *[Structure Description]: This structure contains the doors waiting on a worker: the worker
+ * 						   takes from the tail and idle workers steal from the head*/
+typedef struct{
+	uint32 * doors;
+	uint32 head;
+	uint32 tail;
+	pthread_mutex_t lock;
+}FLEET_DequeType;
+
+/*[Structure Name]		 : FLEET_WorkerType
+ *[Structure Description]: This structure contains a worker thread. Firmware keeps its state
+ * 						   in globals, so each worker loads its own copy of the ECU objects
+ * 						   and reloads them for each door to start it from reset*/
+typedef struct{
+	uint32 id;
+	pthread_t thread;
+	FLEET_DequeType deque;
+	char hmiPath[FLEET_PATH_SIZE];
+	char controlPath[FLEET_PATH_SIZE];
+	SIM_DoorType door;
+	SIM_ProgramType program;
+	uint32 doors;
+	uint32 stolen;
+}FLEET_WorkerType;
+
+/*[Structure Name]		 : FLEET_StatType
+ *[Structure Description]: This structure contains the latencies an expectation was met
+ * 						   after over the fleet and the times it was not met*/
+typedef struct{
+	char text[FLEET_TEXT_SIZE];
+	uint64 * samples;
+	uint32 count;
+	uint32 size;
+	uint32 failed;
+}FLEET_StatType;
+
+/******************************************************************
+ * 				  Private Functions Prototypes					  *
+ ******************************************************************/
+static uint8 FLEET_copy(const char * source, char * target);
+static void * FLEET_worker(void * argument);
+static uint8 FLEET_take(FLEET_WorkerType * worker, uint32 * door);
+static void FLEET_run(FLEET_WorkerType * worker, uint32 number);
+static void FLEET_record(const SIM_DoorType * door, uint32 number);
+static int FLEET_compare(const void * first, const void * second);
+static void FLEET_report(double wall);
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+/*Configuration, read only while workers run*/
+static SIM_ProgramType g_scripts[FLEET_MAX_SCRIPTS];
+static uint32 g_scriptCount=0;
+static uint32 g_seed=1;
+static uint16 g_sessions=FLEET_DEFAULT_SESSIONS;
+static uint64 g_limit=SIM_MS(FLEET_DEFAULT_LIMIT_MS);
+static FILE * g_trace=NULL_PTR;
+static FLEET_WorkerType * g_workers;
+static uint32 g_workerCount;
+
+/*Results of finished doors*/
+static pthread_mutex_t g_statsLock=PTHREAD_MUTEX_INITIALIZER;
+static FLEET_StatType g_stats[FLEET_MAX_STATS];
+static uint32 g_statCount=0;
+static uint32 g_doorsFailed=0;
+static uint64 g_simulated=0;
+static uint64 g_frames=0;
+static uint64 g_eepromCycles=0;
+static uint64 g_eepromNacks=0;
+static uint32 g_eepromWear=0;
+
+/******************************************************************
+ * 				  	  Functions Definitions				 		  *
+ ******************************************************************/
+int main(int argc, char * argv[])
+{
+	char directory[FLEET_PATH_SIZE];
+	char path[FLEET_PATH_SIZE];
+	uint32 doors=FLEET_DEFAULT_DOORS;
+	long threads=sysconf(_SC_NPROCESSORS_ONLN);
+	struct timespec start;
+	struct timespec end;
+	FLEET_WorkerType * worker;
+	ssize_t length;
+	int option;
+	uint32 i;
+
+	length=readlink("/proc/self/exe",directory,sizeof(directory)-1);
+	directory[(length > 0) ? length : 0]='\0';
+	strcpy(directory,dirname(directory));
+	while((option=getopt(argc,argv,"vj:n:s:r:t:f:")) != -1)
+	{
+		switch(option)
+		{
+			case 'v': g_trace=stdout; break;
+			case 'j': threads=strtol(optarg,NULL_PTR,10); break;
+			case 'n': doors=strtoul(optarg,NULL_PTR,10); break;
+			case 's': g_seed=strtoul(optarg,NULL_PTR,10); break;
+			case 'r': g_sessions=strtoul(optarg,NULL_PTR,10); break;
+			case 't': g_limit=SIM_MS(strtoul(optarg,NULL_PTR,10)); break;
+			case 'f': snprintf(directory,sizeof(directory),"%s",optarg); break;
+			default:
+				fprintf(stderr,"usage: %s [-v] [-j threads] [-n doors] [-s seed] [-r sessions] [-t limit_ms] "
+						"[-f firmware_dir] [script...]\n",argv[0]);
+				return EXIT_FAILURE;
+		}
+	}
+	for(;optind < argc;optind++)
+	{
+		if((g_scriptCount == FLEET_MAX_SCRIPTS) || !SIM_scriptLoad(&g_scripts[g_scriptCount],argv[optind]))
+		{
+			fprintf(stderr,"fleet: can't load script %s\n",argv[optind]);
+			return EXIT_FAILURE;
+		}
+		g_scriptCount++;
+	}
+	g_workerCount=(threads < 1) ? 1 : (uint32)threads;
+	if(g_workerCount > doors)
+	{
+		g_workerCount=(doors == 0) ? 1 : doors;
+	}
+	g_workers=calloc(g_workerCount,sizeof(FLEET_WorkerType));
+
+	/*Doors are dealt to workers in turn, then idle workers balance the load by stealing*/
+	for(i=0;i<g_workerCount;i++)
+	{
+		worker=&g_workers[i];
+		worker->id=i;
+		worker->deque.doors=malloc(((doors/g_workerCount)+1)*sizeof(uint32));
+		pthread_mutex_init(&worker->deque.lock,NULL_PTR);
+		snprintf(path,sizeof(path),"%s/hmi_ecu.so",directory);
+		if(!FLEET_copy(path,worker->hmiPath))
+		{
+			return EXIT_FAILURE;
+		}
+		snprintf(path,sizeof(path),"%s/control_ecu.so",directory);
+		if(!FLEET_copy(path,worker->controlPath))
+		{
+			return EXIT_FAILURE;
+		}
+	}
+	for(i=0;i<doors;i++)
+	{
+		worker=&g_workers[i%g_workerCount];
+		worker->deque.doors[worker->deque.tail++]=i;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC,&start);
+	for(i=0;i<g_workerCount;i++)
+	{
+		pthread_create(&g_workers[i].thread,NULL_PTR,FLEET_worker,&g_workers[i]);
+	}
+	for(i=0;i<g_workerCount;i++)
+	{
+		pthread_join(g_workers[i].thread,NULL_PTR);
+		unlink(g_workers[i].hmiPath);
+		unlink(g_workers[i].controlPath);
+	}
+	clock_gettime(CLOCK_MONOTONIC,&end);
+
+	FLEET_report((double)(end.tv_sec-start.tv_sec)+((double)(end.tv_nsec-start.tv_nsec)*1e-9));
+	return (g_doorsFailed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/******************************************************************
+ * 				  Private Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function copies a firmware object to a temporary file. The dynamic
+ *loader opens a file once per process, a copy of its own gives a worker separate globals*/
+static uint8 FLEET_copy(const char * source, char * target)
+{
+	char buffer[65536];
+	ssize_t count;
+	int in;
+	int out;
+	strcpy(target,"/tmp/fleet-ecu-XXXXXX");
+	in=open(source,O_RDONLY);
+	out=mkstemp(target);
+	if((in < 0) || (out < 0))
+	{
+		perror(source);
+		return FALSE;
+	}
+	while((count=read(in,buffer,sizeof(buffer))) > 0)
+	{
+		if(write(out,buffer,count) != count)
+		{
+			perror(target);
+			return FALSE;
+		}
+	}
+	close(in);
+	close(out);
+	return TRUE;
+}
+
+/*Description: This function is the body of worker threads, it runs doors till there are
+ *none left on any worker*/
+static void * FLEET_worker(void * argument)
+{
+	FLEET_WorkerType * worker=argument;
+	uint32 door;
+	while(FLEET_take(worker,&door))
+	{
+		FLEET_run(worker,door);
+		worker->doors++;
+	}
+	return NULL_PTR;
+}
+
+/*Description: This function takes the next door of a worker, the last one dealt to it
+ *or else the first one waiting on another worker. No doors are added while running, so
+ *a worker finding all deques empty is done*/
+static uint8 FLEET_take(FLEET_WorkerType * worker, uint32 * door)
+{
+	FLEET_DequeType * deque=&worker->deque;
+	uint8 found=FALSE;
+	uint32 i;
+	pthread_mutex_lock(&deque->lock);
+	if(deque->tail != deque->head)
+	{
+		*door=deque->doors[--deque->tail];
+		found=TRUE;
+	}
+	pthread_mutex_unlock(&deque->lock);
+	for(i=1;(i < g_workerCount) && !found;i++)
+	{
+		deque=&g_workers[(worker->id+i)%g_workerCount].deque;
+		pthread_mutex_lock(&deque->lock);
+		if(deque->tail != deque->head)
+		{
+			*door=deque->doors[deque->head++];
+			found=TRUE;
+			worker->stolen++;
+		}
+		pthread_mutex_unlock(&deque->lock);
+	}
+	return found;
+}
+
+/*Description: This function runs a door from reset on the firmware copies of a worker*/
+static void FLEET_run(FLEET_WorkerType * worker, uint32 number)
+{
+	SIM_DoorType * door=&worker->door;
+	const SIM_ProgramType * program;
+	if(g_scriptCount != 0)
+	{
+		program=&g_scripts[number%g_scriptCount];
+	}
+	else
+	{
+		SIM_scriptRandom(&worker->program,g_seed+number,g_sessions);
+		program=&worker->program;
+	}
+	if(!SIM_ecuLoad(&door->hmi,"HMI",worker->hmiPath) || !SIM_ecuLoad(&door->control,"Control",worker->controlPath))
+	{
+		exit(EXIT_FAILURE);
+	}
+	if(!SIM_doorInit(door,program,NULL_PTR,g_trace))
+	{
+		exit(EXIT_FAILURE);
+	}
+	SIM_doorRun(door,g_limit);
+	FLEET_record(door,number);
+	SIM_doorDeinit(door);
+}
+
+/*Description: This function adds the latencies of a finished door to the fleet results*/
+static void FLEET_record(const SIM_DoorType * door, uint32 number)
+{
+	const SIM_ScriptType * script=&door->script;
+	const SIM_StepType * step;
+	FLEET_StatType * stat;
+	char text[FLEET_TEXT_SIZE];
+	uint32 i;
+	uint32 j;
+	pthread_mutex_lock(&g_statsLock);
+	g_simulated+=SIM_doorNow(door);
+	g_frames+=door->frames;
+	g_eepromCycles+=door->eeprom.cycles;
+	g_eepromNacks+=door->eeprom.busyNacks;
+	i=door->eeprom.image->writes[SIM_eepromMostWritten(&door->eeprom)];
+	if(i > g_eepromWear)
+	{
+		g_eepromWear=i;
+	}
+	if(!script->finished || (script->failures != 0))
+	{
+		if(g_doorsFailed < FLEET_MAX_REPORTED)
+		{
+			for(i=0;(i < script->current) && (script->latency[i] != SIM_FAILED);i++);
+			step=&script->program->steps[(i < script->program->count) ? i : script->program->count-1];
+			SIM_scriptDescribe(step,text,sizeof(text));
+			fprintf(stderr,"fleet: door %u (seed %u) failed at step %u: %s\n",number,
+					(g_scriptCount != 0) ? 0 : g_seed+number,step->line,text);
+		}
+		g_doorsFailed++;
+	}
+	for(i=0;i<script->current;i++)
+	{
+		step=&script->program->steps[i];
+		if((step->kind < SIM_STEP_EXPECT_LCD) || (step->kind > SIM_STEP_EXPECT_BUZZER))
+		{
+			continue;
+		}
+		SIM_scriptDescribe(step,text,sizeof(text));
+		for(j=0;(j < g_statCount) && strcmp(g_stats[j].text,text);j++);
+		if(j == FLEET_MAX_STATS)
+		{
+			continue;
+		}
+		stat=&g_stats[j];
+		if(j == g_statCount)
+		{
+			strcpy(stat->text,text);
+			g_statCount++;
+		}
+		if(script->latency[i] == SIM_FAILED)
+		{
+			stat->failed++;
+			continue;
+		}
+		if(stat->count == stat->size)
+		{
+			stat->size=(stat->size == 0) ? 1024 : stat->size*2;
+			stat->samples=realloc(stat->samples,stat->size*sizeof(uint64));
+		}
+		stat->samples[stat->count++]=script->latency[i];
+	}
+	pthread_mutex_unlock(&g_statsLock);
+}
+
+static int FLEET_compare(const void * first, const void * second)
+{
+	uint64 a=*(const uint64 *)first;
+	uint64 b=*(const uint64 *)second;
+	return (a > b) - (a < b);
+}
+
+/*Description: This function prints throughput of the fleet and latency percentiles (nearest
+ *rank) of each expectation in ms*/
+static void FLEET_report(double wall)
+{
+	static const double percent[]={0.50,0.90,0.99};
+	FLEET_StatType * stat;
+	uint32 doors=0;
+	uint32 stolen=0;
+	uint32 i;
+	uint32 j;
+	uint32 rank;
+	double simulated=(double)g_simulated/SIM_F_CPU;
+	for(i=0;i<g_workerCount;i++)
+	{
+		doors+=g_workers[i].doors;
+		stolen+=g_workers[i].stolen;
+	}
+	printf("%-32s %8s %10s %10s %10s %10s %7s\n","Latency (ms, from last key down)","count","p50","p90","p99","max","failed");
+	for(i=0;i<g_statCount;i++)
+	{
+		stat=&g_stats[i];
+		qsort(stat->samples,stat->count,sizeof(uint64),FLEET_compare);
+		printf("%-32s %8u",stat->text,stat->count);
+		for(j=0;j<3;j++)
+		{
+			rank=(uint32)(percent[j]*stat->count+0.999999);
+			printf(" %10.3f",(stat->count == 0) ? 0.0 : (double)stat->samples[(rank == 0) ? 0 : rank-1]*1000.0/SIM_F_CPU);
+		}
+		printf(" %10.3f %7u\n",(stat->count == 0) ? 0.0 : (double)stat->samples[stat->count-1]*1000.0/SIM_F_CPU,stat->failed);
+	}
+	printf("EEPROM: %llu write cycle(s), %llu busy NACK(s), most written cell of a door %u write(s)\n",
+		   (unsigned long long)g_eepromCycles,(unsigned long long)g_eepromNacks,g_eepromWear);
+	printf("%u door(s) on %u thread(s) (%u stolen), %u failed\n",doors,g_workerCount,stolen,g_doorsFailed);
+	printf("Simulated %.1f s in %.3f s: %.2f doors/s, x%.1f real time, %llu link frames\n",
+		   simulated,wall,(wall > 0) ? doors/wall : 0.0,(wall > 0) ? simulated/wall : 0.0,(unsigned long long)g_frames);
+}
@@ -0,0 +1,135 @@
+/*******************************************************************************************
+ * [FILE NAME]:		hal_adc_host.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains the model of ADC module of ATMEGA-16 for the host
+ * 					backend of the HAL. A conversion takes 13 ADC clocks (25 for the first
+ * 					one after ADC is enabled) from ADPS2:0 prescaler, the input is sampled
+ * 					from the environment 1.5 ADC clocks after the start (13.5 for the first
+ * 					one). Single conversions and free running mode are modelled, the other
+ * 					auto trigger sources of ADTS2:0 are not. Inputs are single-ended
+ *******************************************************************************************/
+
+#include "hal_host_private.h"
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[Structure Name]		 : HAL_AdcType
+ *[Structure Description]: This structure contains the state of ADC module*/
+typedef struct{
+	/*Conversion in progress, its sampling time and end*/
+	uint8 busy;
+	uint64 sample;
+	uint64 end;
+	/*Next conversion is the first one after ADC is enabled*/
+	uint8 first;
+}HAL_AdcType;
+
+/******************************************************************
+ * 				  Private Functions Prototypes					  *
+ ******************************************************************/
+static void HAL_adcStart(void);
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+static HAL_AdcType g_adc={FALSE,0,0,TRUE};
+
+/*ADC clock prescaler selected by ADPS2:0*/
+static const uint32 g_adcPrescalers[8]={2,2,4,8,16,32,64,128};
+
+/******************************************************************
+ * 				  Private Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function applies a firmware write on an ADC register: writing ADIF one
+ *clears it, writing ADSC one starts a conversion and clearing ADEN aborts it*/
+void HAL_adcWrite(HAL_RegId id, uint32 value)
+{
+	uint32 old;
+	switch(id)
+	{
+		case HAL_ADCSRA:
+			old=g_halReg[HAL_ADCSRA];
+			/*ADIF is kept unless one is written to it*/
+			if(IS_BIT_SET(old,ADIF) && IS_BIT_CLEAR(value,ADIF))
+			{
+				value|=(1<<ADIF);
+			}
+			else
+			{
+				value&=~(1<<ADIF);
+			}
+			if(IS_BIT_CLEAR(value,ADEN))
+			{
+				g_adc.busy=FALSE;
+				g_adc.first=TRUE;
+				value&=~(1<<ADSC);
+			}
+			else if(g_adc.busy)
+			{
+				/*ADSC reads one till the conversion completes*/
+				value|=(1<<ADSC);
+			}
+			g_halReg[HAL_ADCSRA]=value;
+			if(IS_BIT_SET(value,ADSC) && !g_adc.busy)
+			{
+				HAL_adcStart();
+			}
+			break;
+		case HAL_ADC:
+			/*Data register is read only*/
+			break;
+		default:
+			g_halReg[id]=value;
+			break;
+	}
+}
+
+/*Description: This function returns the time of the next ADC event*/
+uint64 HAL_adcNextEvent(void)
+{
+	return g_adc.busy ? g_adc.end : HAL_HOST_NEVER;
+}
+
+/*Description: This function completes a conversion due at the current time: the result
+ *goes to ADC (left adjusted if ADLAR is set) and ADIF is set. In free running mode the next
+ *conversion starts at once*/
+void HAL_adcProcess(void)
+{
+	uint16 result=0;
+	if(!g_adc.busy || (g_adc.end > g_halNow))
+	{
+		return;
+	}
+	g_adc.busy=FALSE;
+	if((g_halEnv != NULL_PTR) && (g_halEnv->adcRead != NULL_PTR))
+	{
+		result=g_halEnv->adcRead((uint8)(g_halReg[HAL_ADMUX] & 0x1F),g_adc.sample);
+	}
+	if(result > 0x3FF)
+	{
+		result=0x3FF;
+	}
+	g_halReg[HAL_ADC]=IS_BIT_SET(g_halReg[HAL_ADMUX],ADLAR) ? (uint32)(result<<6) : result;
+	SET_BIT(g_halReg[HAL_ADCSRA],ADIF);
+	if(IS_BIT_SET(g_halReg[HAL_ADCSRA],ADATE) && ((g_halReg[HAL_SFIOR]>>ADTS0) == 0))
+	{
+		HAL_adcStart();
+	}
+	else
+	{
+		CLEAR_BIT(g_halReg[HAL_ADCSRA],ADSC);
+	}
+}
+
+/*Description: This function starts a conversion now*/
+static void HAL_adcStart(void)
+{
+	uint32 prescale=g_adcPrescalers[g_halReg[HAL_ADCSRA] & 0x07];
+	g_adc.busy=TRUE;
+	g_adc.sample=g_halNow+(g_adc.first ? (27u*prescale)/2u : (3u*prescale)/2u);
+	g_adc.end=g_halNow+(g_adc.first ? 25u : 13u)*prescale;
+	g_adc.first=FALSE;
+	SET_BIT(g_halReg[HAL_ADCSRA],ADSC);
+}
@@ -0,0 +1,161 @@
+/*******************************************************************************************
+ * [FILE NAME]:		hal_extint_host.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains the model of external inputs and interrupts of
+ * 					ATMEGA-16 for the host backend of the HAL: the environment drives input
+ * 					pins at given times and the edges on INT0 (PD2), INT1 (PD3) and INT2 (PB2)
+ * 					set their flags as selected by ISC bits of MCUCR/MCUCSR. Low level sense
+ * 					of INT0/INT1 isn't modelled
+ *******************************************************************************************/
+
+#include "hal_host_private.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+/*Number of pins: 4 ports of 8 pins*/
+#define HAL_PINS				32u
+#define HAL_PIN_INDEX(PORT,PIN)	(((PORT)*8u)+(PIN))
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[Structure Name]		 : HAL_PinChangeType
+ *[Structure Description]: This structure contains the next level an input pin is driven
+ * 						   to and its time*/
+typedef struct{
+	uint8 pending;
+	uint8 level;
+	uint64 time;
+}HAL_PinChangeType;
+
+/******************************************************************
+ * 				  Private Functions Prototypes					  *
+ ******************************************************************/
+static void HAL_extintEdge(uint8 index, uint8 level);
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+/*Pins driven by the environment and their levels, per port*/
+static uint8 g_driven[4]={0,0,0,0};
+static uint8 g_levels[4]={0,0,0,0};
+
+/*Next change of each pin and the number of pins with a change, pins are looked through
+ *only when there is one as the next event is asked for on each run of the HAL*/
+static HAL_PinChangeType g_changes[HAL_PINS];
+static uint8 g_pending=0;
+
+/******************************************************************
+ * 				  Public Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function drives an input pin to a level from a given time on, a change
+ *not applied yet on the same pin is replaced*/
+void HAL_hostPinChange(uint8 port, uint8 pin, uint8 level, uint64 time)
+{
+	HAL_PinChangeType * change=&g_changes[HAL_PIN_INDEX(port,pin)];
+	if(!change->pending)
+	{
+		g_pending++;
+	}
+	change->pending=TRUE;
+	change->level=level ? 1u : 0u;
+	change->time=(time < g_halNow) ? g_halNow : time;
+}
+
+/******************************************************************
+ * 				  Private Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function returns the levels of a port with the pins driven by the
+ *environment replaced*/
+uint8 HAL_extintApply(uint8 port, uint8 value)
+{
+	return (uint8)((value & ~g_driven[port]) | (g_levels[port] & g_driven[port]));
+}
+
+/*Description: This function returns the time of the next pin change*/
+uint64 HAL_extintNextEvent(void)
+{
+	uint64 next=HAL_HOST_NEVER;
+	uint8 i;
+	if(g_pending == 0)
+	{
+		return HAL_HOST_NEVER;
+	}
+	for(i=0;i<HAL_PINS;i++)
+	{
+		if(g_changes[i].pending && (g_changes[i].time < next))
+		{
+			next=g_changes[i].time;
+		}
+	}
+	return next;
+}
+
+/*Description: This function applies the pin changes due at the current time, a pin
+ *which wasn't driven before is taken as it read (its pull-up or output)*/
+void HAL_extintProcess(void)
+{
+	uint8 i;
+	uint8 port;
+	uint8 bit;
+	uint8 old;
+	for(i=0;(i<HAL_PINS) && (g_pending != 0);i++)
+	{
+		if(!g_changes[i].pending || (g_changes[i].time > g_halNow))
+		{
+			continue;
+		}
+		g_changes[i].pending=FALSE;
+		g_pending--;
+		port=i/8u;
+		bit=i%8u;
+		old=IS_BIT_SET(g_driven[port],bit) ? ((g_levels[port]>>bit) & 1u) : ((g_halReg[HAL_PORTA+(port*3)]>>bit) & 1u);
+		SET_BIT(g_driven[port],bit);
+		if(g_changes[i].level)
+		{
+			SET_BIT(g_levels[port],bit);
+		}
+		else
+		{
+			CLEAR_BIT(g_levels[port],bit);
+		}
+		if(old != g_changes[i].level)
+		{
+			HAL_extintEdge(i,g_changes[i].level);
+		}
+	}
+}
+
+/*Description: This function sets the flag of an external interrupt on an edge of its pin
+ *if the edge is selected by its sense control bits (any change, falling or rising)*/
+static void HAL_extintEdge(uint8 index, uint8 level)
+{
+	uint8 sense;
+	switch(index)
+	{
+		case HAL_PIN_INDEX(3u,2u):
+			sense=(uint8)((g_halReg[HAL_MCUCR]>>ISC00) & 0x03);
+			if((sense == 1u) || (sense == (level ? 3u : 2u)))
+			{
+				SET_BIT(g_halReg[HAL_GIFR],INTF0);
+			}
+			break;
+		case HAL_PIN_INDEX(3u,3u):
+			sense=(uint8)((g_halReg[HAL_MCUCR]>>ISC10) & 0x03);
+			if((sense == 1u) || (sense == (level ? 3u : 2u)))
+			{
+				SET_BIT(g_halReg[HAL_GIFR],INTF1);
+			}
+			break;
+		case HAL_PIN_INDEX(1u,2u):
+			if((IS_BIT_SET(g_halReg[HAL_MCUCSR],ISC2) ? 1u : 0u) == level)
+			{
+				SET_BIT(g_halReg[HAL_GIFR],INTF2);
+			}
+			break;
+		default:
+			break;
+	}
+}
@@ -0,0 +1,624 @@
+/*******************************************************************************************
+ * [FILE NAME]:		hal_host.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains the core of the Linux host backend of the register
+ * 					level HAL: register slots, virtual time, interrupt dispatch, GPIO model
+ * 					and the default stdio environment
+ *******************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <poll.h>
+#include "hal_host_private.h"
+
+/******************************************************************
+ * 				   			 Macros					      		  *
+ ******************************************************************/
+/*Marker bit put in each slot value handed to firmware, a plain assignment by firmware
+ *clears it, so a write is found even if the same value is written again*/
+#define HAL_SLOT_MARK			0x01000000UL
+
+/*Period in CPU cycles the default environment checks stdin at (1 ms)*/
+#define HAL_STDIO_PERIOD		(F_CPU/1000u)
+
+/*Number of interrupt vectors of ATMEGA-16 excluding reset*/
+#define HAL_VECTORS				20u
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[Structure Name]		 : HAL_VectorType
+ *[Structure Description]: This structure describes an interrupt source: its flag bit,
+ * 						   its enable bit, if the flag is cleared by running the vector and
+ * 						   the vector function defined by firmware (if any)*/
+typedef struct{
+	HAL_RegId flagReg;
+	uint8 flagBit;
+	HAL_RegId enableReg;
+	uint8 enableBit;
+	uint8 autoClear;
+	void (*vector)(void);
+}HAL_VectorType;
+
+/******************************************************************
+ * 				  Interrupt Vectors (weak)						  *
+ ******************************************************************/
+/*Vectors are weak so firmware only defines the ones it uses*/
+extern void INT0_vect(void) __attribute__((weak));
+extern void INT1_vect(void) __attribute__((weak));
+extern void TIMER2_COMP_vect(void) __attribute__((weak));
+extern void TIMER2_OVF_vect(void) __attribute__((weak));
+extern void TIMER1_CAPT_vect(void) __attribute__((weak));
+extern void TIMER1_COMPA_vect(void) __attribute__((weak));
+extern void TIMER1_COMPB_vect(void) __attribute__((weak));
+extern void TIMER1_OVF_vect(void) __attribute__((weak));
+extern void TIMER0_OVF_vect(void) __attribute__((weak));
+extern void SPI_STC_vect(void) __attribute__((weak));
+extern void USART_RXC_vect(void) __attribute__((weak));
+extern void USART_UDRE_vect(void) __attribute__((weak));
+extern void USART_TXC_vect(void) __attribute__((weak));
+extern void ADC_vect(void) __attribute__((weak));
+extern void TWI_vect(void) __attribute__((weak));
+extern void INT2_vect(void) __attribute__((weak));
+extern void TIMER0_COMP_vect(void) __attribute__((weak));
+
+/******************************************************************
+ * 				  Private Functions Prototypes					  *
+ ******************************************************************/
+static void HAL_hostSync(void);
+static void HAL_hostSyncSlot(HAL_RegId id);
+static void HAL_hostWrite(HAL_RegId id, uint32 value);
+static void HAL_hostExpose(HAL_RegId id);
+static uint8 HAL_hostDispatch(void);
+static uint64 HAL_hostNextEvent(void);
+static void HAL_hostRunUntil(uint64 target);
+static void HAL_hostIdle(void);
+static void HAL_stdioUartTx(uint16 data, uint64 end);
+static void HAL_stdioSync(void);
+static void HAL_stdioIdle(void);
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+/*Registers start with their reset values*/
+uint32 g_halReg[HAL_REG_COUNT]={[HAL_UCSRA]=(1<<UDRE),[HAL_UCSRC]=(1<<UCSZ1)|(1<<UCSZ0),
+								[HAL_TWSR]=0xF8,[HAL_TWDR]=0xFF};
+uint64 g_halNow=0;
+
+/*Slot of each register handed to firmware and the value put in it by the model*/
+static volatile uint32 g_halSlot[HAL_REG_COUNT];
+static uint32 g_halExposed[HAL_REG_COUNT];
+
+/*Slots handed to firmware since the last synchronisation, only these may have been written.
+ *All slots are checked if more were handed than the list holds*/
+static HAL_RegId g_handed[HAL_HANDED_SLOTS];
+static uint8 g_handedCount=0;
+
+/*UDR was accessed and not written since, so the access was a read*/
+static uint8 g_udrReadPending=FALSE;
+
+/*Busy-wait detection state*/
+static HAL_RegId g_lastId=HAL_REG_COUNT;
+static uint32 g_lastValue=0;
+static uint8 g_spinCount=0;
+
+/*Number of vectors run, and its value when interrupts were last enabled: a vector run
+ *since then is the interrupt which wakes a sleep following sei*/
+static uint32 g_dispatches=0;
+static uint32 g_wakeMark=0;
+
+/*Time the environment allows the ECU to run to before synchronising*/
+static uint64 g_halHorizon=0;
+
+/*stdin of default environment reached end of file*/
+static uint8 g_stdinClosed=FALSE;
+
+/*Default environment: UART frames go to stdout and come from stdin*/
+static const HAL_HostEnvType g_stdioEnv={HAL_stdioUartTx,NULL_PTR,NULL_PTR,HAL_stdioSync,HAL_stdioIdle,NULL_PTR,NULL_PTR,NULL_PTR};
+const HAL_HostEnvType * g_halEnv=&g_stdioEnv;
+
+/*Interrupt sources in ATMEGA-16 priority order*/
+static const HAL_VectorType g_vectors[HAL_VECTORS]={
+	{HAL_GIFR,INTF0,HAL_GICR,INT0,TRUE,INT0_vect},
+	{HAL_GIFR,INTF1,HAL_GICR,INT1,TRUE,INT1_vect},
+	{HAL_TIFR,OCF2,HAL_TIMSK,OCIE2,TRUE,TIMER2_COMP_vect},
+	{HAL_TIFR,TOV2,HAL_TIMSK,TOIE2,TRUE,TIMER2_OVF_vect},
+	{HAL_TIFR,ICF1,HAL_TIMSK,TICIE1,TRUE,TIMER1_CAPT_vect},
+	{HAL_TIFR,OCF1A,HAL_TIMSK,OCIE1A,TRUE,TIMER1_COMPA_vect},
+	{HAL_TIFR,OCF1B,HAL_TIMSK,OCIE1B,TRUE,TIMER1_COMPB_vect},
+	{HAL_TIFR,TOV1,HAL_TIMSK,TOIE1,TRUE,TIMER1_OVF_vect},
+	{HAL_TIFR,TOV0,HAL_TIMSK,TOIE0,TRUE,TIMER0_OVF_vect},
+	{HAL_SPSR,SPIF,HAL_SPCR,SPIE,TRUE,SPI_STC_vect},
+	{HAL_UCSRA,RXC,HAL_UCSRB,RXCIE,FALSE,USART_RXC_vect},
+	{HAL_UCSRA,UDRE,HAL_UCSRB,UDRIE,FALSE,USART_UDRE_vect},
+	{HAL_UCSRA,TXC,HAL_UCSRB,TXCIE,TRUE,USART_TXC_vect},
+	{HAL_ADCSRA,ADIF,HAL_ADCSRA,ADIE,TRUE,ADC_vect},
+	{HAL_REG_COUNT,0,HAL_REG_COUNT,0,FALSE,NULL_PTR},	/*EE_RDY not modelled*/
+	{HAL_REG_COUNT,0,HAL_REG_COUNT,0,FALSE,NULL_PTR},	/*ANA_COMP not modelled*/
+	{HAL_TWCR,TWINT,HAL_TWCR,TWIE,FALSE,TWI_vect},
+	{HAL_GIFR,INTF2,HAL_GICR,INT2,TRUE,INT2_vect},
+	{HAL_TIFR,OCF0,HAL_TIMSK,OCIE0,TRUE,TIMER0_COMP_vect},
+	{HAL_REG_COUNT,0,HAL_REG_COUNT,0,FALSE,NULL_PTR}	/*SPM_RDY not modelled*/
+};
+
+/******************************************************************
+ * 				  Public Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function returns the register slot of the given register after
+ *bringing the peripheral models up to date, it's what each register name expands to:
+ * 1. Applies the writes done by firmware in slots since the last access
+ * 2. Charges the access time and serves due interrupts
+ * 3. Puts the current register value in its slot
+ * 4. If firmware keeps reading the same unchanged value, time jumps to the next event*/
+volatile uint32 * HAL_hostAccess(HAL_RegId id)
+{
+	HAL_hostSync();
+	HAL_hostRunUntil(g_halNow+HAL_ACCESS_CYCLES);
+	HAL_hostExpose(id);
+	if((id == g_lastId) && (g_halSlot[id] == g_lastValue))
+	{
+		g_spinCount++;
+		if(g_spinCount >= HAL_SPIN_ACCESSES)
+		{
+			g_spinCount=0;
+			HAL_hostIdle();
+			HAL_hostExpose(id);
+		}
+	}
+	else
+	{
+		g_spinCount=0;
+	}
+	g_lastId=id;
+	g_lastValue=g_halSlot[id];
+	if(id == HAL_UDR)
+	{
+		g_udrReadPending=TRUE;
+	}
+	if(g_handedCount < HAL_HANDED_SLOTS)
+	{
+		g_handed[g_handedCount]=id;
+	}
+	if(g_handedCount <= HAL_HANDED_SLOTS)
+	{
+		g_handedCount++;
+	}
+	return &g_halSlot[id];
+}
+
+/*Description: This function enables/disables global interrupts (I bit of SREG)*/
+void HAL_hostSetInterrupts(uint8 enable)
+{
+	HAL_hostSync();
+	if(enable)
+	{
+		g_wakeMark=g_dispatches;
+		SET_BIT(g_halReg[HAL_SREG],SREG_I);
+		HAL_hostDispatch();
+	}
+	else
+	{
+		CLEAR_BIT(g_halReg[HAL_SREG],SREG_I);
+	}
+}
+
+/*Description: This function advances virtual time by a number of CPU cycles while
+ *peripherals keep running and interrupts are served*/
+void HAL_hostDelay(uint64 cycles)
+{
+	HAL_hostSync();
+	HAL_hostRunUntil(g_halNow+cycles);
+}
+
+/*Description: This function is the sleep instruction. On the chip the instruction after
+ *sei runs before a pending interrupt, which then wakes the CPU from the sleep; here sei
+ *serves it at once, so a vector run since interrupts were last enabled ends the sleep as
+ *well. Otherwise time moves event by event till a vector runs. A sleep with SE cleared or
+ *interrupts disabled returns at once (the flag of a disabled interrupt isn't modelled as a
+ *wake source)*/
+void HAL_hostSleep(void)
+{
+	HAL_hostSync();
+	if(IS_BIT_CLEAR(g_halReg[HAL_MCUCR],SE) || IS_BIT_CLEAR(g_halReg[HAL_SREG],SREG_I))
+	{
+		return;
+	}
+	while(g_dispatches == g_wakeMark)
+	{
+		HAL_hostIdle();
+	}
+}
+
+/*Description: This function returns the virtual time in CPU cycles since reset*/
+uint64 HAL_hostNow(void)
+{
+	return g_halNow;
+}
+
+/*Description: This function connects the modelled peripherals to an environment,
+ *NULL_PTR restores the default stdio environment*/
+void HAL_hostSetEnvironment(const HAL_HostEnvType * env)
+{
+	g_halEnv=(env == NULL_PTR) ? &g_stdioEnv : env;
+}
+
+/*Description: This function sets the time the ECU may run to before calling env sync*/
+void HAL_hostSetHorizon(uint64 time)
+{
+	g_halHorizon=time;
+}
+
+/*Description: This function hands the pins of a port to the environment, pins driven by
+ *timers compare outputs take the level of the compare unit instead of PORTx bit*/
+void HAL_hostPortUpdate(uint8 port)
+{
+	uint8 out;
+	if((g_halEnv != NULL_PTR) && (g_halEnv->gpioWrite != NULL_PTR))
+	{
+		out=HAL_timerPortOutput(port,(uint8)g_halReg[HAL_PORTA+(port*3)]);
+		g_halEnv->gpioWrite(port,g_halReg[HAL_DDRA+(port*3)],out);
+	}
+}
+
+/******************************************************************
+ * 				  Private Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function finds the slots written by firmware since the last access,
+ *hands their values to the models and completes a pending UDR read. Only slots handed
+ *since the last synchronisation are checked, which is the one of the last access unless
+ *there are more than HAL_HANDED_SLOTS*/
+static void HAL_hostSync(void)
+{
+	uint8 i;
+	if(g_handedCount > HAL_HANDED_SLOTS)
+	{
+		for(i=0;i<HAL_REG_COUNT;i++)
+		{
+			HAL_hostSyncSlot((HAL_RegId)i);
+		}
+	}
+	else
+	{
+		for(i=0;i<g_handedCount;i++)
+		{
+			HAL_hostSyncSlot(g_handed[i]);
+		}
+	}
+	g_handedCount=0;
+	if(g_udrReadPending)
+	{
+		g_udrReadPending=FALSE;
+		HAL_uartReadDone();
+	}
+	HAL_hostDispatch();
+}
+
+/*Description: This function hands the value firmware wrote in a slot to the model*/
+static void HAL_hostSyncSlot(HAL_RegId id)
+{
+	uint32 value;
+	if(g_halSlot[id] == g_halExposed[id])
+	{
+		return;
+	}
+	value=g_halSlot[id];
+	/*16-bit registers keep 16 bits, the rest keep 8 bits*/
+	if((id == HAL_TCNT1) || (id == HAL_OCR1A) || (id == HAL_OCR1B) || (id == HAL_ICR1) || (id == HAL_ADC))
+	{
+		value &= 0xFFFF;
+	}
+	else
+	{
+		value &= 0xFF;
+	}
+	if(id == HAL_UDR)
+	{
+		g_udrReadPending=FALSE;
+	}
+	g_spinCount=0;
+	HAL_hostWrite(id,value);
+	g_halExposed[id]=g_halReg[id] | HAL_SLOT_MARK;
+	g_halSlot[id]=g_halExposed[id];
+}
+
+/*Description: This function applies a firmware write on the model of the register*/
+static void HAL_hostWrite(HAL_RegId id, uint32 value)
+{
+	uint8 port;
+	switch(id)
+	{
+		case HAL_PINA: case HAL_PINB: case HAL_PINC: case HAL_PIND:
+			/*Input pins registers are read only*/
+			break;
+		case HAL_PORTA: case HAL_PORTB: case HAL_PORTC: case HAL_PORTD:
+		case HAL_DDRA: case HAL_DDRB: case HAL_DDRC: case HAL_DDRD:
+			g_halReg[id]=value;
+			port=(id-HAL_PINA)/3;
+			HAL_hostPortUpdate(port);
+			break;
+		case HAL_UDR: case HAL_UCSRA: case HAL_UCSRB: case HAL_UCSRC: case HAL_UBRRL: case HAL_UBRRH:
+			HAL_uartWrite(id,value);
+			break;
+		case HAL_TWBR: case HAL_TWSR: case HAL_TWAR: case HAL_TWDR: case HAL_TWCR:
+			HAL_twiWrite(id,value);
+			break;
+		case HAL_TCCR1A: case HAL_TCCR1B: case HAL_TCNT1: case HAL_OCR1A: case HAL_OCR1B: case HAL_ICR1:
+		case HAL_TCCR0: case HAL_TCNT0: case HAL_OCR0: case HAL_TCCR2: case HAL_TCNT2: case HAL_OCR2:
+			HAL_timerWrite(id,value);
+			break;
+		case HAL_SPCR: case HAL_SPSR: case HAL_SPDR:
+			HAL_spiWrite(id,value);
+			break;
+		case HAL_ADMUX: case HAL_ADCSRA: case HAL_ADC:
+			HAL_adcWrite(id,value);
+			break;
+		case HAL_TIFR: case HAL_GIFR:
+			/*Flags are cleared by writing logic one to them*/
+			g_halReg[id] &= ~value;
+			break;
+		default:
+			g_halReg[id]=value;
+			break;
+	}
+}
+
+/*Description: This function puts the current value of a register in its slot*/
+static void HAL_hostExpose(HAL_RegId id)
+{
+	uint8 port;
+	switch(id)
+	{
+		case HAL_PINA: case HAL_PINB: case HAL_PINC: case HAL_PIND:
+			port=(id-HAL_PINA)/3;
+			if((g_halEnv != NULL_PTR) && (g_halEnv->gpioRead != NULL_PTR))
+			{
+				g_halReg[id]=g_halEnv->gpioRead(port,g_halReg[HAL_DDRA+(port*3)],g_halReg[HAL_PORTA+(port*3)]);
+			}
+			else
+			{
+				/*Nothing connected: outputs read back, inputs read their pull-up*/
+				g_halReg[id]=g_halReg[HAL_PORTA+(port*3)];
+			}
+			/*Pins driven by the environment over the above*/
+			g_halReg[id]=HAL_extintApply(port,(uint8)g_halReg[id]);
+			break;
+		case HAL_UDR:
+			HAL_uartRead(id);
+			break;
+		case HAL_TCNT1: case HAL_TCNT0: case HAL_TCNT2:
+			HAL_timerRead(id);
+			break;
+		case HAL_SPSR: case HAL_SPDR:
+			HAL_spiRead(id);
+			break;
+		default:
+			break;
+	}
+	g_halExposed[id]=g_halReg[id] | HAL_SLOT_MARK;
+	g_halSlot[id]=g_halExposed[id];
+}
+
+/*Description: This function runs the vector of the highest priority pending interrupt,
+ *only one vector is run per call as the chip runs one instruction after each RETI.
+ *It returns TRUE if a vector was run*/
+static uint8 HAL_hostDispatch(void)
+{
+	uint8 i;
+	const HAL_VectorType * source;
+	if(IS_BIT_CLEAR(g_halReg[HAL_SREG],SREG_I))
+	{
+		return FALSE;
+	}
+	for(i=0;i<HAL_VECTORS;i++)
+	{
+		source=&g_vectors[i];
+		if((source->flagReg != HAL_REG_COUNT) && IS_BIT_SET(g_halReg[source->flagReg],source->flagBit)
+		   && IS_BIT_SET(g_halReg[source->enableReg],source->enableBit))
+		{
+			if(source->autoClear)
+			{
+				CLEAR_BIT(g_halReg[source->flagReg],source->flagBit);
+			}
+			/*Hardware clears I bit on entry and RETI sets it back*/
+			CLEAR_BIT(g_halReg[HAL_SREG],SREG_I);
+			g_dispatches++;
+			if(source->vector != NULL_PTR)
+			{
+				source->vector();
+			}
+			else if(!source->autoClear)
+			{
+				/*Level source without handler would fire forever, disable it*/
+				CLEAR_BIT(g_halReg[source->enableReg],source->enableBit);
+			}
+			HAL_hostSync();
+			SET_BIT(g_halReg[HAL_SREG],SREG_I);
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+/*Description: This function returns the time of the nearest peripheral event*/
+static uint64 HAL_hostNextEvent(void)
+{
+	uint64 next=HAL_uartNextEvent();
+	uint64 event=HAL_twiNextEvent();
+	if(event < next)
+	{
+		next=event;
+	}
+	event=HAL_timerNextEvent();
+	if(event < next)
+	{
+		next=event;
+	}
+	event=HAL_spiNextEvent();
+	if(event < next)
+	{
+		next=event;
+	}
+	event=HAL_adcNextEvent();
+	if(event < next)
+	{
+		next=event;
+	}
+	event=HAL_extintNextEvent();
+	if(event < next)
+	{
+		next=event;
+	}
+	return next;
+}
+
+/*Description: This function moves virtual time to target event by event, and hands
+ *control to the environment each time the horizon is reached*/
+static void HAL_hostRunUntil(uint64 target)
+{
+	uint64 next=HAL_hostNextEvent();
+	/*Fast path: no event till target, time just moves (interrupts pending now were served by
+	 *the synchronisation before)*/
+	if((next > target) && (target <= g_halHorizon))
+	{
+		if(target > g_halNow)
+		{
+			g_halNow=target;
+		}
+		return;
+	}
+	while(1)
+	{
+		next=HAL_hostNextEvent();
+		if(next > target)
+		{
+			next=target;
+		}
+		if(next > g_halHorizon)
+		{
+			if(g_halNow < g_halHorizon)
+			{
+				g_halNow=g_halHorizon;
+			}
+			if((g_halEnv != NULL_PTR) && (g_halEnv->sync != NULL_PTR))
+			{
+				g_halEnv->sync();
+			}
+			else
+			{
+				g_halHorizon=HAL_HOST_NEVER;
+			}
+			continue;
+		}
+		if(next > g_halNow)
+		{
+			g_halNow=next;
+		}
+		HAL_uartProcess();
+		HAL_twiProcess();
+		HAL_timerProcess();
+		HAL_spiProcess();
+		HAL_adcProcess();
+		HAL_extintProcess();
+		/*Flags raised while a vector ran are served before time moves to the next event*/
+		while(HAL_hostDispatch());
+		if((g_halNow >= target) && (HAL_hostNextEvent() > g_halNow))
+		{
+			break;
+		}
+	}
+}
+
+/*Description: This function is called when firmware busy-waits, it moves time to the
+ *next event or to the horizon, or asks the environment for input if nothing is pending*/
+static void HAL_hostIdle(void)
+{
+	uint64 next=HAL_hostNextEvent();
+	if(next > g_halHorizon)
+	{
+		next=g_halHorizon;
+	}
+	if(next == HAL_HOST_NEVER)
+	{
+		if((g_halEnv != NULL_PTR) && (g_halEnv->idle != NULL_PTR))
+		{
+			g_halEnv->idle();
+		}
+		else
+		{
+			fprintf(stderr,"hal_host: firmware waits for an event that will never come\n");
+			exit(EXIT_FAILURE);
+		}
+		return;
+	}
+	HAL_hostRunUntil(next);
+	if((g_halNow >= g_halHorizon) && (g_halEnv != NULL_PTR) && (g_halEnv->sync != NULL_PTR))
+	{
+		g_halEnv->sync();
+	}
+}
+
+/*Description: Default environment, sends UART frames to stdout*/
+static void HAL_stdioUartTx(uint16 data, uint64 end)
+{
+	uint8 byte=(uint8)data;
+	(void)end;
+	if(write(STDOUT_FILENO,&byte,1) != 1)
+	{
+		exit(EXIT_FAILURE);
+	}
+}
+
+/*Description: Default environment, receives a byte waiting on stdin (if any) each
+ *HAL_STDIO_PERIOD of virtual time, so input is taken while firmware is kept busy by timers.
+ *A byte is only taken when the receiver is enabled and empty so none is lost*/
+static void HAL_stdioSync(void)
+{
+	struct pollfd input={STDIN_FILENO,POLLIN,0};
+	uint8 byte;
+	if(g_stdinClosed)
+	{
+		g_halHorizon=HAL_HOST_NEVER;
+		return;
+	}
+	if(IS_BIT_SET(g_halReg[HAL_UCSRB],RXEN) && IS_BIT_CLEAR(g_halReg[HAL_UCSRA],RXC) && (poll(&input,1,0) > 0))
+	{
+		if(read(STDIN_FILENO,&byte,1) == 1)
+		{
+			HAL_hostUartReceive(byte,g_halNow);
+		}
+		else
+		{
+			g_stdinClosed=TRUE;
+		}
+	}
+	g_halHorizon=g_halNow+HAL_STDIO_PERIOD;
+}
+
+/*Description: Default environment, blocks till a byte comes on stdin and receives it by
+ *UART at the current virtual time. The program ends when firmware waits and stdin is closed*/
+static void HAL_stdioIdle(void)
+{
+	uint8 byte;
+	if(g_stdinClosed || (read(STDIN_FILENO,&byte,1) != 1))
+	{
+		exit(EXIT_SUCCESS);
+	}
+	HAL_hostUartReceive(byte,g_halNow);
+}
+
+/*Description: Firmware is built with -finstrument-functions, each called function is
+ *charged HAL_CALL_CYCLES so loops which only poll RAM still let time advance*/
+void __attribute__((no_instrument_function)) __cyg_profile_func_enter(void * fn, void * site)
+{
+	(void)fn;
+	(void)site;
+	HAL_hostDelay(HAL_CALL_CYCLES);
+}
+
+void __attribute__((no_instrument_function)) __cyg_profile_func_exit(void * fn, void * site)
+{
+	(void)fn;
+	(void)site;
+}
@@ -0,0 +1,391 @@
+/*******************************************************************************************
+ * [FILE NAME]:		hal_host.h
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This header file is the Linux host backend of the register level HAL.
+ * 					It replaces <avr/io.h>, <util/delay.h>, <avr/interrupt.h>,
+ * 					<avr/pgmspace.h> and <avr/sleep.h> when the ECUs are built with
+ * 					HOST_BUILD defined, so
+ * 					drivers and application code build as native programs unchanged:
+ * 					1. Each register name expands to an access function call which keeps
+ * 					   the software models of UART, TWI, TIMER1 and GPIO up to date
+ * 					2. Time is virtual and counted in F_CPU cycles, it advances with each
+ * 					   register access, called function and _delay_ms/_delay_us
+ * 					3. Interrupts are raised between register accesses like on the chip
+ *******************************************************************************************/
+#ifndef HAL_HOST_H_
+#define HAL_HOST_H_
+
+/******************************************************************
+ * 				Common Header Files Inclusion					  *
+ ******************************************************************/
+#include "std_types.h"
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[ENUM Name]		: HAL_RegId
+ *[ENUM Description]: This enum contains the modelled I/O registers of ATMEGA-16*/
+typedef enum{
+	HAL_PINA,HAL_PORTA,HAL_DDRA,HAL_PINB,HAL_PORTB,HAL_DDRB,
+	HAL_PINC,HAL_PORTC,HAL_DDRC,HAL_PIND,HAL_PORTD,HAL_DDRD,
+	HAL_UDR,HAL_UCSRA,HAL_UCSRB,HAL_UCSRC,HAL_UBRRL,HAL_UBRRH,
+	HAL_TWBR,HAL_TWSR,HAL_TWAR,HAL_TWDR,HAL_TWCR,
+	HAL_TCCR1A,HAL_TCCR1B,HAL_TCNT1,HAL_OCR1A,HAL_OCR1B,HAL_ICR1,
+	HAL_TCCR0,HAL_TCNT0,HAL_OCR0,HAL_TCCR2,HAL_TCNT2,HAL_OCR2,HAL_ASSR,
+	HAL_TIMSK,HAL_TIFR,HAL_GICR,HAL_GIFR,HAL_MCUCR,HAL_MCUCSR,HAL_SFIOR,
+	HAL_ADMUX,HAL_ADCSRA,HAL_ADC,HAL_SPCR,HAL_SPSR,HAL_SPDR,HAL_SREG,
+	HAL_REG_COUNT
+}HAL_RegId;
+
+/*[Structure Name]		 : HAL_TwiDeviceType
+ *[Structure Description]: This structure contains the callbacks of a slave device attached
+ * 						   to the modelled TWI bus, each one is called when the master
+ * 						   finishes the matching bus operation:
+ * 						   1. address: SLA+R/W byte after (repeated) START, returns TRUE to ACK
+ * 						   2. write: data byte from master, returns TRUE to ACK
+ * 						   3. read: returns data byte to master, ack is TRUE if master ACKs it
+ * 						   4. stop: STOP condition*/
+typedef struct{
+	uint8 (*address)(uint8 sla);
+	uint8 (*write)(uint8 data);
+	uint8 (*read)(uint8 ack);
+	void (*stop)(void);
+}HAL_TwiDeviceType;
+
+/*[Structure Name]		 : HAL_HostEnvType
+ *[Structure Description]: This structure contains the callbacks that connect the modelled
+ * 						   peripherals with the world outside the ECU:
+ * 						   1. uartTx: a frame starts on TXD now, its stop bit ends at end
+ * 						   2. gpioRead: level of port pins, given its direction and output registers
+ * 						   3. gpioWrite: port direction/output registers have changed
+ * 						   4. sync: virtual time reached the horizon set by the environment
+ * 						   5. idle: firmware waits and no event is pending before the horizon
+ * 						   6. spiTransfer: SPI master starts a transfer now which ends at end,
+ * 						      returns the byte shifted in from the slave
+ * 						   7. adcRead: ADC samples an input channel at a given time, returns
+ * 						      the 10-bit result
+ * 						   8. pwmWrite: duty of OC0/OC2 has changed in a PWM mode, 0..255 the
+ * 						      part of the period it's high (255 while the pin is a plain output)
+ * 						   Any of them can be NULL_PTR*/
+typedef struct{
+	void (*uartTx)(uint16 data, uint64 end);
+	uint8 (*gpioRead)(uint8 port, uint8 ddr, uint8 out);
+	void (*gpioWrite)(uint8 port, uint8 ddr, uint8 out);
+	void (*sync)(void);
+	void (*idle)(void);
+	uint8 (*spiTransfer)(uint8 data, uint64 end);
+	uint16 (*adcRead)(uint8 channel, uint64 time);
+	void (*pwmWrite)(uint8 timer, uint8 duty);
+}HAL_HostEnvType;
+
+/******************************************************************
+ * 				   			 Macros					      		  *
+ ******************************************************************/
+/*Time stamp of an event that will never happen*/
+#define HAL_HOST_NEVER			(~(uint64)0)
+
+/*Register access through the model*/
+#define HAL_REG(ID)				(*HAL_hostAccess(ID))
+
+#define PINA	HAL_REG(HAL_PINA)
+#define PORTA	HAL_REG(HAL_PORTA)
+#define DDRA	HAL_REG(HAL_DDRA)
+#define PINB	HAL_REG(HAL_PINB)
+#define PORTB	HAL_REG(HAL_PORTB)
+#define DDRB	HAL_REG(HAL_DDRB)
+#define PINC	HAL_REG(HAL_PINC)
+#define PORTC	HAL_REG(HAL_PORTC)
+#define DDRC	HAL_REG(HAL_DDRC)
+#define PIND	HAL_REG(HAL_PIND)
+#define PORTD	HAL_REG(HAL_PORTD)
+#define DDRD	HAL_REG(HAL_DDRD)
+#define UDR		HAL_REG(HAL_UDR)
+#define UCSRA	HAL_REG(HAL_UCSRA)
+#define UCSRB	HAL_REG(HAL_UCSRB)
+#define UCSRC	HAL_REG(HAL_UCSRC)
+#define UBRRL	HAL_REG(HAL_UBRRL)
+#define UBRRH	HAL_REG(HAL_UBRRH)
+#define TWBR	HAL_REG(HAL_TWBR)
+#define TWSR	HAL_REG(HAL_TWSR)
+#define TWAR	HAL_REG(HAL_TWAR)
+#define TWDR	HAL_REG(HAL_TWDR)
+#define TWCR	HAL_REG(HAL_TWCR)
+#define TCCR1A	HAL_REG(HAL_TCCR1A)
+#define TCCR1B	HAL_REG(HAL_TCCR1B)
+#define TCNT1	HAL_REG(HAL_TCNT1)
+#define OCR1A	HAL_REG(HAL_OCR1A)
+#define OCR1B	HAL_REG(HAL_OCR1B)
+#define ICR1	HAL_REG(HAL_ICR1)
+#define TCCR0	HAL_REG(HAL_TCCR0)
+#define TCNT0	HAL_REG(HAL_TCNT0)
+#define OCR0	HAL_REG(HAL_OCR0)
+#define TCCR2	HAL_REG(HAL_TCCR2)
+#define TCNT2	HAL_REG(HAL_TCNT2)
+#define OCR2	HAL_REG(HAL_OCR2)
+#define ASSR	HAL_REG(HAL_ASSR)
+#define TIMSK	HAL_REG(HAL_TIMSK)
+#define TIFR	HAL_REG(HAL_TIFR)
+#define GICR	HAL_REG(HAL_GICR)
+#define GIFR	HAL_REG(HAL_GIFR)
+#define MCUCR	HAL_REG(HAL_MCUCR)
+#define MCUCSR	HAL_REG(HAL_MCUCSR)
+#define SFIOR	HAL_REG(HAL_SFIOR)
+#define ADMUX	HAL_REG(HAL_ADMUX)
+#define ADCSRA	HAL_REG(HAL_ADCSRA)
+#define ADC		HAL_REG(HAL_ADC)
+#define SPCR	HAL_REG(HAL_SPCR)
+#define SPSR	HAL_REG(HAL_SPSR)
+#define SPDR	HAL_REG(HAL_SPDR)
+#define SREG	HAL_REG(HAL_SREG)
+
+/*Port pins*/
+#define PA0 0
+#define PA1 1
+#define PA2 2
+#define PA3 3
+#define PA4 4
+#define PA5 5
+#define PA6 6
+#define PA7 7
+#define PB0 0
+#define PB1 1
+#define PB2 2
+#define PB3 3
+#define PB4 4
+#define PB5 5
+#define PB6 6
+#define PB7 7
+#define PC0 0
+#define PC1 1
+#define PC2 2
+#define PC3 3
+#define PC4 4
+#define PC5 5
+#define PC6 6
+#define PC7 7
+#define PD0 0
+#define PD1 1
+#define PD2 2
+#define PD3 3
+#define PD4 4
+#define PD5 5
+#define PD6 6
+#define PD7 7
+
+/*UCSRA bits*/
+#define MPCM	0
+#define U2X		1
+#define PE		2
+#define DOR		3
+#define FE		4
+#define UDRE	5
+#define TXC		6
+#define RXC		7
+/*UCSRB bits*/
+#define TXB8	0
+#define RXB8	1
+#define UCSZ2	2
+#define TXEN	3
+#define RXEN	4
+#define UDRIE	5
+#define TXCIE	6
+#define RXCIE	7
+/*UCSRC bits*/
+#define UCPOL	0
+#define UCSZ0	1
+#define UCSZ1	2
+#define USBS	3
+#define UPM0	4
+#define UPM1	5
+#define UMSEL	6
+#define URSEL	7
+/*TWCR bits*/
+#define TWIE	0
+#define TWEN	2
+#define TWWC	3
+#define TWSTO	4
+#define TWSTA	5
+#define TWEA	6
+#define TWINT	7
+/*TWSR bits*/
+#define TWPS0	0
+#define TWPS1	1
+/*TWAR bits*/
+#define TWGCE	0
+/*TCCR1A bits*/
+#define WGM10	0
+#define WGM11	1
+#define FOC1B	2
+#define FOC1A	3
+#define COM1B0	4
+#define COM1B1	5
+#define COM1A0	6
+#define COM1A1	7
+/*TCCR1B bits*/
+#define CS10	0
+#define CS11	1
+#define CS12	2
+#define WGM12	3
+#define WGM13	4
+#define ICES1	6
+#define ICNC1	7
+/*TCCR0 bits*/
+#define CS00	0
+#define CS01	1
+#define CS02	2
+#define WGM01	3
+#define COM00	4
+#define COM01	5
+#define WGM00	6
+#define FOC0	7
+/*TCCR2 bits*/
+#define CS20	0
+#define CS21	1
+#define CS22	2
+#define WGM21	3
+#define COM20	4
+#define COM21	5
+#define WGM20	6
+#define FOC2	7
+/*TIMSK bits*/
+#define TOIE0	0
+#define OCIE0	1
+#define TOIE1	2
+#define OCIE1B	3
+#define OCIE1A	4
+#define TICIE1	5
+#define TOIE2	6
+#define OCIE2	7
+/*TIFR bits*/
+#define TOV0	0
+#define OCF0	1
+#define TOV1	2
+#define OCF1B	3
+#define OCF1A	4
+#define ICF1	5
+#define TOV2	6
+#define OCF2	7
+/*GICR bits*/
+#define IVCE	0
+#define IVSEL	1
+#define INT2	5
+#define INT0	6
+#define INT1	7
+/*GIFR bits*/
+#define INTF2	5
+#define INTF0	6
+#define INTF1	7
+/*MCUCR bits*/
+#define ISC00	0
+#define ISC01	1
+#define ISC10	2
+#define ISC11	3
+#define SM0		4
+#define SM1		5
+#define SE		6
+#define SM2		7
+/*MCUCSR bits*/
+#define ISC2	6
+/*ADMUX bits*/
+#define MUX0	0
+#define MUX1	1
+#define MUX2	2
+#define MUX3	3
+#define MUX4	4
+#define ADLAR	5
+#define REFS0	6
+#define REFS1	7
+/*ADCSRA bits*/
+#define ADPS0	0
+#define ADPS1	1
+#define ADPS2	2
+#define ADIE	3
+#define ADIF	4
+#define ADATE	5
+#define ADSC	6
+#define ADEN	7
+/*SFIOR bits*/
+#define ADTS0	5
+#define ADTS1	6
+#define ADTS2	7
+/*SPCR bits*/
+#define SPR0	0
+#define SPR1	1
+#define CPHA	2
+#define CPOL	3
+#define MSTR	4
+#define DORD	5
+#define SPE		6
+#define SPIE	7
+/*SPSR bits*/
+#define SPI2X	0
+#define WCOL	6
+#define SPIF	7
+/*SREG bits*/
+#define SREG_I	7
+
+/*Replacements of avr-libc macros*/
+#define ISR(VECTOR)				void VECTOR(void)
+#define sei()					HAL_hostSetInterrupts(TRUE)
+#define cli()					HAL_hostSetInterrupts(FALSE)
+#define _delay_ms(MS)			HAL_hostDelay((uint64)((MS)*((double)F_CPU/1000.0)))
+#define _delay_us(US)			HAL_hostDelay((uint64)((US)*((double)F_CPU/1000000.0)))
+/*Flash data is kept in a section of its own, as avr-gcc does, so the ramcheck of Makefile
+ *tells it from constants AVR copies to RAM*/
+#define PROGMEM					__attribute__((section(".progmem.data")))
+#define pgm_read_byte(ADDR)		(*(const uint8 *)(ADDR))
+#define pgm_read_word(ADDR)		(*(const uint16 *)(ADDR))
+#define pgm_read_dword(ADDR)	(*(const uint32 *)(ADDR))
+/*Sleep modes are selected by SM2:0 of MCUCR, all of them are modelled as idle mode*/
+#define SLEEP_MODE_IDLE			0
+#define SLEEP_MODE_PWR_DOWN		(1<<SM1)
+#define SLEEP_MODE_PWR_SAVE		((1<<SM1)|(1<<SM0))
+#define set_sleep_mode(MODE)	(MCUCR=(MCUCR&~((1<<SM2)|(1<<SM1)|(1<<SM0)))|(MODE))
+#define sleep_enable()			(MCUCR|=(1<<SE))
+#define sleep_disable()			(MCUCR&=~(1<<SE))
+#define sleep_cpu()				HAL_hostSleep()
+
+/******************************************************************
+ * 				  Public Functions Prototypes					  *
+ ******************************************************************/
+/*Description: This function returns the register slot of the given register after
+ *bringing the peripheral models up to date, it's what each register name expands to*/
+volatile uint32 * HAL_hostAccess(HAL_RegId id);
+
+/*Description: This function enables/disables global interrupts (I bit of SREG)*/
+void HAL_hostSetInterrupts(uint8 enable);
+
+/*Description: This function advances virtual time by a number of CPU cycles while
+ *peripherals keep running and interrupts are served*/
+void HAL_hostDelay(uint64 cycles);
+
+/*Description: This function is the sleep instruction: with SE set, virtual time moves on
+ *till an interrupt is served*/
+void HAL_hostSleep(void);
+
+/*Description: This function returns the virtual time in CPU cycles since reset*/
+uint64 HAL_hostNow(void);
+
+/*Description: This function connects the modelled peripherals to an environment,
+ *NULL_PTR restores the default stdio environment*/
+void HAL_hostSetEnvironment(const HAL_HostEnvType * env);
+
+/*Description: This function sets the time the ECU may run to before calling env sync*/
+void HAL_hostSetHorizon(uint64 time);
+
+/*Description: This function queues a frame to be received by the UART at a given time*/
+void HAL_hostUartReceive(uint16 data, uint64 time);
+
+/*Description: This function attaches a slave device to the TWI bus*/
+void HAL_hostTwiAttach(const HAL_TwiDeviceType * device);
+
+/*Description: This function makes the SPI slave take part in a transfer started by the
+ *master now and ending at time, it returns the byte shifted out by the slave*/
+uint8 HAL_hostSpiReceive(uint8 data, uint64 time);
+
+/*Description: This function drives an input pin to a level from a given time on (port 0
+ *for PORTA up to 3 for PORTD), replacing a change of the pin not applied yet*/
+void HAL_hostPinChange(uint8 port, uint8 pin, uint8 level, uint64 time);
+
+#endif /* HAL_HOST_H_ */
@@ -0,0 +1,79 @@
+/*******************************************************************************************
+ * [FILE NAME]:		hal_host_private.h
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This header file contains the shared state and functions between the
+ * 					core of the host HAL backend and its peripheral models, it's not
+ * 					included by firmware
+ *******************************************************************************************/
+#ifndef HAL_HOST_PRIVATE_H_
+#define HAL_HOST_PRIVATE_H_
+
+/******************************************************************
+ * 				Common Header Files Inclusion					  *
+ ******************************************************************/
+#include "micro_config.h"
+#include "common_macros.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+/*CPU cycles charged for each register access*/
+#define HAL_ACCESS_CYCLES		2u
+/*CPU cycles charged for each function called by firmware*/
+#define HAL_CALL_CYCLES			8u
+/*Number of successive reads of the same register with the same value after which
+ *firmware is taken as busy-waiting and time jumps to the next event*/
+#define HAL_SPIN_ACCESSES		16u
+/*Register slots remembered between synchronisations (firmware writes a slot right after
+ *the access handing it, so one is enough in practice)*/
+#define HAL_HANDED_SLOTS		4u
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+/*Value of each register as seen by the peripheral models*/
+extern uint32 g_halReg[HAL_REG_COUNT];
+/*Virtual time in CPU cycles*/
+extern uint64 g_halNow;
+/*Environment the peripherals are connected to*/
+extern const HAL_HostEnvType * g_halEnv;
+
+/******************************************************************
+ * 				  Private Functions Prototypes					  *
+ ******************************************************************/
+/*Core*/
+void HAL_hostPortUpdate(uint8 port);
+/*UART model*/
+void HAL_uartWrite(HAL_RegId id, uint32 value);
+void HAL_uartRead(HAL_RegId id);
+void HAL_uartReadDone(void);
+uint64 HAL_uartNextEvent(void);
+void HAL_uartProcess(void);
+
+/*TWI model*/
+void HAL_twiWrite(HAL_RegId id, uint32 value);
+uint64 HAL_twiNextEvent(void);
+void HAL_twiProcess(void);
+
+/*Timers model*/
+void HAL_timerWrite(HAL_RegId id, uint32 value);
+void HAL_timerRead(HAL_RegId id);
+uint64 HAL_timerNextEvent(void);
+void HAL_timerProcess(void);
+uint8 HAL_timerPortOutput(uint8 port, uint8 out);
+/*SPI model*/
+void HAL_spiWrite(HAL_RegId id, uint32 value);
+void HAL_spiRead(HAL_RegId id);
+uint64 HAL_spiNextEvent(void);
+void HAL_spiProcess(void);
+/*ADC model*/
+void HAL_adcWrite(HAL_RegId id, uint32 value);
+uint64 HAL_adcNextEvent(void);
+void HAL_adcProcess(void);
+/*External inputs and interrupts model*/
+uint8 HAL_extintApply(uint8 port, uint8 value);
+uint64 HAL_extintNextEvent(void);
+void HAL_extintProcess(void);
+
+#endif /* HAL_HOST_PRIVATE_H_ */
@@ -0,0 +1,166 @@
+/*******************************************************************************************
+ * [FILE NAME]:		hal_spi_host.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains the model of SPI module of ATMEGA-16 for the host
+ * 					backend of the HAL. A master transfer takes 8 SCK periods from SPR1:0 and
+ * 					SPI2X, the environment exchanges its byte with the slave's when it
+ * 					starts. A slave receives transfers handed by HAL_hostSpiReceive and
+ * 					shifts out the byte last written to SPDR (or the byte it received last,
+ * 					as the shift register is circular). SS pin is not modelled, a slave
+ * 					takes part in each transfer while SPI is enabled
+ *******************************************************************************************/
+
+#include "hal_host_private.h"
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[Structure Name]		 : HAL_SpiType
+ *[Structure Description]: This structure contains the state of SPI module*/
+typedef struct{
+	/*Master: transfer in progress, its end and the byte the slave sent*/
+	uint8 busy;
+	uint64 end;
+	uint8 received;
+	/*Slave: byte in the shift register and a transfer to complete at arrival*/
+	uint8 shift;
+	uint8 pending;
+	uint8 pendingData;
+	uint64 arrival;
+	/*SPSR was read with SPIF set, next SPDR access clears SPIF and WCOL*/
+	uint8 flagRead;
+}HAL_SpiType;
+
+/******************************************************************
+ * 				  Private Functions Prototypes					  *
+ ******************************************************************/
+static uint32 HAL_spiDivider(void);
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+static HAL_SpiType g_spi={FALSE,0,0,0xFF,FALSE,0,0,FALSE};
+
+/*SCK divider selected by SPR1:0*/
+static const uint32 g_spiDividers[4]={4,16,64,128};
+
+/******************************************************************
+ * 				  Public Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function makes the SPI slave take part in a transfer started by the
+ *master now and ending at a given time: it returns the byte the slave shifts out, the byte
+ *from master reaches SPDR at the end. A disabled or master SPI leaves MISO high*/
+uint8 HAL_hostSpiReceive(uint8 data, uint64 time)
+{
+	if(IS_BIT_CLEAR(g_halReg[HAL_SPCR],SPE) || IS_BIT_SET(g_halReg[HAL_SPCR],MSTR))
+	{
+		return 0xFF;
+	}
+	g_spi.pending=TRUE;
+	g_spi.pendingData=data;
+	g_spi.arrival=time;
+	return g_spi.shift;
+}
+
+/******************************************************************
+ * 				  Private Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function applies a firmware write on a SPI register*/
+void HAL_spiWrite(HAL_RegId id, uint32 value)
+{
+	switch(id)
+	{
+		case HAL_SPDR:
+			if(IS_BIT_CLEAR(g_halReg[HAL_SPCR],SPE))
+			{
+				break;
+			}
+			if(g_spi.busy || (g_spi.pending && (g_spi.arrival > g_halNow) && IS_BIT_CLEAR(g_halReg[HAL_SPCR],MSTR)))
+			{
+				/*Write during a transfer is lost*/
+				SET_BIT(g_halReg[HAL_SPSR],WCOL);
+				break;
+			}
+			g_spi.shift=(uint8)value;
+			if(IS_BIT_SET(g_halReg[HAL_SPCR],MSTR))
+			{
+				g_spi.busy=TRUE;
+				g_spi.end=g_halNow+8u*HAL_spiDivider();
+				g_spi.received=0xFF;
+				if((g_halEnv != NULL_PTR) && (g_halEnv->spiTransfer != NULL_PTR))
+				{
+					g_spi.received=g_halEnv->spiTransfer(g_spi.shift,g_spi.end);
+				}
+			}
+			break;
+		case HAL_SPSR:
+			/*Only SPI2X is writable*/
+			g_halReg[HAL_SPSR]=(g_halReg[HAL_SPSR] & ~(1<<SPI2X)) | (value & (1<<SPI2X));
+			break;
+		default:
+			g_halReg[id]=value;
+			break;
+	}
+}
+
+/*Description: This function is called when firmware accesses SPSR or SPDR, reading SPSR
+ *with SPIF set then accessing SPDR clears SPIF and WCOL. SPDR reads the receive buffer*/
+void HAL_spiRead(HAL_RegId id)
+{
+	if(id == HAL_SPSR)
+	{
+		g_spi.flagRead=IS_BIT_SET(g_halReg[HAL_SPSR],SPIF) ? TRUE : FALSE;
+	}
+	else if(g_spi.flagRead)
+	{
+		g_spi.flagRead=FALSE;
+		g_halReg[HAL_SPSR]&=~((1<<SPIF)|(1<<WCOL));
+	}
+}
+
+/*Description: This function returns the time of the next SPI event*/
+uint64 HAL_spiNextEvent(void)
+{
+	uint64 next=HAL_HOST_NEVER;
+	if(g_spi.busy)
+	{
+		next=g_spi.end;
+	}
+	if(g_spi.pending && (g_spi.arrival < next))
+	{
+		next=g_spi.arrival;
+	}
+	return next;
+}
+
+/*Description: This function completes the transfers due at the current time, the
+ *received byte goes to SPDR and SPIF is set*/
+void HAL_spiProcess(void)
+{
+	if(g_spi.busy && (g_spi.end <= g_halNow))
+	{
+		g_spi.busy=FALSE;
+		g_spi.shift=g_spi.received;
+		g_halReg[HAL_SPDR]=g_spi.received;
+		SET_BIT(g_halReg[HAL_SPSR],SPIF);
+	}
+	if(g_spi.pending && (g_spi.arrival <= g_halNow))
+	{
+		g_spi.pending=FALSE;
+		g_spi.shift=g_spi.pendingData;
+		g_halReg[HAL_SPDR]=g_spi.pendingData;
+		SET_BIT(g_halReg[HAL_SPSR],SPIF);
+	}
+}
+
+/*Description: This function returns the SCK divider of master from SPR1:0 and SPI2X*/
+static uint32 HAL_spiDivider(void)
+{
+	uint32 divider=g_spiDividers[g_halReg[HAL_SPCR] & 0x03];
+	if(IS_BIT_SET(g_halReg[HAL_SPSR],SPI2X))
+	{
+		divider/=2u;
+	}
+	return divider;
+}
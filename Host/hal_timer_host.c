@@ -0,0 +1,397 @@
+/*******************************************************************************************
+ * [FILE NAME]:		hal_timer_host.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains the model of TIMER0, TIMER1 and TIMER2 modules of
+ * 					ATMEGA-16 for the host backend of the HAL. Counters are not stepped
+ * 					each cycle, their value is worked out from virtual time when read and
+ * 					only compare matches and TOP/MAX wraps are scheduled as events.
+ * 					PWM modes are modelled as single-slope counting to their TOP, which
+ * 					keeps the interrupt rate of fast PWM modes and the flags timing of
+ * 					normal and CTC modes exact. Compare outputs OC0 (PB3) and OC2 (PD7) are
+ * 					modelled in non-PWM modes, they override PORTx bit when COMn1:0 is set.
+ * 					In PWM modes an output isn't toggled each period but holds its mean: it's
+ * 					high while its duty isn't 0 (pulse widths are left to the firmware).
+ * 					OC1B (PD4) is modelled as a tone: toggled on compare match in CTC mode
+ * 					it's high while TIMER1 runs, OC1A isn't modelled
+ *******************************************************************************************/
+
+#include "hal_host_private.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+#define HAL_TIMERS				3u
+#define HAL_TIMER_COMPARES		2u
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[Structure Name]		 : HAL_TimerType
+ *[Structure Description]: This structure contains the state of a timer: its counter
+ * 						   value count0 at time base, and the last counter value whose
+ * 						   compare matches were already flagged*/
+typedef struct{
+	uint16 count0;
+	uint64 base;
+	sint32 done;
+	uint32 prescale;
+}HAL_TimerType;
+
+/******************************************************************
+ * 				  Private Functions Prototypes					  *
+ ******************************************************************/
+static uint32 HAL_timerPrescale(uint8 timer);
+static uint8 HAL_timer1Mode(void);
+static uint32 HAL_timerTop(uint8 timer);
+static uint32 HAL_timerMax(uint8 timer);
+static uint8 HAL_timerIsCtc(uint8 timer);
+static uint32 HAL_timerCompare(uint8 timer, uint8 channel);
+static uint32 HAL_timerCount(uint8 timer);
+static void HAL_timerRebase(uint8 timer);
+static void HAL_timerCompareOutput(uint8 timer);
+static void HAL_timerPwmOutput(uint8 timer);
+static void HAL_timerToneOutput(void);
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+static HAL_TimerType g_timers[HAL_TIMERS];
+
+/*Registers of each timer*/
+static const HAL_RegId g_tcnt[HAL_TIMERS]={HAL_TCNT0,HAL_TCNT1,HAL_TCNT2};
+/*Flag of each compare channel and of overflow, in TIFR*/
+static const uint8 g_compareFlag[HAL_TIMERS][HAL_TIMER_COMPARES]={{OCF0,OCF0},{OCF1A,OCF1B},{OCF2,OCF2}};
+static const uint8 g_overflowFlag[HAL_TIMERS]={TOV0,TOV1,TOV2};
+/*Timer control register holding the compare output mode (COM1B1:0 of TCCR1A are at the
+ *place of COMn1:0), and the port and pin driven by the compare output*/
+static const HAL_RegId g_tccr[HAL_TIMERS]={HAL_TCCR0,HAL_TCCR1A,HAL_TCCR2};
+static const uint8 g_ocPort[HAL_TIMERS]={1,3,3};
+static const uint8 g_ocPin[HAL_TIMERS]={PB3,PD4,PD7};
+
+/*Level of each compare output*/
+static uint8 g_ocLevel[HAL_TIMERS];
+
+/*Prescalers selected by CSn2:0 bits, 0 is stopped or external clock (not modelled)*/
+static const uint32 g_prescaler01[8]={0,1,8,64,256,1024,0,0};
+static const uint32 g_prescaler2[8]={0,1,8,32,64,128,256,1024};
+
+/******************************************************************
+ * 				  Private Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function replaces the bits of a port output driven by compare outputs*/
+uint8 HAL_timerPortOutput(uint8 port, uint8 out)
+{
+	uint8 timer;
+	for(timer=0;timer<HAL_TIMERS;timer++)
+	{
+		if((g_ocPort[timer] == port) && ((g_halReg[g_tccr[timer]] & ((1<<COM01)|(1<<COM00))) != 0))
+		{
+			out=(out & ~(1<<g_ocPin[timer])) | (g_ocLevel[timer]<<g_ocPin[timer]);
+		}
+	}
+	return out;
+}
+
+/*Description: This function applies a firmware write on a timer register*/
+void HAL_timerWrite(HAL_RegId id, uint32 value)
+{
+	uint8 timer;
+	switch(id)
+	{
+		case HAL_TCCR0: case HAL_TCNT0: case HAL_OCR0: timer=0; break;
+		case HAL_TCCR2: case HAL_TCNT2: case HAL_OCR2: timer=2; break;
+		default: timer=1; break;
+	}
+	/*Counter continues from its current value under the new configuration*/
+	HAL_timerRebase(timer);
+	switch(id)
+	{
+		case HAL_TCCR0: case HAL_TCCR2:
+			/*FOCn is a strobe and always reads zero, it forces a compare match on the output*/
+			g_halReg[id]=value & ~(1<<FOC0);
+			if(IS_BIT_SET(value,FOC0))
+			{
+				HAL_timerCompareOutput(timer);
+			}
+			HAL_timerPwmOutput(timer);
+			/*Setting or clearing COMn1:0 connects or disconnects the output from the pin*/
+			HAL_hostPortUpdate(g_ocPort[timer]);
+			break;
+		case HAL_TCCR1A:
+			g_halReg[id]=value & ~((1<<FOC1A)|(1<<FOC1B));
+			break;
+		case HAL_OCR0: case HAL_OCR2:
+			/*A new duty changes the mean of a PWM output*/
+			g_halReg[id]=value;
+			HAL_timerPwmOutput(timer);
+			HAL_hostPortUpdate(g_ocPort[timer]);
+			break;
+		case HAL_TCNT0: case HAL_TCNT1: case HAL_TCNT2:
+			/*A write blocks compare match on the written value*/
+			g_timers[timer].count0=(uint16)value;
+			g_timers[timer].done=(sint32)value;
+			break;
+		default:
+			g_halReg[id]=value;
+			break;
+	}
+	g_timers[timer].prescale=HAL_timerPrescale(timer);
+	if((id == HAL_TCCR1A) || (id == HAL_TCCR1B))
+	{
+		HAL_timerToneOutput();
+	}
+}
+
+/*Description: This function puts the current counter value in TCNTn*/
+void HAL_timerRead(HAL_RegId id)
+{
+	uint8 timer=(id == HAL_TCNT0) ? 0 : ((id == HAL_TCNT1) ? 1 : 2);
+	g_halReg[id]=HAL_timerCount(timer);
+}
+
+/*Description: This function returns the time of the next timers event*/
+uint64 HAL_timerNextEvent(void)
+{
+	uint64 next=HAL_HOST_NEVER;
+	uint64 event;
+	uint32 limit;
+	uint32 compare;
+	uint8 timer;
+	uint8 channel;
+	HAL_TimerType * t;
+	for(timer=0;timer<HAL_TIMERS;timer++)
+	{
+		t=&g_timers[timer];
+		if(t->prescale == 0)
+		{
+			continue;
+		}
+		limit=(t->count0 > HAL_timerTop(timer)) ? HAL_timerMax(timer) : HAL_timerTop(timer);
+		for(channel=0;channel<HAL_TIMER_COMPARES;channel++)
+		{
+			compare=HAL_timerCompare(timer,channel);
+			if(((sint32)compare > t->done) && (compare <= limit))
+			{
+				event=t->base+(uint64)(compare-t->count0)*t->prescale;
+				if(event < next)
+				{
+					next=event;
+				}
+			}
+		}
+		event=t->base+(uint64)(limit+1-t->count0)*t->prescale;
+		if(event < next)
+		{
+			next=event;
+		}
+	}
+	return next;
+}
+
+/*Description: This function raises the timers flags due at the current time*/
+void HAL_timerProcess(void)
+{
+	uint32 limit;
+	uint32 count;
+	uint32 compare;
+	uint8 timer;
+	uint8 channel;
+	HAL_TimerType * t;
+	for(timer=0;timer<HAL_TIMERS;timer++)
+	{
+		t=&g_timers[timer];
+		if(t->prescale == 0)
+		{
+			continue;
+		}
+		while(1)
+		{
+			limit=(t->count0 > HAL_timerTop(timer)) ? HAL_timerMax(timer) : HAL_timerTop(timer);
+			count=t->count0+(uint32)((g_halNow-t->base)/t->prescale);
+			for(channel=0;channel<HAL_TIMER_COMPARES;channel++)
+			{
+				compare=HAL_timerCompare(timer,channel);
+				if(((sint32)compare > t->done) && (compare <= count) && (compare <= limit))
+				{
+					SET_BIT(g_halReg[HAL_TIFR],g_compareFlag[timer][channel]);
+					/*TIMER0 and TIMER2 have their single compare unit as both channels*/
+					if(channel == 0)
+					{
+						HAL_timerCompareOutput(timer);
+					}
+				}
+			}
+			if(count <= limit)
+			{
+				t->done=(sint32)count;
+				break;
+			}
+			/*Counter wraps to BOTTOM, TOVn is set in CTC mode only when counter wraps at MAX*/
+			if(!HAL_timerIsCtc(timer) || (limit == HAL_timerMax(timer)))
+			{
+				SET_BIT(g_halReg[HAL_TIFR],g_overflowFlag[timer]);
+			}
+			t->base+=(uint64)(limit+1-t->count0)*t->prescale;
+			t->count0=0;
+			t->done=-1;
+		}
+	}
+}
+
+/*Description: This function returns the prescaler of a timer from its clock select bits*/
+static uint32 HAL_timerPrescale(uint8 timer)
+{
+	switch(timer)
+	{
+		case 0: return g_prescaler01[g_halReg[HAL_TCCR0]&0x07];
+		case 1: return g_prescaler01[g_halReg[HAL_TCCR1B]&0x07];
+		default: return g_prescaler2[g_halReg[HAL_TCCR2]&0x07];
+	}
+}
+
+/*Description: This function returns the waveform generation mode of TIMER1*/
+static uint8 HAL_timer1Mode(void)
+{
+	return (uint8)((g_halReg[HAL_TCCR1A]&0x03) | ((g_halReg[HAL_TCCR1B]>>WGM12)&0x03)<<2);
+}
+
+/*Description: This function returns the TOP value of a timer in its current mode*/
+static uint32 HAL_timerTop(uint8 timer)
+{
+	uint32 tccr;
+	if(timer == 1)
+	{
+		switch(HAL_timer1Mode())
+		{
+			case 1: case 5: return 0xFF;
+			case 2: case 6: return 0x1FF;
+			case 3: case 7: return 0x3FF;
+			case 4: case 9: case 11: case 15: return g_halReg[HAL_OCR1A];
+			case 8: case 10: case 12: case 14: return g_halReg[HAL_ICR1];
+			default: return 0xFFFF;
+		}
+	}
+	tccr=(timer == 0) ? g_halReg[HAL_TCCR0] : g_halReg[HAL_TCCR2];
+	if(IS_BIT_SET(tccr,WGM01) && IS_BIT_CLEAR(tccr,WGM00))
+	{
+		return (timer == 0) ? g_halReg[HAL_OCR0] : g_halReg[HAL_OCR2];
+	}
+	return 0xFF;
+}
+
+/*Description: This function returns the MAX value of a timer*/
+static uint32 HAL_timerMax(uint8 timer)
+{
+	return (timer == 1) ? 0xFFFF : 0xFF;
+}
+
+/*Description: This function checks if a timer is in Clear Timer on Compare mode*/
+static uint8 HAL_timerIsCtc(uint8 timer)
+{
+	uint32 tccr;
+	if(timer == 1)
+	{
+		return (HAL_timer1Mode() == 4) || (HAL_timer1Mode() == 12);
+	}
+	tccr=(timer == 0) ? g_halReg[HAL_TCCR0] : g_halReg[HAL_TCCR2];
+	return IS_BIT_SET(tccr,WGM01) && IS_BIT_CLEAR(tccr,WGM00);
+}
+
+/*Description: This function returns a compare value of a timer, TIMER0 and TIMER2
+ *have a single compare unit which is returned for both channels*/
+static uint32 HAL_timerCompare(uint8 timer, uint8 channel)
+{
+	switch(timer)
+	{
+		case 0: return g_halReg[HAL_OCR0];
+		case 1: return (channel == 0) ? g_halReg[HAL_OCR1A] : g_halReg[HAL_OCR1B];
+		default: return g_halReg[HAL_OCR2];
+	}
+}
+
+/*Description: This function returns the counter value of a timer at the current time*/
+static uint32 HAL_timerCount(uint8 timer)
+{
+	HAL_TimerType * t=&g_timers[timer];
+	if(t->prescale == 0)
+	{
+		return t->count0;
+	}
+	return t->count0+(uint32)((g_halNow-t->base)/t->prescale);
+}
+
+/*Description: This function moves the reference of a timer to its last count before the
+ *current time, the prescaler runs freely so a write doesn't shift the counting phase*/
+static void HAL_timerRebase(uint8 timer)
+{
+	HAL_TimerType * t=&g_timers[timer];
+	t->count0=(uint16)HAL_timerCount(timer);
+	t->base=(t->prescale == 0) ? g_halNow : (g_halNow-((g_halNow-t->base)%t->prescale));
+	t->done=(sint32)t->count0;
+	g_halReg[g_tcnt[timer]]=t->count0;
+}
+
+/*Description: This function applies the compare output mode of TIMER0 or TIMER2 on a
+ *compare match: toggle, clear or set OCn. PWM modes are not modelled on the pin, nor
+ *TIMER1 matches (its tone is modelled by its mean)*/
+static void HAL_timerCompareOutput(uint8 timer)
+{
+	uint8 tccr;
+	if(timer == 1)
+	{
+		return;
+	}
+	tccr=(uint8)g_halReg[g_tccr[timer]];
+	if(IS_BIT_SET(tccr,WGM00))
+	{
+		return;
+	}
+	switch((tccr>>COM00) & 0x03)
+	{
+		case 1: g_ocLevel[timer]^=1; break;
+		case 2: g_ocLevel[timer]=0; break;
+		case 3: g_ocLevel[timer]=1; break;
+		default: return;
+	}
+	HAL_hostPortUpdate(g_ocPort[timer]);
+}
+
+/*Description: This function applies the compare output mode of TIMER0 or TIMER2 in a PWM
+ *mode from the duty: non-inverting output is high unless OCRn is BOTTOM, inverting output
+ *unless OCRn is MAX. The duty itself is passed to the environment*/
+static void HAL_timerPwmOutput(uint8 timer)
+{
+	uint8 tccr=(uint8)g_halReg[g_tccr[timer]];
+	uint32 compare=HAL_timerCompare(timer,0);
+	uint8 duty=0xFF;
+	if(IS_BIT_CLEAR(tccr,WGM00))
+	{
+		return;
+	}
+	switch((tccr>>COM00) & 0x03)
+	{
+		case 2: g_ocLevel[timer]=(compare != 0) ? 1 : 0; duty=(uint8)compare; break;
+		case 3: g_ocLevel[timer]=(compare != 0xFF) ? 1 : 0; duty=(uint8)(0xFF-compare); break;
+		default: break;
+	}
+	if((g_halEnv != NULL_PTR) && (g_halEnv->pwmWrite != NULL_PTR))
+	{
+		g_halEnv->pwmWrite(timer,duty);
+	}
+}
+
+/*Description: This function applies the compare output mode of OC1B as a tone: toggled on
+ *compare match in CTC mode it's high while TIMER1 runs (not toggled each period), set or
+ *cleared it's taken as the level it's left at once the match passed*/
+static void HAL_timerToneOutput(void)
+{
+	switch((g_halReg[HAL_TCCR1A]>>COM1B0) & 0x03)
+	{
+		case 1: g_ocLevel[1]=(HAL_timerIsCtc(1) && (g_timers[1].prescale != 0)) ? 1 : 0; break;
+		case 2: g_ocLevel[1]=0; break;
+		case 3: g_ocLevel[1]=1; break;
+		default: break;
+	}
+	HAL_hostPortUpdate(g_ocPort[1]);
+}
@@ -0,0 +1,224 @@
+/*******************************************************************************************
+ * [FILE NAME]:		hal_twi_host.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains the model of TWI module of ATMEGA-16 in master mode
+ * 					for the host backend of the HAL. Each bus operation takes its time on
+ * 					SCL then sets TWINT with the status code the chip would give, slave
+ * 					devices are attached by HAL_hostTwiAttach
+ *******************************************************************************************/
+
+#include <stdio.h>
+#include "hal_host_private.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+/*Number of devices that can be attached on the bus*/
+#define HAL_TWI_DEVICES			4u
+
+/*Status codes of master transmitter/receiver modes*/
+#define TWI_STATUS_START		0x08
+#define TWI_STATUS_REP_START	0x10
+#define TWI_STATUS_SLA_W_ACK	0x18
+#define TWI_STATUS_SLA_W_NACK	0x20
+#define TWI_STATUS_DATA_W_ACK	0x28
+#define TWI_STATUS_DATA_W_NACK	0x30
+#define TWI_STATUS_SLA_R_ACK	0x40
+#define TWI_STATUS_SLA_R_NACK	0x48
+#define TWI_STATUS_DATA_R_ACK	0x50
+#define TWI_STATUS_DATA_R_NACK	0x58
+#define TWI_STATUS_IDLE			0xF8
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[ENUM Name]		: HAL_TwiOperation
+ *[ENUM Description]: This enum contains the bus operation in progress*/
+typedef enum{
+	TWI_OP_NONE,TWI_OP_START,TWI_OP_STOP,TWI_OP_BYTE
+}HAL_TwiOperation;
+
+/******************************************************************
+ * 				  Private Functions Prototypes					  *
+ ******************************************************************/
+static uint64 HAL_twiSclPeriod(void);
+static void HAL_twiComplete(void);
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+static const HAL_TwiDeviceType * g_devices[HAL_TWI_DEVICES];
+static uint8 g_deviceCount=0;
+
+/*Device addressed by the last SLA+R/W, NULL_PTR if none answered*/
+static const HAL_TwiDeviceType * g_selected=NULL_PTR;
+/*Master owns the bus (START sent and no STOP yet)*/
+static uint8 g_busOwned=FALSE;
+
+static HAL_TwiOperation g_operation=TWI_OP_NONE;
+static uint64 g_operationEnd;
+
+/******************************************************************
+ * 				  Public Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function attaches a slave device to the TWI bus*/
+void HAL_hostTwiAttach(const HAL_TwiDeviceType * device)
+{
+	if(g_deviceCount == HAL_TWI_DEVICES)
+	{
+		fprintf(stderr,"hal_host: no room for another TWI device\n");
+		return;
+	}
+	g_devices[g_deviceCount++]=device;
+}
+
+/******************************************************************
+ * 				  Private Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function applies a firmware write on a TWI register*/
+void HAL_twiWrite(HAL_RegId id, uint32 value)
+{
+	uint64 start;
+	switch(id)
+	{
+		case HAL_TWSR:
+			/*Only prescaler bits are writable*/
+			g_halReg[HAL_TWSR]=(g_halReg[HAL_TWSR]&0xF8) | (value&0x03);
+			break;
+		case HAL_TWCR:
+			/*TWINT is cleared by writing one to it, which starts the next operation*/
+			g_halReg[HAL_TWCR]=(g_halReg[HAL_TWCR]&(1<<TWINT)) | (value&~(1<<TWINT));
+			if(IS_BIT_CLEAR(value,TWINT) || IS_BIT_CLEAR(value,TWEN))
+			{
+				break;
+			}
+			CLEAR_BIT(g_halReg[HAL_TWCR],TWINT);
+			if(IS_BIT_SET(value,TWSTA))
+			{
+				/*START requested while STOP is still on the bus is sent after it*/
+				start=g_halNow;
+				if((g_operation == TWI_OP_STOP) && (g_operationEnd > start))
+				{
+					start=g_operationEnd;
+				}
+				if(g_operation == TWI_OP_STOP)
+				{
+					HAL_twiComplete();
+				}
+				g_operation=TWI_OP_START;
+				g_operationEnd=start+HAL_twiSclPeriod();
+			}
+			else if(IS_BIT_SET(value,TWSTO))
+			{
+				g_operation=TWI_OP_STOP;
+				g_operationEnd=g_halNow+HAL_twiSclPeriod();
+			}
+			else
+			{
+				/*8 data bits and ACK bit*/
+				g_operation=TWI_OP_BYTE;
+				g_operationEnd=g_halNow+(9u*HAL_twiSclPeriod());
+			}
+			break;
+		default:
+			g_halReg[id]=value;
+			break;
+	}
+}
+
+/*Description: This function returns the time the bus operation in progress ends*/
+uint64 HAL_twiNextEvent(void)
+{
+	return (g_operation == TWI_OP_NONE) ? HAL_HOST_NEVER : g_operationEnd;
+}
+
+/*Description: This function completes the bus operation if it's due*/
+void HAL_twiProcess(void)
+{
+	if((g_operation != TWI_OP_NONE) && (g_operationEnd <= g_halNow))
+	{
+		HAL_twiComplete();
+	}
+}
+
+/*Description: This function returns SCL period in CPU cycles*/
+static uint64 HAL_twiSclPeriod(void)
+{
+	uint8 prescaler=g_halReg[HAL_TWSR]&0x03;
+	return 16u+(2u*(uint64)g_halReg[HAL_TWBR]*((uint64)1<<(2*prescaler)));
+}
+
+/*Description: This function ends the bus operation and sets the status the chip gives*/
+static void HAL_twiComplete(void)
+{
+	uint8 status=g_halReg[HAL_TWSR]&0xF8;
+	uint8 data=g_halReg[HAL_TWDR];
+	uint8 i;
+	HAL_TwiOperation operation=g_operation;
+	g_operation=TWI_OP_NONE;
+	switch(operation)
+	{
+		case TWI_OP_START:
+			status=g_busOwned ? TWI_STATUS_REP_START : TWI_STATUS_START;
+			g_busOwned=TRUE;
+			CLEAR_BIT(g_halReg[HAL_TWCR],TWSTA);
+			break;
+		case TWI_OP_STOP:
+			if(g_selected != NULL_PTR && g_selected->stop != NULL_PTR)
+			{
+				g_selected->stop();
+			}
+			g_selected=NULL_PTR;
+			g_busOwned=FALSE;
+			CLEAR_BIT(g_halReg[HAL_TWCR],TWSTO);
+			/*TWINT is not set after STOP*/
+			g_halReg[HAL_TWSR]=(g_halReg[HAL_TWSR]&0x03) | TWI_STATUS_IDLE;
+			return;
+		default:
+			if((status == TWI_STATUS_START) || (status == TWI_STATUS_REP_START))
+			{
+				/*Address byte: the first device that ACKs it is selected*/
+				g_selected=NULL_PTR;
+				for(i=0;i<g_deviceCount;i++)
+				{
+					if((g_devices[i]->address != NULL_PTR) && g_devices[i]->address(data))
+					{
+						g_selected=g_devices[i];
+						break;
+					}
+				}
+				if(data & 0x01)
+				{
+					status=(g_selected != NULL_PTR) ? TWI_STATUS_SLA_R_ACK : TWI_STATUS_SLA_R_NACK;
+				}
+				else
+				{
+					status=(g_selected != NULL_PTR) ? TWI_STATUS_SLA_W_ACK : TWI_STATUS_SLA_W_NACK;
+				}
+			}
+			else if((status == TWI_STATUS_SLA_R_ACK) || (status == TWI_STATUS_DATA_R_ACK))
+			{
+				/*Master receiver: ACK is sent if TWEA is set*/
+				data=0xFF;
+				if((g_selected != NULL_PTR) && (g_selected->read != NULL_PTR))
+				{
+					data=g_selected->read(IS_BIT_SET(g_halReg[HAL_TWCR],TWEA));
+				}
+				g_halReg[HAL_TWDR]=data;
+				status=IS_BIT_SET(g_halReg[HAL_TWCR],TWEA) ? TWI_STATUS_DATA_R_ACK : TWI_STATUS_DATA_R_NACK;
+			}
+			else
+			{
+				/*Master transmitter data byte*/
+				status=TWI_STATUS_DATA_W_NACK;
+				if((g_selected != NULL_PTR) && (g_selected->write != NULL_PTR) && g_selected->write(data))
+				{
+					status=TWI_STATUS_DATA_W_ACK;
+				}
+			}
+			break;
+	}
+	g_halReg[HAL_TWSR]=(g_halReg[HAL_TWSR]&0x03) | status;
+	SET_BIT(g_halReg[HAL_TWCR],TWINT);
+}
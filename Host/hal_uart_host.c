@@ -0,0 +1,276 @@
+/*******************************************************************************************
+ * [FILE NAME]:		hal_uart_host.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains the model of USART module of ATMEGA-16 for the host
+ * 					backend of the HAL: frame timing from UBRR/U2X and frame format,
+ * 					double buffered transmitter, 2-level receive FIFO with data overrun,
+ * 					9-bit frames and multi-processor communication mode
+ *******************************************************************************************/
+
+#include <stdio.h>
+#include "hal_host_private.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+/*Number of frames that can be waiting to arrive at RXD*/
+#define HAL_UART_ARRIVALS		64u
+/*Depth of receive FIFO (UDR and one more frame like the chip)*/
+#define HAL_UART_RX_FIFO		2u
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[Structure Name]		 : HAL_UartArrivalType
+ *[Structure Description]: This structure contains a frame coming on RXD and the time
+ * 						   its stop bit ends*/
+typedef struct{
+	uint16 data;
+	uint64 time;
+}HAL_UartArrivalType;
+
+/******************************************************************
+ * 				  Private Functions Prototypes					  *
+ ******************************************************************/
+static uint64 HAL_uartFrameCycles(void);
+static void HAL_uartUpdateRx(void);
+static void HAL_uartStartFrame(uint16 data, uint64 start);
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+/*Transmitter: UDR buffer and shift register*/
+static uint16 g_txBuffer;
+static uint8 g_txBufferFull=FALSE;
+static uint16 g_txShift;
+static uint8 g_txShifting=FALSE;
+static uint64 g_txEnd;
+
+/*Receiver FIFO*/
+static uint16 g_rxFifo[HAL_UART_RX_FIFO];
+static uint8 g_rxCount=0;
+static uint8 g_rxOverrun=FALSE;
+
+/*Frames on their way to RXD*/
+static HAL_UartArrivalType g_arrivals[HAL_UART_ARRIVALS];
+static uint8 g_arrivalHead=0;
+static uint8 g_arrivalCount=0;
+
+/******************************************************************
+ * 				  Public Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function queues a frame to be received by the UART at a given time,
+ *frames are received in the order they are queued*/
+void HAL_hostUartReceive(uint16 data, uint64 time)
+{
+	if(g_arrivalCount == HAL_UART_ARRIVALS)
+	{
+		fprintf(stderr,"hal_host: UART arrivals queue is full, frame dropped\n");
+		return;
+	}
+	g_arrivals[(g_arrivalHead+g_arrivalCount)%HAL_UART_ARRIVALS].data=data;
+	g_arrivals[(g_arrivalHead+g_arrivalCount)%HAL_UART_ARRIVALS].time=time;
+	g_arrivalCount++;
+}
+
+/******************************************************************
+ * 				  Private Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function applies a firmware write on a USART register*/
+void HAL_uartWrite(HAL_RegId id, uint32 value)
+{
+	uint16 data;
+	switch(id)
+	{
+		case HAL_UDR:
+			if(IS_BIT_CLEAR(g_halReg[HAL_UCSRB],TXEN))
+			{
+				break;
+			}
+			/*9th bit is taken from TXB8 when the frame is written*/
+			data=(uint16)(value | ((g_halReg[HAL_UCSRB]&(1<<TXB8)) ? 0x100 : 0));
+			if(!g_txShifting)
+			{
+				g_txShifting=TRUE;
+				HAL_uartStartFrame(data,g_halNow);
+			}
+			else if(!g_txBufferFull)
+			{
+				g_txBuffer=data;
+				g_txBufferFull=TRUE;
+				CLEAR_BIT(g_halReg[HAL_UCSRA],UDRE);
+			}
+			else
+			{
+				/*Write while UDRE is cleared is ignored by hardware*/
+			}
+			break;
+		case HAL_UCSRA:
+			/*TXC is cleared by writing one to it, only U2X and MPCM are writable*/
+			if(value & (1<<TXC))
+			{
+				CLEAR_BIT(g_halReg[HAL_UCSRA],TXC);
+			}
+			g_halReg[HAL_UCSRA]=(g_halReg[HAL_UCSRA] & ~((1<<U2X)|(1<<MPCM))) | (value & ((1<<U2X)|(1<<MPCM)));
+			break;
+		case HAL_UCSRB:
+			/*RXB8 is read only*/
+			g_halReg[HAL_UCSRB]=(g_halReg[HAL_UCSRB] & (1<<RXB8)) | (value & ~(1<<RXB8));
+			if(IS_BIT_CLEAR(g_halReg[HAL_UCSRB],RXEN))
+			{
+				/*Disabling receiver flushes its FIFO*/
+				g_rxCount=0;
+				g_rxOverrun=FALSE;
+				HAL_uartUpdateRx();
+			}
+			break;
+		case HAL_UBRRH:
+			g_halReg[HAL_UBRRH]=value & 0x0F;
+			break;
+		default:
+			g_halReg[id]=value;
+			break;
+	}
+}
+
+/*Description: This function puts the frame at the head of receive FIFO in UDR*/
+void HAL_uartRead(HAL_RegId id)
+{
+	(void)id;
+	g_halReg[HAL_UDR]=(g_rxCount != 0) ? (g_rxFifo[0] & 0xFF) : 0;
+}
+
+/*Description: This function completes a read of UDR by moving the receive FIFO*/
+void HAL_uartReadDone(void)
+{
+	uint8 i;
+	if(g_rxCount == 0)
+	{
+		return;
+	}
+	for(i=1;i<g_rxCount;i++)
+	{
+		g_rxFifo[i-1]=g_rxFifo[i];
+	}
+	g_rxCount--;
+	g_rxOverrun=FALSE;
+	HAL_uartUpdateRx();
+}
+
+/*Description: This function returns the time of the next USART event*/
+uint64 HAL_uartNextEvent(void)
+{
+	uint64 next=HAL_HOST_NEVER;
+	if(g_txShifting)
+	{
+		next=g_txEnd;
+	}
+	if((g_arrivalCount != 0) && (g_arrivals[g_arrivalHead].time < next))
+	{
+		next=g_arrivals[g_arrivalHead].time;
+	}
+	return next;
+}
+
+/*Description: This function runs the USART events due at the current time*/
+void HAL_uartProcess(void)
+{
+	uint16 data;
+	/*Transmitter*/
+	if(g_txShifting && (g_txEnd <= g_halNow))
+	{
+		if(g_txBufferFull)
+		{
+			g_txBufferFull=FALSE;
+			HAL_uartStartFrame(g_txBuffer,g_txEnd);
+			SET_BIT(g_halReg[HAL_UCSRA],UDRE);
+		}
+		else
+		{
+			g_txShifting=FALSE;
+			SET_BIT(g_halReg[HAL_UCSRA],TXC);
+		}
+	}
+	/*Receiver*/
+	while((g_arrivalCount != 0) && (g_arrivals[g_arrivalHead].time <= g_halNow))
+	{
+		data=g_arrivals[g_arrivalHead].data;
+		g_arrivalHead=(g_arrivalHead+1)%HAL_UART_ARRIVALS;
+		g_arrivalCount--;
+		if(IS_BIT_CLEAR(g_halReg[HAL_UCSRB],RXEN))
+		{
+			continue;
+		}
+		/*In multi-processor mode, frames without the 9th bit (data frames) are ignored*/
+		if(IS_BIT_SET(g_halReg[HAL_UCSRA],MPCM) && !(data & 0x100))
+		{
+			continue;
+		}
+		if(g_rxCount < HAL_UART_RX_FIFO)
+		{
+			g_rxFifo[g_rxCount++]=data;
+		}
+		else
+		{
+			g_rxOverrun=TRUE;
+		}
+		HAL_uartUpdateRx();
+	}
+}
+
+/*Description: This function returns the length of a frame in CPU cycles*/
+static uint64 HAL_uartFrameCycles(void)
+{
+	uint16 ubrr=(uint16)(((g_halReg[HAL_UBRRH]&0x0F)<<8) | (g_halReg[HAL_UBRRL]&0xFF));
+	uint8 size=((g_halReg[HAL_UCSRC]>>UCSZ0)&0x03) | ((g_halReg[HAL_UCSRB]&(1<<UCSZ2)) ? 0x04 : 0);
+	/*Start bit, data bits, parity bit and stop bit(s)*/
+	uint8 bits=1+((size == 7) ? 9 : (5+(size&0x03)));
+	if(g_halReg[HAL_UCSRC] & (1<<UPM1))
+	{
+		bits++;
+	}
+	bits+=IS_BIT_SET(g_halReg[HAL_UCSRC],USBS) ? 2 : 1;
+	return (uint64)bits*(IS_BIT_SET(g_halReg[HAL_UCSRA],U2X) ? 8u : 16u)*(ubrr+1u);
+}
+
+/*Description: This function moves a frame into transmit shift register, the environment
+ *is told about it at once so a peer knows when it arrives ahead of time*/
+static void HAL_uartStartFrame(uint16 data, uint64 start)
+{
+	g_txShift=data;
+	g_txEnd=start+HAL_uartFrameCycles();
+	if((g_halEnv != NULL_PTR) && (g_halEnv->uartTx != NULL_PTR))
+	{
+		g_halEnv->uartTx(data,g_txEnd);
+	}
+}
+
+/*Description: This function updates RXC, DOR and RXB8 from receive FIFO*/
+static void HAL_uartUpdateRx(void)
+{
+	if(g_rxCount != 0)
+	{
+		SET_BIT(g_halReg[HAL_UCSRA],RXC);
+	}
+	else
+	{
+		CLEAR_BIT(g_halReg[HAL_UCSRA],RXC);
+	}
+	if(g_rxOverrun)
+	{
+		SET_BIT(g_halReg[HAL_UCSRA],DOR);
+	}
+	else
+	{
+		CLEAR_BIT(g_halReg[HAL_UCSRA],DOR);
+	}
+	if((g_rxCount != 0) && (g_rxFifo[0] & 0x100))
+	{
+		SET_BIT(g_halReg[HAL_UCSRB],RXB8);
+	}
+	else
+	{
+		CLEAR_BIT(g_halReg[HAL_UCSRB],RXB8);
+	}
+}
@@ -0,0 +1,174 @@
+/*******************************************************************************************
+ * [FILE NAME]:		hashbench.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains the main function of the PIN hash benchmark:
+ * 					hashbench [-n runs]
+ * 					It checks the BLAKE2s kernel of Control (blake2s.c, built natively
+ * 					without the cycle charges of the firmware build) against known answers
+ * 					(RFC 7693 and salted, truncated and multi-block digests of Python
+ * 					hashlib), then times digests of a PIN as Control computes them and
+ * 					prints nanoseconds and host cycles a digest. Virtual time of the host HAL
+ * 					doesn't count computation, so AVR cycles are measured on target by the
+ * 					DIAG_HASH_BENCH request of Control (PROBE_HASH probe)
+ *******************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "blake2s.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+#define BENCH_DEFAULT_RUNS		1000000ul
+#define BENCH_PIN_SIZE			5u
+#define BENCH_DIGEST_SIZE		5u
+#define BENCH_MESSAGE_SIZE		200u
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[Structure Name]		 : BENCH_VectorType
+ *[Structure Description]: This structure contains a known answer: message (a string, or
+ * 						   bytes 0, 1, 2... of the given size if it's NULL_PTR), salt
+ * 						   (NULL_PTR for none) and the digest in hex*/
+typedef struct{
+	const char * message;
+	uint16 size;
+	const uint8 * salt;
+	const char * digest;
+}BENCH_VectorType;
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+static const uint8 g_salt[BLAKE2S_SALT_SIZE]={1,2,3,4,5,6,7,8};
+
+static const BENCH_VectorType g_vectors[]={
+	{"abc",3,NULL_PTR,"508c5e8c327c14e2e1a72ba34eeb452f37458b209ed63a294d999b4c86675982"},
+	{"",0,NULL_PTR,"69217a3079908094e11121d042354a7c1f55b6482ca1a51e1b250dfd1ed0eef9"},
+	{"12345",5,g_salt,"e943a199d3"},
+	{NULL_PTR,128,NULL_PTR,"7a3b3fa888b60095e7b305efcf3c3dbc"},
+	{NULL_PTR,BENCH_MESSAGE_SIZE,g_salt,"57d02ad5322d657abeeeffcc3fc856ba9ee62e262db9e27b0b83aa8be8ab6ca3"}
+};
+
+/******************************************************************
+ * 				  Private Functions Prototypes					  *
+ ******************************************************************/
+static uint8 BENCH_check(const BENCH_VectorType * vector);
+static uint64 BENCH_cycles(void);
+
+int main(int argc, char * argv[])
+{
+	unsigned long runs=BENCH_DEFAULT_RUNS;
+	uint8 pin[BENCH_PIN_SIZE]={'1','2','3','4','5'};
+	uint8 digest[BENCH_DIGEST_SIZE];
+	struct timespec start;
+	struct timespec end;
+	uint64 cycles;
+	double nanoseconds;
+	unsigned long run;
+	uint8 failed=0;
+	uint8 i;
+	int option;
+	while((option=getopt(argc,argv,"n:")) != -1)
+	{
+		switch(option)
+		{
+			case 'n': runs=strtoul(optarg,NULL_PTR,0); break;
+			default:
+				fprintf(stderr,"usage: %s [-n runs]\n",argv[0]);
+				return EXIT_FAILURE;
+		}
+	}
+	if((optind != argc) || (runs == 0))
+	{
+		fprintf(stderr,"usage: %s [-n runs]\n",argv[0]);
+		return EXIT_FAILURE;
+	}
+	for(i=0;i<sizeof(g_vectors)/sizeof(g_vectors[0]);i++)
+	{
+		if(!BENCH_check(&g_vectors[i]))
+		{
+			failed++;
+		}
+	}
+	printf("%u known answer(s) failed\n",failed);
+	if(failed != 0)
+	{
+		return EXIT_FAILURE;
+	}
+	/*Each digest is chained into the next PIN so the calls can't be folded away*/
+	clock_gettime(CLOCK_MONOTONIC,&start);
+	cycles=BENCH_cycles();
+	for(run=0;run<runs;run++)
+	{
+		BLAKE2S_hash(digest,BENCH_DIGEST_SIZE,pin,BENCH_PIN_SIZE,g_salt);
+		pin[run%BENCH_PIN_SIZE]^=digest[0];
+	}
+	cycles=BENCH_cycles()-cycles;
+	clock_gettime(CLOCK_MONOTONIC,&end);
+	nanoseconds=((double)(end.tv_sec-start.tv_sec)*1e9)+(double)(end.tv_nsec-start.tv_nsec);
+	printf("PIN digest (%u byte PIN, %u byte digest, salted): %lu run(s), %.1f ns",
+		   BENCH_PIN_SIZE,BENCH_DIGEST_SIZE,runs,nanoseconds/(double)runs);
+	if(cycles != 0)
+	{
+		printf(", %.0f host cycle(s)",(double)cycles/(double)runs);
+	}
+	printf(" a digest\n");
+	return EXIT_SUCCESS;
+}
+
+/******************************************************************
+ * 				  Private Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function computes the digest of a known answer, of the size of the
+ *expected one, and prints it if it differs*/
+static uint8 BENCH_check(const BENCH_VectorType * vector)
+{
+	uint8 message[BENCH_MESSAGE_SIZE];
+	uint8 digest[BLAKE2S_MAX_DIGEST];
+	char hex[(2u*BLAKE2S_MAX_DIGEST)+1u];
+	uint8 size=(uint8)(strlen(vector->digest)/2u);
+	uint16 i;
+	if(vector->message != NULL_PTR)
+	{
+		memcpy(message,vector->message,vector->size);
+	}
+	else
+	{
+		for(i=0;i<vector->size;i++)
+		{
+			message[i]=(uint8)i;
+		}
+	}
+	BLAKE2S_hash(digest,size,message,vector->size,vector->salt);
+	for(i=0;i<size;i++)
+	{
+		sprintf(&hex[2u*i],"%02x",digest[i]);
+	}
+	if(strcmp(hex,vector->digest))
+	{
+		printf("%u byte message%s: %s, expected %s\n",vector->size,
+			   (vector->salt != NULL_PTR) ? " (salted)" : "",hex,vector->digest);
+		return FALSE;
+	}
+	return TRUE;
+}
+
+/*Description: This function returns the time stamp counter of the host CPU, 0 if it has
+ *none*/
+static uint64 BENCH_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
@@ -0,0 +1,349 @@
+/*******************************************************************************************
+ * [FILE NAME]:		sim.h
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This header file contains the types and functions of the co-simulator
+ * 					which runs HMI and Control firmware (built for the host HAL backend as
+ * 					shared objects) together in virtual time:
+ * 					1. Each ECU runs on its own coroutine and owns its virtual clock
+ * 					2. A conservative discrete-event scheduler always resumes the ECU which
+ * 					   is behind, up to the other ECU's time plus the link lookahead
+ * 					3. UARTs (or SPI) are connected by a modelled link, keypad presses come from a
+ * 					   script, LCD/motor/buzzer are observed and a 24C16 is on Control TWI
+ *******************************************************************************************/
+#ifndef SIM_H_
+#define SIM_H_
+
+/******************************************************************
+ * 				Common Header Files Inclusion					  *
+ ******************************************************************/
+#include <stdio.h>
+#include <ucontext.h>
+#include "hal_host.h"
+#include "common_macros.h"
+#include "trace.h"
+#include "link.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+/*CPU frequency of both ECUs*/
+#define SIM_F_CPU				8000000ULL
+#define SIM_MS(MS)				((uint64)(MS)*(SIM_F_CPU/1000u))
+
+/*Door bolt: travel time between locked and open at full speed, and motor current sensed on
+ *ADC0 of Control (ADC counts) while the motor turns freely or stalls at an end stop*/
+#define SIM_BOLT_TRAVEL			SIM_MS(4000)
+#define SIM_MOTOR_SENSE_CHANNEL	0u
+#define SIM_MOTOR_RUN_CURRENT	200u
+#define SIM_MOTOR_STALL_CURRENT	700u
+/*Control sensor pins on PORTD: door contact (INT0) and bolt switch (INT1), a closed switch
+ *reads low*/
+#define SIM_SENSOR_PORT			3u
+#define SIM_DOOR_PIN			2u
+#define SIM_BOLT_PIN			3u
+/*Bolt encoder of Control: quadrature states over the bolt travel (4 per cycle, one count
+ *of x2 decoding every 2 states), channel A on INT2 (PB2) and channel B on PD6*/
+#define SIM_ENCODER_STATES		4000u
+#define SIM_ENCODER_A_PORT		1u
+#define SIM_ENCODER_A_PIN		2u
+#define SIM_ENCODER_B_PORT		3u
+#define SIM_ENCODER_B_PIN		6u
+
+/*Link between UARTs: baud rate and the lookahead of the scheduler, which must be less
+ *than the shortest frame on the link (a frame written now can't arrive earlier)*/
+#define SIM_LINK_BAUD			9600u
+#define SIM_LINK_LOOKAHEAD		SIM_MS(1)
+/*Lookahead of Control: on SPI link (LINK_TRANSPORT) HMI as master exchanges a byte with
+ *Control at the start of a transfer, so Control is never run ahead of HMI and HMI waits for
+ *Control to reach the transfer*/
+#if(LINK_TRANSPORT == LINK_SPI)
+#define SIM_SLAVE_LOOKAHEAD		0u
+#else
+#define SIM_SLAVE_LOOKAHEAD		SIM_LINK_LOOKAHEAD
+#endif
+
+/*Stack of each ECU coroutine*/
+#define SIM_STACK_SIZE			(256u*1024u)
+
+/*LCD geometry*/
+#define SIM_LCD_ROWS			4u
+#define SIM_LCD_COLS			16u
+
+/*Script limits*/
+#define SIM_MAX_STEPS			512u
+#define SIM_MAX_PRESSES			32u
+#define SIM_DEFAULT_HOLD_MS		100u
+#define SIM_DEFAULT_GAP_MS		100u
+#define SIM_DEFAULT_TIMEOUT_MS	30000u
+
+/*Latency of an expectation which was not met*/
+#define SIM_FAILED				HAL_HOST_NEVER
+
+/*Password length of both ECUs (PASSWORD_SIZE)*/
+#define SIM_PASSWORD_SIZE		5u
+
+/*24C16 geometry and timing: size, write page, write cycle time (tWR) and rated endurance
+ *of a cell in write cycles*/
+#define SIM_EEPROM_SIZE			2048u
+#define SIM_EEPROM_PAGE			16u
+#define SIM_EEPROM_WRITE_TIME	SIM_MS(5)
+#define SIM_EEPROM_ENDURANCE	1000000u
+
+/*Software UART debug channel of both ECUs on PD7 (soft_uart.h), its bit time is 8 TIMER2
+ *counts of a whole compare period as firmware rounds it*/
+#define SIM_DEBUG_PORT			3u
+#define SIM_DEBUG_PIN			7u
+#define SIM_DEBUG_BAUD			19200u
+#define SIM_DEBUG_BIT_TIME		(8u*(SIM_F_CPU/(8u*SIM_DEBUG_BAUD)))
+#define SIM_DEBUG_IDLE			0xFFu
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[ENUM Name]		: SIM_MotorState
+ *[ENUM Description]: This enum contains the states of the door motor*/
+typedef enum{
+	SIM_MOTOR_STOP,SIM_MOTOR_CW,SIM_MOTOR_CCW
+}SIM_MotorState;
+
+/*[ENUM Name]		: SIM_StepKind
+ *[ENUM Description]: This enum contains the commands of a script*/
+typedef enum{
+	SIM_STEP_WAIT,SIM_STEP_PRESS,SIM_STEP_EXPECT_LCD,SIM_STEP_EXPECT_MOTOR,
+	SIM_STEP_EXPECT_BUZZER,SIM_STEP_SHOW,SIM_STEP_DOOR
+}SIM_StepKind;
+
+/*[Structure Name]		 : SIM_StepType
+ *[Structure Description]: This structure contains a script command:
+ * 						   wait <ms>
+ * 						   press <key> [hold ms]
+ * 						   expect lcd "<text>" [timeout ms]
+ * 						   expect motor cw|ccw|stop [timeout ms]
+ * 						   expect buzzer on|off [timeout ms]
+ * 						   show
+ * 						   door open|closed*/
+typedef struct{
+	SIM_StepKind kind;
+	uint16 line;
+	uint8 key;
+	uint8 state;
+	uint64 duration;
+	char text[SIM_LCD_COLS+1];
+}SIM_StepType;
+
+/*[Structure Name]		 : SIM_ProgramType
+ *[Structure Description]: This structure contains a parsed script, it's read only while
+ * 						   running so it can be shared by many doors*/
+typedef struct{
+	SIM_StepType steps[SIM_MAX_STEPS];
+	uint16 count;
+}SIM_ProgramType;
+
+/*[Structure Name]		 : SIM_PressType
+ *[Structure Description]: This structure contains the time a key is held down*/
+typedef struct{
+	uint8 key;
+	uint64 down;
+	uint64 up;
+}SIM_PressType;
+
+/*[Structure Name]		 : SIM_ScriptType
+ *[Structure Description]: This structure contains the state of a script running on a door.
+ * 						   Wait and press steps are scheduled ahead at once, the script
+ * 						   stops at each expect step till the door meets it or it times out*/
+typedef struct{
+	const SIM_ProgramType * program;
+	uint16 current;
+	uint64 stepStart;
+	/*Time of last key down (latencies are measured from it) and last key up*/
+	uint64 lastDown;
+	uint64 lastUp;
+	SIM_PressType presses[SIM_MAX_PRESSES];
+	uint8 pressHead;
+	uint8 pressCount;
+	/*Latency of each step, SIM_FAILED if its expectation was not met*/
+	uint64 latency[SIM_MAX_STEPS];
+	uint16 failures;
+	uint8 finished;
+}SIM_ScriptType;
+
+/*[Structure Name]		 : SIM_LcdType
+ *[Structure Description]: This structure contains the state of HD44780 LCD model driven
+ * 						   through HMI GPIO (8-bit mode)*/
+typedef struct{
+	uint8 ddram[0x80];
+	uint8 cgram[64];
+	uint8 address;
+	uint8 cgramMode;
+	uint8 enable;
+	uint8 data;
+}SIM_LcdType;
+
+/*[Structure Name]		 : SIM_EepromImageType
+ *[Structure Description]: This structure contains the persistent part of 24C16 model (the
+ * 						   layout of its image file): cells and the write cycles of each cell*/
+typedef struct{
+	uint8 memory[SIM_EEPROM_SIZE];
+	uint32 writes[SIM_EEPROM_SIZE];
+}SIM_EepromImageType;
+
+/*[Structure Name]		 : SIM_EepromType
+ *[Structure Description]: This structure contains the state of 24C16 model*/
+typedef struct{
+	SIM_EepromImageType * image;
+	/*Page buffer and mask of its bytes latched since the device address*/
+	uint8 page[SIM_EEPROM_PAGE];
+	uint16 latched;
+	uint16 address;
+	uint8 block;
+	uint8 addressed;
+	uint8 reading;
+	/*End of the write cycle in progress*/
+	uint64 busyUntil;
+	/*Activity of this run*/
+	uint32 cycles;
+	uint32 bytesWritten;
+	uint32 bytesRead;
+	uint32 busyNacks;
+	/*Trace output, NULL_PTR for none*/
+	FILE * trace;
+}SIM_EepromType;
+
+/*[Structure Name]		 : SIM_DebugType
+ *[Structure Description]: This structure contains the receiver of an ECU debug channel, it
+ * 						   decodes 8N1 frames from the pin edges sampling each bit at its middle*/
+typedef struct{
+	/*Received bytes are written to file, NULL_PTR for none*/
+	FILE * file;
+	uint8 level;
+	/*Next bit of the frame to sample (0 start ... 9 stop), SIM_DEBUG_IDLE between frames*/
+	uint8 bit;
+	uint16 shift;
+	uint64 start;
+	uint32 bytes;
+	uint32 framingErrors;
+}SIM_DebugType;
+
+struct SIM_Door;
+
+/*[Structure Name]		 : SIM_EcuType
+ *[Structure Description]: This structure contains an ECU: its firmware shared object with
+ * 						   the HAL functions used by the simulator and its coroutine*/
+typedef struct SIM_Ecu{
+	const char * name;
+	void * handle;
+	int (*main)(void);
+	void (*setEnvironment)(const HAL_HostEnvType * env);
+	void (*setHorizon)(uint64 time);
+	uint64 (*now)(void);
+	void (*uartReceive)(uint16 data, uint64 time);
+	uint8 (*spiReceive)(uint8 data, uint64 time);
+	void (*twiAttach)(const HAL_TwiDeviceType * device);
+	void (*pinChange)(uint8 port, uint8 pin, uint8 level, uint64 time);
+	/*Trace ring of the firmware, NULL_PTR if it's built without tracing*/
+	const TRACE_RingType * traceRing;
+	SIM_DebugType debug;
+	ucontext_t context;
+	void * stack;
+	struct SIM_Door * door;
+	struct SIM_Ecu * peer;
+}SIM_EcuType;
+
+/*[Structure Name]		 : SIM_DoorType
+ *[Structure Description]: This structure contains a door: both ECUs and the world around them*/
+typedef struct SIM_Door{
+	SIM_EcuType hmi;
+	SIM_EcuType control;
+	SIM_LcdType lcd;
+	SIM_EepromType eeprom;
+	SIM_ScriptType script;
+	SIM_MotorState motor;
+	/*Bolt position (0 locked, SIM_BOLT_TRAVEL open) at the last motor change and its time,
+	 *the bolt moves at full speed times the duty of the motor enable over 255*/
+	uint64 bolt;
+	uint64 boltTime;
+	uint8 duty;
+	/*Door open by someone walking through*/
+	uint8 open;
+	uint8 buzzer;
+	/*UART frames or SPI transfers carrying data on the link*/
+	uint32 frames;
+	/*Trace output, NULL_PTR for none*/
+	FILE * trace;
+}SIM_DoorType;
+
+/******************************************************************
+ * 				  Public Functions Prototypes					  *
+ ******************************************************************/
+/*sim_ecu.c*/
+/*Description: This function loads a firmware shared object in an ECU*/
+uint8 SIM_ecuLoad(SIM_EcuType * ecu, const char * name, const char * path);
+/*Description: This function unloads the firmware of an ECU*/
+void SIM_ecuUnload(SIM_EcuType * ecu);
+/*Description: This function writes the trace ring of an ECU to a file in the format of
+ *TRACE_dump, returns FALSE on error*/
+uint8 SIM_ecuWriteTrace(const SIM_EcuType * ecu, const char * path);
+/*Description: This function connects the ECUs of a door and the models around them, the
+ *EEPROM image is kept in a file if a path is given. Returns FALSE on error*/
+uint8 SIM_doorInit(SIM_DoorType * door, const SIM_ProgramType * program, const char * eeprom, FILE * trace);
+/*Description: This function unloads the ECUs of a door and closes its EEPROM image*/
+void SIM_doorDeinit(SIM_DoorType * door);
+/*Description: This function runs a door till its script finishes or time limit is reached*/
+void SIM_doorRun(SIM_DoorType * door, uint64 limit);
+/*Description: This function returns the time both ECUs of a door have reached*/
+uint64 SIM_doorNow(const SIM_DoorType * door);
+/*Description: This function opens or closes the door at a given time, Control sees it on
+ *its door contact*/
+void SIM_doorContact(SIM_DoorType * door, uint8 open, uint64 time);
+
+/*sim_debug.c*/
+/*Description: This function starts the receiver of a debug channel, idle line*/
+void SIM_debugInit(SIM_DebugType * debug, FILE * file);
+/*Description: This function takes the level of the debug pin at a given time*/
+void SIM_debugPin(SIM_DebugType * debug, uint8 level, uint64 time);
+/*Description: This function samples bits due till a given time, the last frame of a run is
+ *completed by calling it at the end*/
+void SIM_debugAdvance(SIM_DebugType * debug, uint64 time);
+
+/*sim_lcd.c*/
+void SIM_lcdInit(SIM_LcdType * lcd);
+/*Description: This function updates the LCD with HMI data and control ports, returns TRUE
+ *if the display content changed*/
+uint8 SIM_lcdPins(SIM_LcdType * lcd, uint8 port, uint8 out);
+uint8 SIM_lcdContains(const SIM_LcdType * lcd, const char * text);
+void SIM_lcdPrint(const SIM_LcdType * lcd, FILE * file);
+
+/*sim_eeprom.c*/
+/*Description: This function maps the EEPROM image from a file or from memory if path is
+ *NULL_PTR, returns FALSE on error*/
+uint8 SIM_eepromOpen(SIM_EepromType * eeprom, const char * path);
+void SIM_eepromClose(SIM_EepromType * eeprom);
+uint8 SIM_eepromAddress(SIM_EepromType * eeprom, uint8 sla, uint64 time);
+uint8 SIM_eepromWrite(SIM_EepromType * eeprom, uint8 data);
+uint8 SIM_eepromRead(SIM_EepromType * eeprom, uint8 ack);
+void SIM_eepromStop(SIM_EepromType * eeprom, uint64 time);
+uint16 SIM_eepromMostWritten(const SIM_EepromType * eeprom);
+/*Description: This function prints the EEPROM activity of this run and the wear of its
+ *most written cell*/
+void SIM_eepromReport(const SIM_EepromType * eeprom, FILE * file);
+
+/*sim_script.c*/
+/*Description: This function parses a script file, returns FALSE on error*/
+uint8 SIM_scriptLoad(SIM_ProgramType * program, const char * path);
+void SIM_scriptInit(SIM_ScriptType * script, const SIM_ProgramType * program);
+/*Description: This function schedules steps which don't wait for the door and checks
+ *the pending expectation against the door state at a given time*/
+void SIM_scriptAdvance(SIM_DoorType * door, uint64 time);
+/*Description: This function fails the pending expectation if it timed out by a given time*/
+void SIM_scriptTimeout(SIM_DoorType * door, uint64 time);
+/*Description: This function returns keypad port pins seen by HMI at a given time*/
+uint8 SIM_scriptKeypad(SIM_ScriptType * script, uint64 time, uint8 ddr, uint8 out);
+/*Description: This function returns the text of an expect step*/
+void SIM_scriptDescribe(const SIM_StepType * step, char * text, size_t size);
+/*Description: This function generates a random user workload of a door from a seed*/
+void SIM_scriptRandom(SIM_ProgramType * program, uint32 seed, uint16 sessions);
+/*Description: This function prints the latency of each expect step of a script*/
+void SIM_scriptReport(const SIM_ScriptType * script, FILE * file);
+
+#endif /* SIM_H_ */
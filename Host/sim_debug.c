@@ -0,0 +1,77 @@
+/*******************************************************************************************
+ * [FILE NAME]:		sim_debug.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains the receiver of the software UART debug channel of
+ * 					an ECU for the co-simulator. The pin only reports its edges, so each bit
+ * 					is sampled at its middle once an edge (or the end of the run) shows the
+ * 					level it had there
+ *******************************************************************************************/
+
+#include "sim.h"
+
+/******************************************************************
+ * 				  Public Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function starts the receiver with the line idle (high)*/
+void SIM_debugInit(SIM_DebugType * debug, FILE * file)
+{
+	debug->file=file;
+	debug->level=1;
+	debug->bit=SIM_DEBUG_IDLE;
+	debug->shift=0;
+	debug->start=0;
+	debug->bytes=0;
+	debug->framingErrors=0;
+}
+
+/*Description: This function samples the bits due before the edge with the level they had,
+ *then a falling edge on an idle line starts a frame*/
+void SIM_debugPin(SIM_DebugType * debug, uint8 level, uint64 time)
+{
+	if(level == debug->level)
+	{
+		return;
+	}
+	SIM_debugAdvance(debug,time);
+	if((debug->bit == SIM_DEBUG_IDLE) && (level == 0))
+	{
+		debug->bit=0;
+		debug->shift=0;
+		debug->start=time;
+	}
+	debug->level=level;
+}
+
+/*Description: This function samples the bits whose middle is before a given time, the line
+ *kept its current level since the last edge. A frame ends at its stop bit, a low stop bit
+ *is a framing error and the byte is dropped*/
+void SIM_debugAdvance(SIM_DebugType * debug, uint64 time)
+{
+	while((debug->bit != SIM_DEBUG_IDLE)
+		  && (debug->start+(debug->bit*SIM_DEBUG_BIT_TIME)+(SIM_DEBUG_BIT_TIME/2u) < time))
+	{
+		if((debug->bit >= 1) && (debug->bit <= 8))
+		{
+			debug->shift|=(uint16)debug->level<<(debug->bit-1u);
+		}
+		if(debug->bit < 9)
+		{
+			debug->bit++;
+			continue;
+		}
+		if(debug->level)
+		{
+			debug->bytes++;
+			if(debug->file != NULL_PTR)
+			{
+				fputc(debug->shift,debug->file);
+			}
+		}
+		else
+		{
+			debug->framingErrors++;
+		}
+		debug->bit=SIM_DEBUG_IDLE;
+	}
+}
@@ -0,0 +1,506 @@
+/*******************************************************************************************
+ * [FILE NAME]:		sim_ecu.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains the ECU coroutines and the discrete-event scheduler
+ * 					of the co-simulator, and the environment each ECU's HAL is connected to
+ *******************************************************************************************/
+
+#include <dlfcn.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sim.h"
+#include "spi.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+/*HMI ports: keypad on PORTA, LCD data on PORTC and control on PORTD*/
+#define SIM_KEYPAD_PORT			0u
+/*Control ports: motor on PORTB (enable on OC0), buzzer on OC1B (PD4) which the HAL holds
+ *high while it sounds a tone*/
+#define SIM_MOTOR_PORT			1u
+#define SIM_MOTOR_PIN1			0u
+#define SIM_MOTOR_PIN2			1u
+#define SIM_MOTOR_EN			3u
+#define SIM_BUZZER_PORT			3u
+#define SIM_BUZZER_PIN			4u
+
+/******************************************************************
+ * 				  Private Functions Prototypes					  *
+ ******************************************************************/
+static void SIM_ecuEntry(void);
+static void SIM_ecuResume(SIM_EcuType * ecu, uint64 horizon);
+static void SIM_envUartTx(uint16 data, uint64 end);
+static uint8 SIM_envGpioRead(uint8 port, uint8 ddr, uint8 out);
+static void SIM_envGpioWrite(uint8 port, uint8 ddr, uint8 out);
+static void SIM_envSync(void);
+static uint8 SIM_envSpiTransfer(uint8 data, uint64 end);
+static uint16 SIM_envAdcRead(uint8 channel, uint64 time);
+static void SIM_envPwmWrite(uint8 timer, uint8 duty);
+static uint64 SIM_boltAt(const SIM_DoorType * door, uint64 time);
+static uint64 SIM_boltReached(const SIM_DoorType * door, uint64 bolt, uint64 time);
+static void SIM_boltSwitch(SIM_DoorType * door, uint64 time);
+static void SIM_encoder(SIM_DoorType * door, uint64 time);
+static uint8 SIM_twiAddress(uint8 sla);
+static uint8 SIM_twiWrite(uint8 data);
+static uint8 SIM_twiRead(uint8 ack);
+static void SIM_twiStop(void);
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+/*ECU running on this thread and the scheduler context it yields to*/
+static __thread SIM_EcuType * g_current=NULL_PTR;
+static __thread ucontext_t g_scheduler;
+
+/*Callbacks carry no context, they act on the ECU running on the calling thread*/
+static const HAL_HostEnvType g_env={SIM_envUartTx,SIM_envGpioRead,SIM_envGpioWrite,SIM_envSync,NULL_PTR,
+											 SIM_envSpiTransfer,SIM_envAdcRead,SIM_envPwmWrite};
+static const HAL_TwiDeviceType g_eepromDevice={SIM_twiAddress,SIM_twiWrite,SIM_twiRead,SIM_twiStop};
+
+/******************************************************************
+ * 				  Public Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function loads a firmware shared object in an ECU, the object is
+ *opened with local symbols so both ECUs (and their HAL copies) live side by side*/
+uint8 SIM_ecuLoad(SIM_EcuType * ecu, const char * name, const char * path)
+{
+	memset(ecu,0,sizeof(*ecu));
+	ecu->name=name;
+	ecu->handle=dlopen(path,RTLD_NOW | RTLD_LOCAL);
+	if(ecu->handle == NULL_PTR)
+	{
+		fprintf(stderr,"sim: %s\n",dlerror());
+		return FALSE;
+	}
+	*(void **)&ecu->main=dlsym(ecu->handle,"main");
+	*(void **)&ecu->setEnvironment=dlsym(ecu->handle,"HAL_hostSetEnvironment");
+	*(void **)&ecu->setHorizon=dlsym(ecu->handle,"HAL_hostSetHorizon");
+	*(void **)&ecu->now=dlsym(ecu->handle,"HAL_hostNow");
+	*(void **)&ecu->uartReceive=dlsym(ecu->handle,"HAL_hostUartReceive");
+	*(void **)&ecu->spiReceive=dlsym(ecu->handle,"HAL_hostSpiReceive");
+	*(void **)&ecu->twiAttach=dlsym(ecu->handle,"HAL_hostTwiAttach");
+	*(void **)&ecu->pinChange=dlsym(ecu->handle,"HAL_hostPinChange");
+	ecu->traceRing=dlsym(ecu->handle,"g_traceRing");
+	if((ecu->main == NULL_PTR) || (ecu->setEnvironment == NULL_PTR) || (ecu->setHorizon == NULL_PTR)
+	   || (ecu->now == NULL_PTR) || (ecu->uartReceive == NULL_PTR) || (ecu->spiReceive == NULL_PTR)
+	   || (ecu->twiAttach == NULL_PTR) || (ecu->pinChange == NULL_PTR))
+	{
+		fprintf(stderr,"sim: %s is not built for the host HAL\n",path);
+		return FALSE;
+	}
+	ecu->stack=malloc(SIM_STACK_SIZE);
+	getcontext(&ecu->context);
+	ecu->context.uc_stack.ss_sp=ecu->stack;
+	ecu->context.uc_stack.ss_size=SIM_STACK_SIZE;
+	ecu->context.uc_link=NULL_PTR;
+	makecontext(&ecu->context,SIM_ecuEntry,0);
+	return TRUE;
+}
+
+/*Description: This function unloads the firmware of an ECU, the coroutine is dropped where
+ *it stopped. Loading the object again gives firmware in its reset state*/
+void SIM_ecuUnload(SIM_EcuType * ecu)
+{
+	if(ecu->handle != NULL_PTR)
+	{
+		dlclose(ecu->handle);
+	}
+	free(ecu->stack);
+	ecu->handle=NULL_PTR;
+	ecu->stack=NULL_PTR;
+}
+
+/*Description: This function writes the trace ring of an ECU as TRACE_dump sends it, the
+ *firmware is stopped between scheduler steps so the ring is read as it is*/
+uint8 SIM_ecuWriteTrace(const SIM_EcuType * ecu, const char * path)
+{
+	const TRACE_RingType * ring=ecu->traceRing;
+	const TRACE_EventType * event;
+	FILE * file;
+	uint32 i;
+	if(ecu->traceRing == NULL_PTR)
+	{
+		fprintf(stderr,"sim: %s firmware is built without tracing\n",ecu->name);
+		return FALSE;
+	}
+	file=fopen(path,"w");
+	if(file == NULL_PTR)
+	{
+		perror(path);
+		return FALSE;
+	}
+	fprintf(file,"TR:%02X:%04X:%04X\n",(unsigned)CLOCK_TICK_US,ring->count,ring->lost);
+	for(i=0;i<ring->count;i++)
+	{
+		event=&ring->events[(ring->head-ring->count+i) & TRACE_MASK];
+		fprintf(file,"T%02X%08X%04X\n",event->id,event->time,event->arg);
+	}
+	fclose(file);
+	return TRUE;
+}
+
+/*Description: This function connects the ECUs of a door and the models around them,
+ *ECUs must be loaded already. The EEPROM image is kept in a file if a path is given*/
+uint8 SIM_doorInit(SIM_DoorType * door, const SIM_ProgramType * program, const char * eeprom, FILE * trace)
+{
+	if(!SIM_eepromOpen(&door->eeprom,eeprom))
+	{
+		return FALSE;
+	}
+	door->eeprom.trace=trace;
+	door->hmi.door=door;
+	door->control.door=door;
+	door->hmi.peer=&door->control;
+	door->control.peer=&door->hmi;
+	door->hmi.setEnvironment(&g_env);
+	door->control.setEnvironment(&g_env);
+	door->control.twiAttach(&g_eepromDevice);
+	SIM_lcdInit(&door->lcd);
+	SIM_debugInit(&door->hmi.debug,NULL_PTR);
+	SIM_debugInit(&door->control.debug,NULL_PTR);
+	SIM_scriptInit(&door->script,program);
+	door->motor=SIM_MOTOR_STOP;
+	door->bolt=0;
+	door->boltTime=0;
+	door->duty=0xFF;
+	door->open=FALSE;
+	/*Door closed and bolt thrown at power on*/
+	door->control.pinChange(SIM_SENSOR_PORT,SIM_DOOR_PIN,0,0);
+	door->control.pinChange(SIM_SENSOR_PORT,SIM_BOLT_PIN,0,0);
+	SIM_encoder(door,0);
+	door->buzzer=FALSE;
+	door->frames=0;
+	door->trace=trace;
+	return TRUE;
+}
+
+/*Description: This function unloads the ECUs of a door and closes its EEPROM image*/
+void SIM_doorDeinit(SIM_DoorType * door)
+{
+	SIM_ecuUnload(&door->hmi);
+	SIM_ecuUnload(&door->control);
+	SIM_eepromClose(&door->eeprom);
+}
+
+/*Description: This function runs a door till its script finishes or time limit is reached:
+ *the ECU behind is resumed till the other ECU's time plus link lookahead, so no frame can
+ *reach an ECU in its past (Control lookahead is none on SPI link)*/
+void SIM_doorRun(SIM_DoorType * door, uint64 limit)
+{
+	SIM_EcuType * ecu;
+	uint64 now;
+	while(!door->script.finished)
+	{
+		ecu=(door->hmi.now() <= door->control.now()) ? &door->hmi : &door->control;
+		now=SIM_doorNow(door);
+		SIM_scriptTimeout(door,now);
+		SIM_scriptAdvance(door,now);
+		if(now >= limit)
+		{
+			break;
+		}
+		SIM_ecuResume(ecu,ecu->peer->now()+((ecu == &door->control) ? SIM_SLAVE_LOOKAHEAD : SIM_LINK_LOOKAHEAD));
+	}
+}
+
+/*Description: This function returns the time both ECUs of a door have reached*/
+uint64 SIM_doorNow(const SIM_DoorType * door)
+{
+	uint64 hmi=door->hmi.now();
+	uint64 control=door->control.now();
+	return (hmi < control) ? hmi : control;
+}
+
+/*Description: This function opens or closes the door at a given time, not earlier than
+ *Control time as Control may be ahead of the script*/
+void SIM_doorContact(SIM_DoorType * door, uint8 open, uint64 time)
+{
+	if(time < door->control.now())
+	{
+		time=door->control.now();
+	}
+	door->open=open;
+	door->control.pinChange(SIM_SENSOR_PORT,SIM_DOOR_PIN,open,time);
+	if(door->trace != NULL_PTR)
+	{
+		fprintf(door->trace,"%12.3f ms  door %s\n",(double)time*1000.0/SIM_F_CPU,open ? "open" : "closed");
+	}
+}
+
+/******************************************************************
+ * 				  Private Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function is the entry of ECU coroutines, firmware main never returns*/
+static void SIM_ecuEntry(void)
+{
+	g_current->main();
+	fprintf(stderr,"sim: %s firmware returned from main\n",g_current->name);
+	exit(EXIT_FAILURE);
+}
+
+/*Description: This function runs an ECU till it reaches the given horizon*/
+static void SIM_ecuResume(SIM_EcuType * ecu, uint64 horizon)
+{
+	ecu->setHorizon(horizon);
+	g_current=ecu;
+	swapcontext(&g_scheduler,&ecu->context);
+	g_current=NULL_PTR;
+}
+
+/*Description: Environment, a frame started on TXD of an ECU reaches its peer at its end*/
+static void SIM_envUartTx(uint16 data, uint64 end)
+{
+	SIM_EcuType * ecu=g_current;
+	SIM_DoorType * door=ecu->door;
+	ecu->peer->uartReceive(data,end);
+	door->frames++;
+	if(door->trace != NULL_PTR)
+	{
+		fprintf(door->trace,"%12.3f ms  %-7s -> 0x%02X\n",(double)end*1000.0/SIM_F_CPU,ecu->name,data);
+	}
+}
+
+/*Description: Environment, HMI as SPI master starts a transfer: it waits till Control
+ *reaches the start of the transfer, then Control shifts out its byte and gets HMI's byte at
+ *the end. Transfers carrying data are counted and traced*/
+static uint8 SIM_envSpiTransfer(uint8 data, uint64 end)
+{
+	SIM_EcuType * ecu=g_current;
+	SIM_DoorType * door=ecu->door;
+	uint8 received;
+	while(ecu->peer->now() < ecu->now())
+	{
+		swapcontext(&ecu->context,&g_scheduler);
+	}
+	received=ecu->peer->spiReceive(data,end);
+	if((data != SPI_IDLE) || (received != SPI_IDLE))
+	{
+		door->frames++;
+		if(door->trace != NULL_PTR)
+		{
+			fprintf(door->trace,"%12.3f ms  %-7s <> 0x%02X 0x%02X\n",(double)end*1000.0/SIM_F_CPU,ecu->name,data,received);
+		}
+	}
+	return received;
+}
+
+/*Description: Environment, HMI keypad rows are pulled low by the pressed key's column.
+ *Control reading the encoder ports gets the next encoder edges planned*/
+static uint8 SIM_envGpioRead(uint8 port, uint8 ddr, uint8 out)
+{
+	SIM_EcuType * ecu=g_current;
+	if((ecu == &ecu->door->hmi) && (port == SIM_KEYPAD_PORT))
+	{
+		return SIM_scriptKeypad(&ecu->door->script,ecu->now(),ddr,out);
+	}
+	if((ecu == &ecu->door->control) && ((port == SIM_ENCODER_A_PORT) || (port == SIM_ENCODER_B_PORT)))
+	{
+		SIM_encoder(ecu->door,ecu->now());
+	}
+	return out;
+}
+
+/*Description: Environment, outputs of HMI drive the LCD and outputs of Control drive
+ *the motor and buzzer, each change is checked against the script. The debug pin of both
+ *is pulled up while it's an input*/
+static void SIM_envGpioWrite(uint8 port, uint8 ddr, uint8 out)
+{
+	SIM_EcuType * ecu=g_current;
+	SIM_DoorType * door=ecu->door;
+	SIM_MotorState motor;
+	uint8 changed=FALSE;
+	out&=ddr;
+	if(port == SIM_DEBUG_PORT)
+	{
+		SIM_debugPin(&ecu->debug,IS_BIT_CLEAR(ddr,SIM_DEBUG_PIN) || IS_BIT_SET(out,SIM_DEBUG_PIN),ecu->now());
+	}
+	if(ecu == &door->hmi)
+	{
+		changed=SIM_lcdPins(&door->lcd,port,out);
+	}
+	else if(port == SIM_MOTOR_PORT)
+	{
+		motor=SIM_MOTOR_STOP;
+		if(IS_BIT_SET(out,SIM_MOTOR_EN) && IS_BIT_SET(out,SIM_MOTOR_PIN1) && IS_BIT_CLEAR(out,SIM_MOTOR_PIN2))
+		{
+			motor=SIM_MOTOR_CW;
+		}
+		else if(IS_BIT_SET(out,SIM_MOTOR_EN) && IS_BIT_CLEAR(out,SIM_MOTOR_PIN1) && IS_BIT_SET(out,SIM_MOTOR_PIN2))
+		{
+			motor=SIM_MOTOR_CCW;
+		}
+		changed=(motor != door->motor);
+		door->bolt=SIM_boltAt(door,ecu->now());
+		door->boltTime=ecu->now();
+		door->motor=motor;
+		SIM_boltSwitch(door,ecu->now());
+		SIM_encoder(door,ecu->now());
+	}
+	if((ecu == &door->control) && (port == SIM_BUZZER_PORT))
+	{
+		changed|=(((out>>SIM_BUZZER_PIN)&1u) != door->buzzer);
+		door->buzzer=(out>>SIM_BUZZER_PIN)&1u;
+	}
+	if(changed)
+	{
+		SIM_scriptAdvance(door,ecu->now());
+	}
+}
+
+/*Description: Environment, Control samples motor current: none while the motor is stopped,
+ *stall current once the bolt reached the end stop it's driven to*/
+static uint16 SIM_envAdcRead(uint8 channel, uint64 time)
+{
+	SIM_DoorType * door=g_current->door;
+	uint64 bolt;
+	if((g_current != &door->control) || (channel != SIM_MOTOR_SENSE_CHANNEL) || (door->motor == SIM_MOTOR_STOP))
+	{
+		return 0;
+	}
+	bolt=SIM_boltAt(door,time);
+	if(((door->motor == SIM_MOTOR_CW) && (bolt == SIM_BOLT_TRAVEL)) || ((door->motor == SIM_MOTOR_CCW) && (bolt == 0)))
+	{
+		return SIM_MOTOR_STALL_CURRENT;
+	}
+	return SIM_MOTOR_RUN_CURRENT;
+}
+
+/*Description: Environment, Control changed the duty of the motor enable (OC0): the bolt
+ *is moved at the old speed till now and the bolt switch and encoder edges are planned at
+ *the new one*/
+static void SIM_envPwmWrite(uint8 timer, uint8 duty)
+{
+	SIM_EcuType * ecu=g_current;
+	SIM_DoorType * door=ecu->door;
+	if((ecu != &door->control) || (timer != 0))
+	{
+		return;
+	}
+	door->bolt=SIM_boltAt(door,ecu->now());
+	door->boltTime=ecu->now();
+	door->duty=duty;
+	SIM_boltSwitch(door,ecu->now());
+	SIM_encoder(door,ecu->now());
+}
+
+/*Description: This function returns the bolt position at a time after the last motor
+ *change, clockwise opens the bolt and anti-clockwise closes it till its end stops*/
+static uint64 SIM_boltAt(const SIM_DoorType * door, uint64 time)
+{
+	uint64 moved=(time > door->boltTime) ? (((time-door->boltTime)*door->duty)/0xFFu) : 0;
+	if(door->motor == SIM_MOTOR_CW)
+	{
+		return ((SIM_BOLT_TRAVEL-door->bolt) < moved) ? SIM_BOLT_TRAVEL : (door->bolt+moved);
+	}
+	if(door->motor == SIM_MOTOR_CCW)
+	{
+		return (door->bolt < moved) ? 0 : (door->bolt-moved);
+	}
+	return door->bolt;
+}
+
+/*Description: This function drives the bolt switch of Control after a motor change: it
+ *opens as soon as the bolt leaves its locked end stop and closes when the bolt reaches it,
+ *a change planned before is replaced*/
+static void SIM_boltSwitch(SIM_DoorType * door, uint64 time)
+{
+	if((door->motor == SIM_MOTOR_CCW) && (door->bolt != 0) && (door->duty != 0))
+	{
+		door->control.pinChange(SIM_SENSOR_PORT,SIM_BOLT_PIN,0,SIM_boltReached(door,0,time));
+	}
+	else
+	{
+		door->control.pinChange(SIM_SENSOR_PORT,SIM_BOLT_PIN,(door->motor == SIM_MOTOR_CW) || (door->bolt != 0),time);
+	}
+}
+
+/*Description: This function returns the time the moving bolt reaches a position from its
+ *position at a given time*/
+static uint64 SIM_boltReached(const SIM_DoorType * door, uint64 bolt, uint64 time)
+{
+	uint64 distance=(bolt > door->bolt) ? (bolt-door->bolt) : (door->bolt-bolt);
+	return time+(((distance*0xFFu)+door->duty-1u)/door->duty);
+}
+
+/*Description: This function drives the encoder of Control from the bolt at a given time:
+ *channels get the levels of the quadrature state the bolt is in, and while the bolt moves
+ *the next two state changes (an edge of each channel) are planned, which is enough as
+ *Control reads both channels on each edge of A. Changes planned before are replaced*/
+static void SIM_encoder(SIM_DoorType * door, uint64 time)
+{
+	uint64 state;
+	uint64 next;
+	uint64 at;
+	uint8 i;
+	door->bolt=SIM_boltAt(door,time);
+	door->boltTime=time;
+	state=(door->bolt*SIM_ENCODER_STATES)/SIM_BOLT_TRAVEL;
+	door->control.pinChange(SIM_ENCODER_A_PORT,SIM_ENCODER_A_PIN,((state%4u) == 1u) || ((state%4u) == 2u),time);
+	door->control.pinChange(SIM_ENCODER_B_PORT,SIM_ENCODER_B_PIN,(state%4u) >= 2u,time);
+	if((door->duty == 0) || (door->motor == SIM_MOTOR_STOP))
+	{
+		return;
+	}
+	for(i=1;i<=2u;i++)
+	{
+		if(door->motor == SIM_MOTOR_CW)
+		{
+			/*State next starts at its first position*/
+			next=state+i;
+			if(next > SIM_ENCODER_STATES)
+			{
+				break;
+			}
+			at=SIM_boltReached(door,(next*SIM_BOLT_TRAVEL+SIM_ENCODER_STATES-1u)/SIM_ENCODER_STATES,time);
+		}
+		else
+		{
+			/*State next starts below the first position of the state above it*/
+			if(state < i)
+			{
+				break;
+			}
+			next=state-i;
+			at=SIM_boltReached(door,(((next+1u)*SIM_BOLT_TRAVEL+SIM_ENCODER_STATES-1u)/SIM_ENCODER_STATES)-1u,time);
+		}
+		/*Entering an odd state (going up) or leaving one (going down) is an edge of A*/
+		if(((door->motor == SIM_MOTOR_CW) ? next : (next+1u)) & 1u)
+		{
+			door->control.pinChange(SIM_ENCODER_A_PORT,SIM_ENCODER_A_PIN,((next%4u) == 1u) || ((next%4u) == 2u),at);
+		}
+		else
+		{
+			door->control.pinChange(SIM_ENCODER_B_PORT,SIM_ENCODER_B_PIN,(next%4u) >= 2u,at);
+		}
+	}
+}
+
+/*Description: Environment, the ECU reached its horizon so it yields to the scheduler*/
+static void SIM_envSync(void)
+{
+	SIM_EcuType * ecu=g_current;
+	swapcontext(&ecu->context,&g_scheduler);
+}
+
+/*Description: TWI device callbacks of the 24C16 on Control bus*/
+static uint8 SIM_twiAddress(uint8 sla)
+{
+	return SIM_eepromAddress(&g_current->door->eeprom,sla,g_current->now());
+}
+
+static uint8 SIM_twiWrite(uint8 data)
+{
+	return SIM_eepromWrite(&g_current->door->eeprom,data);
+}
+
+static uint8 SIM_twiRead(uint8 ack)
+{
+	return SIM_eepromRead(&g_current->door->eeprom,ack);
+}
+
+static void SIM_twiStop(void)
+{
+	SIM_eepromStop(&g_current->door->eeprom,g_current->now());
+}
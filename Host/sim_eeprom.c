@@ -0,0 +1,203 @@
+/*******************************************************************************************
+ * [FILE NAME]:		sim_eeprom.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains the model of 24C16 EEPROM (2K x 8) on Control TWI bus
+ * 					for the co-simulator:
+ * 					1. Its 11-bit word address is made of the 3 block bits in the device
+ * 					   address (1010 A10 A9 A8 R/W) and the word address byte sent after it
+ * 					2. Data bytes are latched in a 16-byte page buffer, the address rolls
+ * 					   over inside the page, and the page is written at STOP
+ * 					3. During the write cycle (tWR) the device doesn't ACK its address
+ * 					4. Cells and their write counters are kept in a memory-mapped image,
+ * 					   backed by a file to keep them between runs
+ *******************************************************************************************/
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "sim.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+/*Device type identifier in the upper nibble of the device address*/
+#define SIM_EEPROM_DEVICE_ID	0xA0
+
+/******************************************************************
+ * 				  Public Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function maps the EEPROM image: from a file if a path is given (a new
+ *or empty file is created erased, all cells 0xFF) or else from memory in erased state.
+ *Returns FALSE on error*/
+uint8 SIM_eepromOpen(SIM_EepromType * eeprom, const char * path)
+{
+	struct stat info;
+	void * image;
+	int file;
+	uint8 erase=TRUE;
+	memset(eeprom,0,sizeof(*eeprom));
+	if(path == NULL_PTR)
+	{
+		image=mmap(NULL_PTR,sizeof(SIM_EepromImageType),PROT_READ | PROT_WRITE,MAP_PRIVATE | MAP_ANONYMOUS,-1,0);
+	}
+	else
+	{
+		file=open(path,O_RDWR | O_CREAT,0644);
+		if((file < 0) || (fstat(file,&info) != 0))
+		{
+			perror(path);
+			return FALSE;
+		}
+		if(info.st_size == 0)
+		{
+			if(ftruncate(file,sizeof(SIM_EepromImageType)) != 0)
+			{
+				perror(path);
+				close(file);
+				return FALSE;
+			}
+		}
+		else if(info.st_size == sizeof(SIM_EepromImageType))
+		{
+			erase=FALSE;
+		}
+		else
+		{
+			fprintf(stderr,"sim: %s is not a 24C16 image\n",path);
+			close(file);
+			return FALSE;
+		}
+		image=mmap(NULL_PTR,sizeof(SIM_EepromImageType),PROT_READ | PROT_WRITE,MAP_SHARED,file,0);
+		close(file);
+	}
+	if(image == MAP_FAILED)
+	{
+		perror("sim: eeprom");
+		return FALSE;
+	}
+	eeprom->image=image;
+	if(erase)
+	{
+		memset(eeprom->image->memory,0xFF,sizeof(eeprom->image->memory));
+	}
+	return TRUE;
+}
+
+/*Description: This function unmaps the EEPROM image, a file image keeps its content*/
+void SIM_eepromClose(SIM_EepromType * eeprom)
+{
+	if(eeprom->image != NULL_PTR)
+	{
+		munmap(eeprom->image,sizeof(SIM_EepromImageType));
+		eeprom->image=NULL_PTR;
+	}
+}
+
+/*Description: This function answers the device address byte at a given time, returns TRUE
+ *to ACK it. It's not ACKed during a write cycle. A read continues from the current address
+ *(set by a previous dummy write), a new address drops data latched and not written*/
+uint8 SIM_eepromAddress(SIM_EepromType * eeprom, uint8 sla, uint64 time)
+{
+	if((sla&0xF0) != SIM_EEPROM_DEVICE_ID)
+	{
+		return FALSE;
+	}
+	if(time < eeprom->busyUntil)
+	{
+		eeprom->busyNacks++;
+		return FALSE;
+	}
+	eeprom->block=(sla>>1)&0x07;
+	eeprom->reading=sla&0x01;
+	eeprom->addressed=FALSE;
+	eeprom->latched=0;
+	return TRUE;
+}
+
+/*Description: This function takes a byte from master: the first byte after a write device
+ *address is the word address, the next ones are data latched in the page of that address*/
+uint8 SIM_eepromWrite(SIM_EepromType * eeprom, uint8 data)
+{
+	uint8 offset;
+	if(!eeprom->addressed)
+	{
+		eeprom->address=((uint16)eeprom->block<<8) | data;
+		eeprom->addressed=TRUE;
+		return TRUE;
+	}
+	offset=eeprom->address%SIM_EEPROM_PAGE;
+	eeprom->page[offset]=data;
+	eeprom->latched|=(1u<<offset);
+	eeprom->address=(eeprom->address-offset)+((offset+1)%SIM_EEPROM_PAGE);
+	return TRUE;
+}
+
+/*Description: This function gives master the byte at the current address, sequential reads
+ *roll over the whole memory*/
+uint8 SIM_eepromRead(SIM_EepromType * eeprom, uint8 ack)
+{
+	uint8 data=eeprom->image->memory[eeprom->address];
+	(void)ack;
+	eeprom->address=(eeprom->address+1)%SIM_EEPROM_SIZE;
+	eeprom->bytesRead++;
+	return data;
+}
+
+/*Description: This function ends the current transfer at a given time, latched data is
+ *written to its page and the write cycle starts*/
+void SIM_eepromStop(SIM_EepromType * eeprom, uint64 time)
+{
+	uint16 base=eeprom->address-(eeprom->address%SIM_EEPROM_PAGE);
+	uint8 offset;
+	if(eeprom->latched != 0)
+	{
+		for(offset=0;offset<SIM_EEPROM_PAGE;offset++)
+		{
+			if(eeprom->latched & (1u<<offset))
+			{
+				eeprom->image->memory[base+offset]=eeprom->page[offset];
+				eeprom->image->writes[base+offset]++;
+				eeprom->bytesWritten++;
+			}
+		}
+		eeprom->cycles++;
+		eeprom->busyUntil=time+SIM_EEPROM_WRITE_TIME;
+		if(eeprom->trace != NULL_PTR)
+		{
+			fprintf(eeprom->trace,"%12.3f ms  EEPROM  page 0x%03X written (mask 0x%04X)\n",
+					(double)time*1000.0/SIM_F_CPU,base,eeprom->latched);
+		}
+	}
+	eeprom->latched=0;
+	eeprom->addressed=FALSE;
+	eeprom->reading=FALSE;
+}
+
+/*Description: This function returns the address of the most written cell of the EEPROM*/
+uint16 SIM_eepromMostWritten(const SIM_EepromType * eeprom)
+{
+	uint16 most=0;
+	uint16 i;
+	for(i=1;i<SIM_EEPROM_SIZE;i++)
+	{
+		if(eeprom->image->writes[i] > eeprom->image->writes[most])
+		{
+			most=i;
+		}
+	}
+	return most;
+}
+
+/*Description: This function prints the EEPROM activity of this run and the wear of its
+ *most written cell (over all runs of a file image) against the rated endurance*/
+void SIM_eepromReport(const SIM_EepromType * eeprom, FILE * file)
+{
+	uint16 most=SIM_eepromMostWritten(eeprom);
+	fprintf(file,"EEPROM: %u write cycle(s), %u byte(s) written, %u read, %u busy NACK(s)\n",
+			eeprom->cycles,eeprom->bytesWritten,eeprom->bytesRead,eeprom->busyNacks);
+	fprintf(file,"EEPROM: most written cell 0x%03X, %u write(s) (%.4f%% of endurance)\n",most,
+			eeprom->image->writes[most],(double)eeprom->image->writes[most]*100.0/SIM_EEPROM_ENDURANCE);
+}
@@ -0,0 +1,153 @@
+/*******************************************************************************************
+ * [FILE NAME]:		sim_lcd.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains the model of the HD44780 LCD of HMI ECU for the
+ * 					co-simulator: commands and data are latched on the falling edge of E
+ * 					from the data port (PORTC) and RS/RW pins (PORTD) in 8-bit mode
+ *******************************************************************************************/
+
+#include <string.h>
+#include "sim.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+/*HMI ports and control pins of LCD*/
+#define SIM_LCD_DATA_PORT		2u
+#define SIM_LCD_CTRL_PORT		3u
+#define SIM_LCD_RS				4u
+#define SIM_LCD_RW				5u
+#define SIM_LCD_E				6u
+
+/*Custom characters (CGRAM codes 0-7) are shown as this character*/
+#define SIM_LCD_GLYPH_CHAR		'#'
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+/*DDRAM address of first column of each row*/
+static const uint8 g_rowAddress[SIM_LCD_ROWS]={0x00,0x40,0x10,0x50};
+
+/******************************************************************
+ * 				  Private Functions Prototypes					  *
+ ******************************************************************/
+static void SIM_lcdRow(const SIM_LcdType * lcd, uint8 row, char * text);
+
+/******************************************************************
+ * 				  Public Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function puts the LCD in its state after power on and clear*/
+void SIM_lcdInit(SIM_LcdType * lcd)
+{
+	memset(lcd->ddram,' ',sizeof(lcd->ddram));
+	memset(lcd->cgram,0,sizeof(lcd->cgram));
+	lcd->address=0;
+	lcd->cgramMode=FALSE;
+	lcd->enable=FALSE;
+	lcd->data=0;
+}
+
+/*Description: This function updates the LCD with HMI data and control ports, returns TRUE
+ *if the display content changed*/
+uint8 SIM_lcdPins(SIM_LcdType * lcd, uint8 port, uint8 out)
+{
+	uint8 enable;
+	if(port == SIM_LCD_DATA_PORT)
+	{
+		lcd->data=out;
+		return FALSE;
+	}
+	if(port != SIM_LCD_CTRL_PORT)
+	{
+		return FALSE;
+	}
+	enable=(out>>SIM_LCD_E)&1u;
+	if(!(lcd->enable && !enable) || IS_BIT_SET(out,SIM_LCD_RW))
+	{
+		lcd->enable=enable;
+		return FALSE;
+	}
+	lcd->enable=enable;
+	if(IS_BIT_SET(out,SIM_LCD_RS))
+	{
+		/*Data write*/
+		if(lcd->cgramMode)
+		{
+			lcd->cgram[lcd->address&0x3F]=lcd->data;
+			lcd->address=(lcd->address+1)&0x3F;
+			return FALSE;
+		}
+		lcd->ddram[lcd->address&0x7F]=lcd->data;
+		lcd->address=(lcd->address+1)&0x7F;
+		return TRUE;
+	}
+	/*Instruction write*/
+	if(lcd->data & 0x80)
+	{
+		lcd->address=lcd->data&0x7F;
+		lcd->cgramMode=FALSE;
+	}
+	else if(lcd->data & 0x40)
+	{
+		lcd->address=lcd->data&0x3F;
+		lcd->cgramMode=TRUE;
+	}
+	else if(lcd->data == 0x01)
+	{
+		memset(lcd->ddram,' ',sizeof(lcd->ddram));
+		lcd->address=0;
+		lcd->cgramMode=FALSE;
+		return TRUE;
+	}
+	else if((lcd->data&0xFE) == 0x02)
+	{
+		lcd->address=0;
+		lcd->cgramMode=FALSE;
+	}
+	return FALSE;
+}
+
+/*Description: This function checks if a text is shown on any row of the LCD*/
+uint8 SIM_lcdContains(const SIM_LcdType * lcd, const char * text)
+{
+	char row[SIM_LCD_COLS+1];
+	uint8 i;
+	for(i=0;i<SIM_LCD_ROWS;i++)
+	{
+		SIM_lcdRow(lcd,i,row);
+		if(strstr(row,text) != NULL_PTR)
+		{
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+/*Description: This function prints the LCD rows*/
+void SIM_lcdPrint(const SIM_LcdType * lcd, FILE * file)
+{
+	char row[SIM_LCD_COLS+1];
+	uint8 i;
+	for(i=0;i<SIM_LCD_ROWS;i++)
+	{
+		SIM_lcdRow(lcd,i,row);
+		fprintf(file,"    |%s|\n",row);
+	}
+}
+
+/******************************************************************
+ * 				  Private Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function returns the text of a row of LCD*/
+static void SIM_lcdRow(const SIM_LcdType * lcd, uint8 row, char * text)
+{
+	uint8 i;
+	uint8 c;
+	for(i=0;i<SIM_LCD_COLS;i++)
+	{
+		c=lcd->ddram[g_rowAddress[row]+i];
+		text[i]=(c < 8) ? SIM_LCD_GLYPH_CHAR : (((c < ' ') || (c > '~')) ? '?' : (char)c);
+	}
+	text[SIM_LCD_COLS]='\0';
+}
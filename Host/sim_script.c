@@ -0,0 +1,567 @@
+/*******************************************************************************************
+ * [FILE NAME]:		sim_script.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains the user scripts of the co-simulator: parsing, key
+ * 					presses on the HMI keypad matrix (4x4 Proteus layout) and expectations
+ * 					on LCD/motor/buzzer with the latency each one is met after
+ *******************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "sim.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+#define SIM_LINE_SIZE			128u
+#define SIM_KEYS				16u
+/*Keypad columns are driven on pins 4-7 and rows are read on pins 0-3*/
+#define SIM_KEYPAD_FIRST_COL	4u
+
+/*Random workloads: steps a session may take at most, user timing ranges in ms, the odds
+ *(out of 8) of mistyping the reentered new password and of walking through an open door,
+ *opened after the bolt (4 s) and closed within the 15 s the door is kept unlocked*/
+#define SIM_SESSION_STEPS		80u
+#define SIM_THINK_MIN_MS		200u
+#define SIM_THINK_MAX_MS		5000u
+#define SIM_KEY_GAP_MIN_MS		50u
+#define SIM_KEY_GAP_MAX_MS		600u
+#define SIM_HOLD_MIN_MS			60u
+#define SIM_HOLD_MAX_MS			250u
+#define SIM_MISTYPE_ODDS		1u
+#define SIM_WALK_ODDS			6u
+#define SIM_WALK_MIN_MS			4500u
+#define SIM_WALK_MAX_MS			8000u
+#define SIM_PASS_MIN_MS			1000u
+#define SIM_PASS_MAX_MS			4000u
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[Structure Name]		 : SIM_KeyType
+ *[Structure Description]: This structure contains the label of a key in scripts and its
+ * 						   switch number (row*4+column) on the keypad matrix*/
+typedef struct{
+	const char * label;
+	uint8 code;
+}SIM_KeyType;
+
+/******************************************************************
+ * 				  Private Functions Prototypes					  *
+ ******************************************************************/
+static uint8 SIM_scriptMet(const SIM_DoorType * door, const SIM_StepType * step);
+static void SIM_scriptComplete(SIM_DoorType * door, uint64 time, uint64 latency);
+static uint32 SIM_randomRange(uint32 * state, uint32 min, uint32 max);
+static void SIM_randomPassword(uint32 * state, uint8 * password, const uint8 * differ);
+static SIM_StepType * SIM_scriptAdd(SIM_ProgramType * program, SIM_StepKind kind, uint32 duration);
+static void SIM_scriptAddLcd(SIM_ProgramType * program, const char * text, uint32 timeout);
+static void SIM_scriptAddState(SIM_ProgramType * program, SIM_StepKind kind, uint8 state, uint32 timeout);
+static void SIM_scriptAddKey(SIM_ProgramType * program, uint32 * state, uint8 key);
+static void SIM_scriptAddPassword(SIM_ProgramType * program, uint32 * state, const uint8 * password);
+static void SIM_scriptAddNewPassword(SIM_ProgramType * program, uint32 * state, const uint8 * password);
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+static const SIM_KeyType g_keys[SIM_KEYS]={
+	{"7",0},{"8",1},{"9",2},{"%",3},{"4",4},{"5",5},{"6",6},{"*",7},
+	{"1",8},{"2",9},{"3",10},{"-",11},{"ON",12},{"0",13},{"=",14},{"+",15}
+};
+
+/******************************************************************
+ * 				  Public Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function parses a script file, returns FALSE on error. Each line has
+ *one command, empty lines and lines starting with '#' are skipped*/
+uint8 SIM_scriptLoad(SIM_ProgramType * program, const char * path)
+{
+	FILE * file=fopen(path,"r");
+	char line[SIM_LINE_SIZE];
+	char word[16];
+	char state[16];
+	unsigned long value;
+	const char * first;
+	const char * last;
+	SIM_StepType * step;
+	uint16 number=0;
+	uint8 i;
+	if(file == NULL_PTR)
+	{
+		perror(path);
+		return FALSE;
+	}
+	program->count=0;
+	while(fgets(line,sizeof(line),file) != NULL_PTR)
+	{
+		number++;
+		if((sscanf(line," %15s",word) != 1) || (word[0] == '#'))
+		{
+			continue;
+		}
+		if(program->count == SIM_MAX_STEPS)
+		{
+			fprintf(stderr,"%s:%u: too many steps\n",path,number);
+			fclose(file);
+			return FALSE;
+		}
+		step=&program->steps[program->count];
+		memset(step,0,sizeof(*step));
+		step->line=number;
+		if(!strcmp(word,"wait") && (sscanf(line," %*s %lu",&value) == 1))
+		{
+			step->kind=SIM_STEP_WAIT;
+			step->duration=SIM_MS(value);
+		}
+		else if(!strcmp(word,"press") && (sscanf(line," %*s %15s",state) == 1))
+		{
+			step->kind=SIM_STEP_PRESS;
+			step->duration=SIM_MS((sscanf(line," %*s %*s %lu",&value) == 1) ? value : SIM_DEFAULT_HOLD_MS);
+			for(i=0;(i<SIM_KEYS) && strcmp(g_keys[i].label,state);i++);
+			if(i == SIM_KEYS)
+			{
+				fprintf(stderr,"%s:%u: unknown key '%s'\n",path,number,state);
+				fclose(file);
+				return FALSE;
+			}
+			step->key=g_keys[i].code;
+		}
+		else if(!strcmp(word,"show"))
+		{
+			step->kind=SIM_STEP_SHOW;
+		}
+		else if(!strcmp(word,"door") && (sscanf(line," %*s %15s",state) == 1)
+				&& (!strcmp(state,"open") || !strcmp(state,"closed")))
+		{
+			step->kind=SIM_STEP_DOOR;
+			step->state=!strcmp(state,"open");
+		}
+		else if(!strcmp(word,"expect") && (sscanf(line," %*s %15s",word) == 1))
+		{
+			value=SIM_DEFAULT_TIMEOUT_MS;
+			first=strchr(line,'"');
+			last=(first != NULL_PTR) ? strchr(first+1,'"') : NULL_PTR;
+			if(!strcmp(word,"lcd") && (last != NULL_PTR) && ((size_t)(last-first-1) <= SIM_LCD_COLS))
+			{
+				step->kind=SIM_STEP_EXPECT_LCD;
+				memcpy(step->text,first+1,last-first-1);
+				sscanf(last+1,"%lu",&value);
+			}
+			else if(!strcmp(word,"motor") && (sscanf(line," %*s %*s %15s %lu",state,&value) >= 1)
+					&& (!strcmp(state,"stop") || !strcmp(state,"cw") || !strcmp(state,"ccw")))
+			{
+				step->kind=SIM_STEP_EXPECT_MOTOR;
+				step->state=!strcmp(state,"cw") ? SIM_MOTOR_CW : (!strcmp(state,"ccw") ? SIM_MOTOR_CCW : SIM_MOTOR_STOP);
+			}
+			else if(!strcmp(word,"buzzer") && (sscanf(line," %*s %*s %15s %lu",state,&value) >= 1)
+					&& (!strcmp(state,"on") || !strcmp(state,"off")))
+			{
+				step->kind=SIM_STEP_EXPECT_BUZZER;
+				step->state=!strcmp(state,"on");
+			}
+			else
+			{
+				fprintf(stderr,"%s:%u: bad expect\n",path,number);
+				fclose(file);
+				return FALSE;
+			}
+			step->duration=SIM_MS(value);
+		}
+		else
+		{
+			fprintf(stderr,"%s:%u: bad command\n",path,number);
+			fclose(file);
+			return FALSE;
+		}
+		program->count++;
+	}
+	fclose(file);
+	return TRUE;
+}
+
+/*Description: This function starts a script from its first step at time 0*/
+void SIM_scriptInit(SIM_ScriptType * script, const SIM_ProgramType * program)
+{
+	uint16 i;
+	script->program=program;
+	script->current=0;
+	script->stepStart=0;
+	script->lastDown=0;
+	script->lastUp=0;
+	script->pressHead=0;
+	script->pressCount=0;
+	script->failures=0;
+	script->finished=(program->count == 0);
+	for(i=0;i<program->count;i++)
+	{
+		script->latency[i]=0;
+	}
+}
+
+/*Description: This function schedules steps which don't wait for the door and checks
+ *the pending expectation against the door state at a given time. Presses start no earlier
+ *than HMI time, as HMI may already be ahead of the time an expectation is met at*/
+void SIM_scriptAdvance(SIM_DoorType * door, uint64 time)
+{
+	SIM_ScriptType * script=&door->script;
+	const SIM_StepType * step;
+	SIM_PressType * press;
+	uint64 down;
+	while(!script->finished)
+	{
+		step=&script->program->steps[script->current];
+		switch(step->kind)
+		{
+			case SIM_STEP_WAIT:
+				script->stepStart+=step->duration;
+				break;
+			case SIM_STEP_PRESS:
+				if(script->pressCount == SIM_MAX_PRESSES)
+				{
+					return;
+				}
+				down=script->stepStart;
+				if((script->lastUp != 0) && (down < script->lastUp+SIM_MS(SIM_DEFAULT_GAP_MS)))
+				{
+					down=script->lastUp+SIM_MS(SIM_DEFAULT_GAP_MS);
+				}
+				if(down < door->hmi.now())
+				{
+					down=door->hmi.now();
+				}
+				press=&script->presses[(script->pressHead+script->pressCount)%SIM_MAX_PRESSES];
+				press->key=step->key;
+				press->down=down;
+				press->up=down+step->duration;
+				script->pressCount++;
+				script->lastDown=down;
+				script->lastUp=press->up;
+				script->stepStart=down;
+				break;
+			case SIM_STEP_DOOR:
+				if(time < script->stepStart)
+				{
+					return;
+				}
+				SIM_doorContact(door,step->state,script->stepStart);
+				break;
+			case SIM_STEP_SHOW:
+				if(time < script->stepStart)
+				{
+					return;
+				}
+				if(door->trace != NULL_PTR)
+				{
+					fprintf(door->trace,"%12.3f ms  LCD\n",(double)time*1000.0/SIM_F_CPU);
+					SIM_lcdPrint(&door->lcd,door->trace);
+				}
+				break;
+			default:
+				if(!SIM_scriptMet(door,step))
+				{
+					return;
+				}
+				if(time < script->stepStart)
+				{
+					time=script->stepStart;
+				}
+				SIM_scriptComplete(door,time,time-script->lastDown);
+				continue;
+		}
+		script->current++;
+		script->finished=(script->current == script->program->count);
+	}
+}
+
+/*Description: This function fails the pending expectation if it timed out by a given time*/
+void SIM_scriptTimeout(SIM_DoorType * door, uint64 time)
+{
+	SIM_ScriptType * script=&door->script;
+	const SIM_StepType * step;
+	if(script->finished)
+	{
+		return;
+	}
+	step=&script->program->steps[script->current];
+	if((step->kind >= SIM_STEP_EXPECT_LCD) && (step->kind <= SIM_STEP_EXPECT_BUZZER)
+	   && (time > script->stepStart+step->duration))
+	{
+		script->failures++;
+		SIM_scriptComplete(door,script->stepStart+step->duration,SIM_FAILED);
+	}
+}
+
+/*Description: This function returns keypad port pins seen by HMI at a given time: the
+ *row of the pressed key reads low while its column is driven low*/
+uint8 SIM_scriptKeypad(SIM_ScriptType * script, uint64 time, uint8 ddr, uint8 out)
+{
+	const SIM_PressType * press;
+	uint8 col;
+	/*Presses already released are dropped, HMI time only goes forward*/
+	while((script->pressCount != 0) && (script->presses[script->pressHead].up <= time))
+	{
+		script->pressHead=(script->pressHead+1)%SIM_MAX_PRESSES;
+		script->pressCount--;
+	}
+	if((script->pressCount == 0) || (script->presses[script->pressHead].down > time))
+	{
+		return out;
+	}
+	press=&script->presses[script->pressHead];
+	col=SIM_KEYPAD_FIRST_COL+(press->key%4u);
+	if(IS_BIT_SET(ddr,col) && IS_BIT_CLEAR(out,col))
+	{
+		CLEAR_BIT(out,press->key/4u);
+	}
+	return out;
+}
+
+/*Description: This function prints the latency of each expect step of a script*/
+void SIM_scriptReport(const SIM_ScriptType * script, FILE * file)
+{
+	const SIM_StepType * step;
+	char text[64];
+	uint16 i;
+	for(i=0;i<script->program->count;i++)
+	{
+		step=&script->program->steps[i];
+		if((step->kind < SIM_STEP_EXPECT_LCD) || (step->kind > SIM_STEP_EXPECT_BUZZER))
+		{
+			continue;
+		}
+		SIM_scriptDescribe(step,text,sizeof(text));
+		if(i >= script->current)
+		{
+			fprintf(file,"  line %3u  %-32s  not reached\n",step->line,text);
+		}
+		else if(script->latency[i] == SIM_FAILED)
+		{
+			fprintf(file,"  line %3u  %-32s  FAILED\n",step->line,text);
+		}
+		else
+		{
+			fprintf(file,"  line %3u  %-32s  %10.3f ms\n",step->line,text,(double)script->latency[i]*1000.0/SIM_F_CPU);
+		}
+	}
+}
+
+/*Description: This function returns the text of an expect step*/
+void SIM_scriptDescribe(const SIM_StepType * step, char * text, size_t size)
+{
+	static const char * const motor[]={"stop","cw","ccw"};
+	switch(step->kind)
+	{
+		case SIM_STEP_EXPECT_LCD:		snprintf(text,size,"expect lcd \"%s\"",step->text); break;
+		case SIM_STEP_EXPECT_MOTOR:		snprintf(text,size,"expect motor %s",motor[step->state]); break;
+		default:						snprintf(text,size,"expect buzzer %s",step->state ? "on" : "off"); break;
+	}
+}
+
+/*Description: This function generates a random user workload of a door from a seed: first
+ *use (new password, sometimes mistyped when reentered) then sessions picked at random among
+ *opening the door, changing the password and locking the system with 3 wrong passwords.
+ *Wrong entries, think times and key hold times are drawn at random too, and the firmware
+ *reactions are expected with the latency of each one. Sessions stop when the program is full*/
+void SIM_scriptRandom(SIM_ProgramType * program, uint32 seed, uint16 sessions)
+{
+	uint8 password[SIM_PASSWORD_SIZE];
+	uint8 wrong[SIM_PASSWORD_SIZE];
+	uint32 state=(seed*2654435761u) ^ 0x5BD1E995u;
+	const char * prompt;
+	uint32 session;
+	uint32 wrongs;
+	uint32 i;
+	program->count=0;
+	if(state == 0)
+	{
+		state=1;
+	}
+	/*First use, HMI shows its first menu at power on without a key*/
+	SIM_scriptAddLcd(program,"Set new password",1000);
+	SIM_randomPassword(&state,password,NULL_PTR);
+	if(SIM_randomRange(&state,0,7) < SIM_MISTYPE_ODDS)
+	{
+		SIM_randomPassword(&state,wrong,password);
+		SIM_scriptAddPassword(program,&state,password);
+		SIM_scriptAddLcd(program,"Reenter password",1000);
+		SIM_scriptAddPassword(program,&state,wrong);
+		SIM_scriptAddLcd(program,"Wrong Password!",1000);
+		SIM_scriptAddLcd(program,"Set new password",1000);
+	}
+	SIM_scriptAddNewPassword(program,&state,password);
+	for(session=0;(session < sessions) && (program->count+SIM_SESSION_STEPS <= SIM_MAX_STEPS);session++)
+	{
+		SIM_scriptAdd(program,SIM_STEP_WAIT,SIM_randomRange(&state,SIM_THINK_MIN_MS,SIM_THINK_MAX_MS));
+		/*0-1: open the door, 2: change the password, 3: lock the system*/
+		switch(SIM_randomRange(&state,0,3))
+		{
+			case 2:
+				SIM_scriptAddKey(program,&state,11);
+				prompt="Enter old pass";
+				wrongs=SIM_randomRange(&state,0,2);
+				break;
+			case 3:
+				SIM_scriptAddKey(program,&state,15);
+				prompt="Enter password";
+				wrongs=3;
+				break;
+			default:
+				SIM_scriptAddKey(program,&state,15);
+				prompt="Enter password";
+				wrongs=SIM_randomRange(&state,0,2);
+				break;
+		}
+		SIM_scriptAddLcd(program,prompt,1000);
+		for(i=1;i<=wrongs;i++)
+		{
+			SIM_randomPassword(&state,wrong,password);
+			SIM_scriptAddPassword(program,&state,wrong);
+			if(i == 3)
+			{
+				/*System is locked for a minute*/
+				SIM_scriptAddLcd(program,"THIEF!!!",1000);
+				SIM_scriptAddState(program,SIM_STEP_EXPECT_BUZZER,TRUE,1000);
+				SIM_scriptAddState(program,SIM_STEP_EXPECT_BUZZER,FALSE,70000);
+				SIM_scriptAddLcd(program,"(+) Open Door",1000);
+			}
+			else
+			{
+				SIM_scriptAddLcd(program,"Wrong Password!",1000);
+				SIM_scriptAddLcd(program,prompt,1000);
+			}
+		}
+		if(wrongs == 3)
+		{
+			continue;
+		}
+		SIM_scriptAddPassword(program,&state,password);
+		if(!strcmp(prompt,"Enter old pass"))
+		{
+			SIM_scriptAddLcd(program,"Set new password",1000);
+			SIM_randomPassword(&state,password,NULL_PTR);
+			SIM_scriptAddNewPassword(program,&state,password);
+		}
+		else
+		{
+			/*Bolt opens, someone may walk through (door closing starts locking at once), then
+			 *the bolt closes*/
+			SIM_scriptAddState(program,SIM_STEP_EXPECT_MOTOR,SIM_MOTOR_CW,1000);
+			if(SIM_randomRange(&state,0,7) < SIM_WALK_ODDS)
+			{
+				SIM_scriptAdd(program,SIM_STEP_WAIT,SIM_randomRange(&state,SIM_WALK_MIN_MS,SIM_WALK_MAX_MS));
+				SIM_scriptAdd(program,SIM_STEP_DOOR,0)->state=TRUE;
+				SIM_scriptAdd(program,SIM_STEP_WAIT,SIM_randomRange(&state,SIM_PASS_MIN_MS,SIM_PASS_MAX_MS));
+				SIM_scriptAdd(program,SIM_STEP_DOOR,0)->state=FALSE;
+			}
+			SIM_scriptAddState(program,SIM_STEP_EXPECT_MOTOR,SIM_MOTOR_CCW,20000);
+			SIM_scriptAddState(program,SIM_STEP_EXPECT_MOTOR,SIM_MOTOR_STOP,20000);
+			SIM_scriptAddLcd(program,"(+) Open Door",1000);
+		}
+	}
+}
+
+/******************************************************************
+ * 				  Private Functions Definitions					  *
+ ******************************************************************/
+/*Description: This function checks if the door state meets an expect step*/
+static uint8 SIM_scriptMet(const SIM_DoorType * door, const SIM_StepType * step)
+{
+	switch(step->kind)
+	{
+		case SIM_STEP_EXPECT_LCD:		return SIM_lcdContains(&door->lcd,step->text);
+		case SIM_STEP_EXPECT_MOTOR:		return door->motor == step->state;
+		case SIM_STEP_EXPECT_BUZZER:	return door->buzzer == step->state;
+		default:						return TRUE;
+	}
+}
+
+/*Description: This function ends the pending expect step at a given time*/
+static void SIM_scriptComplete(SIM_DoorType * door, uint64 time, uint64 latency)
+{
+	SIM_ScriptType * script=&door->script;
+	char text[64];
+	script->latency[script->current]=latency;
+	if(door->trace != NULL_PTR)
+	{
+		SIM_scriptDescribe(&script->program->steps[script->current],text,sizeof(text));
+		fprintf(door->trace,"%12.3f ms  line %u: %s %s\n",(double)time*1000.0/SIM_F_CPU,
+				script->program->steps[script->current].line,text,(latency == SIM_FAILED) ? "FAILED" : "met");
+	}
+	script->stepStart=time;
+	script->current++;
+	script->finished=(script->current == script->program->count);
+}
+
+/*Description: This function returns a random number in [min, max] (xorshift32)*/
+static uint32 SIM_randomRange(uint32 * state, uint32 min, uint32 max)
+{
+	*state^=*state<<13;
+	*state^=*state>>17;
+	*state^=*state<<5;
+	return min+(*state%(max-min+1));
+}
+
+/*Description: This function draws a random password of digit keys, different from a given
+ *password if any*/
+static void SIM_randomPassword(uint32 * state, uint8 * password, const uint8 * differ)
+{
+	/*Switch numbers of keys 0-9*/
+	static const uint8 digits[10]={13,8,9,10,4,5,6,0,1,2};
+	uint8 i;
+	do
+	{
+		for(i=0;i<SIM_PASSWORD_SIZE;i++)
+		{
+			password[i]=digits[SIM_randomRange(state,0,9)];
+		}
+	}while((differ != NULL_PTR) && !memcmp(password,differ,SIM_PASSWORD_SIZE));
+}
+
+/*Description: This function appends a step to a generated program, its line is its number*/
+static SIM_StepType * SIM_scriptAdd(SIM_ProgramType * program, SIM_StepKind kind, uint32 duration)
+{
+	SIM_StepType * step=&program->steps[program->count];
+	memset(step,0,sizeof(*step));
+	step->kind=kind;
+	step->duration=SIM_MS(duration);
+	program->count++;
+	step->line=program->count;
+	return step;
+}
+
+static void SIM_scriptAddLcd(SIM_ProgramType * program, const char * text, uint32 timeout)
+{
+	SIM_StepType * step=SIM_scriptAdd(program,SIM_STEP_EXPECT_LCD,timeout);
+	snprintf(step->text,sizeof(step->text),"%s",text);
+}
+
+static void SIM_scriptAddState(SIM_ProgramType * program, SIM_StepKind kind, uint8 state, uint32 timeout)
+{
+	SIM_scriptAdd(program,kind,timeout)->state=state;
+}
+
+/*Description: This function appends a key press after a random gap with a random hold time*/
+static void SIM_scriptAddKey(SIM_ProgramType * program, uint32 * state, uint8 key)
+{
+	SIM_scriptAdd(program,SIM_STEP_WAIT,SIM_randomRange(state,SIM_KEY_GAP_MIN_MS,SIM_KEY_GAP_MAX_MS));
+	SIM_scriptAdd(program,SIM_STEP_PRESS,SIM_randomRange(state,SIM_HOLD_MIN_MS,SIM_HOLD_MAX_MS))->key=key;
+}
+
+static void SIM_scriptAddPassword(SIM_ProgramType * program, uint32 * state, const uint8 * password)
+{
+	uint8 i;
+	for(i=0;i<SIM_PASSWORD_SIZE;i++)
+	{
+		SIM_scriptAddKey(program,state,password[i]);
+	}
+}
+
+/*Description: This function appends a new password entered twice, from the "Set new
+ *password" screen back to the main menu*/
+static void SIM_scriptAddNewPassword(SIM_ProgramType * program, uint32 * state, const uint8 * password)
+{
+	SIM_scriptAddPassword(program,state,password);
+	SIM_scriptAddLcd(program,"Reenter password",1000);
+	SIM_scriptAddPassword(program,state,password);
+	SIM_scriptAddLcd(program,"(+) Open Door",1000);
+}
@@ -0,0 +1,396 @@
+/*******************************************************************************************
+ * [FILE NAME]:		traceconv.c
+ * [AUTHOR]:		Omar Yousry
+ * [DATE CREATED]:	18 Oct 2026
+ * [DESCRIPTION]:	This c file contains the main function of the trace converter:
+ * 					traceconv [-j chrome_json] [-d vcd_file] dump...
+ * 					It reads trace dumps (TRACE_dump output captured from an ECU UART, or
+ * 					written by cosim -T), one ECU per dump file, other lines in the files are
+ * 					skipped. Events of all dumps are merged by time and written as Chrome
+ * 					trace JSON (chrome://tracing, Perfetto) and/or VCD (GTKWave), each ECU
+ * 					as a process/scope and each event source as a thread/signal.
+ * 					Begin/end pairs broken by the ring overwriting are repaired: an end
+ * 					without begin is dropped and spans left open are closed at the last event
+ *******************************************************************************************/
+
+#include <libgen.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "sim.h"
+
+/******************************************************************
+ * 				    Static Configurations					      *
+ ******************************************************************/
+#define CONV_MAX_DUMPS			16u
+#define CONV_NAME_SIZE			64u
+#define CONV_LINE_SIZE			128u
+
+/******************************************************************
+ * 				    User-defined Data Types					      *
+ ******************************************************************/
+/*[Structure Name]		 : CONV_EventType
+ *[Structure Description]: This structure contains an event of a dump with its time in usec,
+ * 						   order keeps events of the same time in dump order*/
+typedef struct{
+	uint64 time;
+	uint32 order;
+	uint8 dump;
+	uint8 id;
+	uint16 arg;
+}CONV_EventType;
+
+/******************************************************************
+ * 						Global Variables						  *
+ ******************************************************************/
+/*Names of event sources, indexed by TRACE_Source*/
+static const char * const g_sourceNames[TRACE_SOURCE_COUNT]={
+	[TRACE_STATE]="state",
+	[TRACE_TIMER1]="timer1",
+	[TRACE_UART_RX]="uart_rx",
+	[TRACE_UART_TX]="uart_tx",
+	[TRACE_TWI]="twi",
+	[TRACE_LCD]="lcd",
+	[TRACE_SPI]="spi"
+};
+
+static char g_dumpNames[CONV_MAX_DUMPS][CONV_NAME_SIZE];
+static uint8 g_dumpCount=0;
+static CONV_EventType * g_events=NULL_PTR;
+static uint32 g_eventCount=0;
+static uint32 g_eventSize=0;
+
+/******************************************************************
+ * 				  Private Functions Prototypes					  *
+ ******************************************************************/
+static uint8 CONV_read(const char * path);
+static void CONV_add(uint8 dump, uint8 id, uint64 time, uint16 arg);
+static int CONV_compare(const void * first, const void * second);
+static void CONV_repair(void);
+static void CONV_writeChrome(FILE * file);
+static void CONV_writeVcd(FILE * file);
+static void CONV_vcdId(uint32 index, char * id);
+
+/******************************************************************
+ * 				  	  Functions Definitions				 		  *
+ ******************************************************************/
+int main(int argc, char * argv[])
+{
+	const char * chrome=NULL_PTR;
+	const char * vcd=NULL_PTR;
+	FILE * file;
+	int option;
+	while((option=getopt(argc,argv,"j:d:")) != -1)
+	{
+		switch(option)
+		{
+			case 'j': chrome=optarg; break;
+			case 'd': vcd=optarg; break;
+			default:
+				fprintf(stderr,"usage: %s [-j chrome_json] [-d vcd_file] dump...\n",argv[0]);
+				return EXIT_FAILURE;
+		}
+	}
+	if((optind == argc) || (argc-optind > CONV_MAX_DUMPS) || ((chrome == NULL_PTR) && (vcd == NULL_PTR)))
+	{
+		fprintf(stderr,"usage: %s [-j chrome_json] [-d vcd_file] dump...\n",argv[0]);
+		return EXIT_FAILURE;
+	}
+	for(;optind<argc;optind++)
+	{
+		if(!CONV_read(argv[optind]))
+		{
+			return EXIT_FAILURE;
+		}
+	}
+	qsort(g_events,g_eventCount,sizeof(CONV_EventType),CONV_compare);
+	CONV_repair();
+	if(chrome != NULL_PTR)
+	{
+		file=fopen(chrome,"w");
+		if(file == NULL_PTR)
+		{
+			perror(chrome);
+			return EXIT_FAILURE;
+		}
+		CONV_writeChrome(file);
+		fclose(file);
+	}
+	if(vcd != NULL_PTR)
+	{
+		file=fopen(vcd,"w");
+		if(file == NULL_PTR)
+		{
+			perror(vcd);
+			return EXIT_FAILURE;
+		}
+		CONV_writeVcd(file);
+		fclose(file);
+	}
+	printf("%u event(s) of %u dump(s) converted\n",g_eventCount,g_dumpCount);
+	return EXIT_SUCCESS;
+}
+
+/*Description: This function reads the events of a dump file, the dump is named after the
+ *file without its extension. A file may hold many dumps of the same ECU one after another.
+ *Returns FALSE on error*/
+static uint8 CONV_read(const char * path)
+{
+	char line[CONV_LINE_SIZE];
+	char name[CONV_NAME_SIZE];
+	unsigned int tick=0;
+	unsigned int count;
+	unsigned int lost;
+	unsigned int id;
+	unsigned int time;
+	unsigned int arg;
+	uint8 dump=g_dumpCount;
+	char * dot;
+	FILE * file=fopen(path,"r");
+	if(file == NULL_PTR)
+	{
+		perror(path);
+		return FALSE;
+	}
+	snprintf(name,sizeof(name),"%s",path);
+	snprintf(g_dumpNames[dump],CONV_NAME_SIZE,"%s",basename(name));
+	dot=strrchr(g_dumpNames[dump],'.');
+	if(dot != NULL_PTR)
+	{
+		*dot='\0';
+	}
+	g_dumpCount++;
+	while(fgets(line,sizeof(line),file) != NULL_PTR)
+	{
+		if(sscanf(line,"TR:%x:%x:%x",&tick,&count,&lost) == 3)
+		{
+			if(lost != 0)
+			{
+				fprintf(stderr,"%s: %u event(s) lost before a dump of %u\n",path,lost,count);
+			}
+		}
+		else if((strlen(line) >= 15) && (line[0] == 'T') && (tick != 0)
+				&& (sscanf(line,"T%2x%8x%4x",&id,&time,&arg) == 3))
+		{
+			CONV_add(dump,id,(uint64)time*tick,arg);
+		}
+	}
+	fclose(file);
+	if(tick == 0)
+	{
+		fprintf(stderr,"%s: no trace dump found\n",path);
+		return FALSE;
+	}
+	return TRUE;
+}
+
+/*Description: This function adds an event to the merged list*/
+static void CONV_add(uint8 dump, uint8 id, uint64 time, uint16 arg)
+{
+	CONV_EventType * event;
+	if((id & TRACE_SOURCE_MASK) >= TRACE_SOURCE_COUNT)
+	{
+		return;
+	}
+	if(g_eventCount == g_eventSize)
+	{
+		g_eventSize=(g_eventSize == 0) ? 1024u : g_eventSize*2u;
+		g_events=realloc(g_events,g_eventSize*sizeof(CONV_EventType));
+		if(g_events == NULL_PTR)
+		{
+			perror("traceconv");
+			exit(EXIT_FAILURE);
+		}
+	}
+	event=&g_events[g_eventCount];
+	event->time=time;
+	event->order=g_eventCount;
+	event->dump=dump;
+	event->id=id;
+	event->arg=arg;
+	g_eventCount++;
+}
+
+/*Description: This function orders events by time, then by the order they were read*/
+static int CONV_compare(const void * first, const void * second)
+{
+	const CONV_EventType * a=first;
+	const CONV_EventType * b=second;
+	if(a->time != b->time)
+	{
+		return (a->time < b->time) ? -1 : 1;
+	}
+	return (a->order < b->order) ? -1 : ((a->order > b->order) ? 1 : 0);
+}
+
+/*Description: This function drops ends without a begin and begins of a span already open
+ *(nested TWI repeated start), then closes spans left open at the time of the last event*/
+static void CONV_repair(void)
+{
+	uint8 open[CONV_MAX_DUMPS][TRACE_SOURCE_COUNT];
+	uint16 openArg[CONV_MAX_DUMPS][TRACE_SOURCE_COUNT];
+	CONV_EventType * event;
+	uint32 kept=0;
+	uint32 count;
+	uint32 i;
+	uint8 source;
+	uint8 phase;
+	uint8 dump;
+	memset(open,FALSE,sizeof(open));
+	memset(openArg,0,sizeof(openArg));
+	for(i=0;i<g_eventCount;i++)
+	{
+		event=&g_events[i];
+		source=event->id & TRACE_SOURCE_MASK;
+		phase=event->id & TRACE_PHASE_MASK;
+		if(phase == TRACE_PHASE_BEGIN)
+		{
+			if(open[event->dump][source])
+			{
+				continue;
+			}
+			open[event->dump][source]=TRUE;
+			openArg[event->dump][source]=event->arg;
+		}
+		else if(phase == TRACE_PHASE_END)
+		{
+			if(!open[event->dump][source])
+			{
+				continue;
+			}
+			open[event->dump][source]=FALSE;
+		}
+		g_events[kept++]=*event;
+	}
+	g_eventCount=kept;
+	count=g_eventCount;
+	for(dump=0;dump<g_dumpCount;dump++)
+	{
+		for(source=0;source<TRACE_SOURCE_COUNT;source++)
+		{
+			if(open[dump][source])
+			{
+				CONV_add(dump,TRACE_PHASE_END | source,(count != 0) ? g_events[count-1].time : 0,openArg[dump][source]);
+			}
+		}
+	}
+}
+
+/*Description: This function writes the events as Chrome trace JSON, time stamps in usec*/
+static void CONV_writeChrome(FILE * file)
+{
+	const CONV_EventType * event;
+	const char * phase;
+	uint32 i;
+	uint8 dump;
+	uint8 source;
+	fprintf(file,"{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	for(dump=0;dump<g_dumpCount;dump++)
+	{
+		fprintf(file,"{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,\"args\":{\"name\":\"%s\"}},\n",
+				dump+1u,g_dumpNames[dump]);
+		for(source=0;source<TRACE_SOURCE_COUNT;source++)
+		{
+			fprintf(file,"{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":\"%s\"}},\n",
+					dump+1u,source,g_sourceNames[source]);
+		}
+	}
+	for(i=0;i<g_eventCount;i++)
+	{
+		event=&g_events[i];
+		source=event->id & TRACE_SOURCE_MASK;
+		switch(event->id & TRACE_PHASE_MASK)
+		{
+			case TRACE_PHASE_BEGIN: phase="\"B\""; break;
+			case TRACE_PHASE_END: phase="\"E\""; break;
+			default: phase="\"i\",\"s\":\"t\""; break;
+		}
+		fprintf(file,"{\"name\":\"%s\",\"ph\":%s,\"ts\":%llu,\"pid\":%u,\"tid\":%u,\"args\":{\"arg\":\"0x%04X\"}}%s\n",
+				g_sourceNames[source],phase,(unsigned long long)event->time,event->dump+1u,source,event->arg,
+				(i+1 < g_eventCount) ? "," : "");
+	}
+	fprintf(file,"]}\n");
+}
+
+/*Description: This function writes the events as VCD with 1 usec resolution, each source
+ *has an "active" wire (high between begin and end), an "arg" register holding the last
+ *argument and an "hit" event raised by each instant event*/
+static void CONV_writeVcd(FILE * file)
+{
+	const CONV_EventType * event;
+	char id[8];
+	uint64 time=0;
+	uint32 signal;
+	uint32 i;
+	uint8 dump;
+	uint8 source;
+	uint8 phase;
+	int bit;
+	fprintf(file,"$timescale 1us $end\n");
+	for(dump=0;dump<g_dumpCount;dump++)
+	{
+		fprintf(file,"$scope module %s $end\n",g_dumpNames[dump]);
+		for(source=0;source<TRACE_SOURCE_COUNT;source++)
+		{
+			signal=((dump*TRACE_SOURCE_COUNT)+source)*3u;
+			fprintf(file,"$scope module %s $end\n",g_sourceNames[source]);
+			CONV_vcdId(signal,id);
+			fprintf(file,"$var wire 1 %s active $end\n",id);
+			CONV_vcdId(signal+1u,id);
+			fprintf(file,"$var reg 16 %s arg $end\n",id);
+			CONV_vcdId(signal+2u,id);
+			fprintf(file,"$var event 1 %s hit $end\n",id);
+			fprintf(file,"$upscope $end\n");
+		}
+		fprintf(file,"$upscope $end\n");
+	}
+	fprintf(file,"$enddefinitions $end\n#0\n$dumpvars\n");
+	for(signal=0;signal<g_dumpCount*TRACE_SOURCE_COUNT*3u;signal+=3u)
+	{
+		CONV_vcdId(signal,id);
+		fprintf(file,"0%s\n",id);
+		CONV_vcdId(signal+1u,id);
+		fprintf(file,"b0 %s\n",id);
+	}
+	fprintf(file,"$end\n");
+	for(i=0;i<g_eventCount;i++)
+	{
+		event=&g_events[i];
+		if(event->time != time)
+		{
+			time=event->time;
+			fprintf(file,"#%llu\n",(unsigned long long)time);
+		}
+		source=event->id & TRACE_SOURCE_MASK;
+		phase=event->id & TRACE_PHASE_MASK;
+		signal=((event->dump*TRACE_SOURCE_COUNT)+source)*3u;
+		if(phase == TRACE_INSTANT)
+		{
+			CONV_vcdId(signal+2u,id);
+			fprintf(file,"1%s\n",id);
+		}
+		else
+		{
+			CONV_vcdId(signal,id);
+			fprintf(file,"%c%s\n",(phase == TRACE_PHASE_BEGIN) ? '1' : '0',id);
+		}
+		CONV_vcdId(signal+1u,id);
+		fprintf(file,"b");
+		for(bit=15;bit>=0;bit--)
+		{
+			fputc((event->arg & (1u<<bit)) ? '1' : '0',file);
+		}
+		fprintf(file," %s\n",id);
+	}
+}
+
+/*Description: This function makes the VCD identifier of a signal from printable characters*/
+static void CONV_vcdId(uint32 index, char * id)
+{
+	do
+	{
+		*id++='!'+(index%94u);
+		index/=94u;
+	}while(index != 0);
+	*id='\0';
+}